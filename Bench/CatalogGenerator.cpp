@@ -0,0 +1,573 @@
+#include "CatalogGenerator.h"
+#include "../Core/PasswordHasher.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    // Окремий потік випадкових чисел на кожен файл.
+    const uint64_t LAYOUT_STREAM = 0;
+    const uint64_t CATALOG_STREAM = 1;
+    const uint64_t TRACE_STREAM = 2;
+
+    const size_t BOOKS_PER_AUTHOR = 8;
+
+    // Як USER_ATTEMPT_BURST в AuthManager: більше входів одного користувача
+    // за прогін траси впираються в обмежувач частоти.
+    const size_t LOGINS_PER_USER = 5;
+
+    // Скільки разів шукати вільну (чи видану) книгу, перш ніж замінити
+    // операцію на пошук.
+    const int PICK_ATTEMPTS = 64;
+
+    const double PRICE_MEDIAN_KOPECKS = 25000;
+    const double PRICE_SIGMA = 0.6;
+    const int64_t PRICE_MIN_KOPECKS = 2000;
+    const int64_t PRICE_MAX_KOPECKS = 500000;
+
+    const string ADMIN_USERNAME = "admin";
+
+    // Пароль 0 - стандартний пароль адміністратора з AuthManager.
+    const vector<string> PASSWORDS = {
+        "admin123", "qwerty123", "sonyashnyk", "kvitka2024", "biblioteka",
+        "lviv1256", "dnipro77", "kobzar1840", "vyshyvanka", "karpaty",
+        "kashtan15", "zoria2023", "chytach01", "poltava09", "smerichka", "tysha42" };
+
+    const vector<string> UKR_SURNAMES = {
+        "Шевченко", "Франко", "Українка", "Коцюбинський", "Стефаник", "Кобилянська",
+        "Нечуй-Левицький", "Мирний", "Квітка-Основ'яненко", "Котляревський",
+        "Вовчок", "Тичина", "Рильський", "Сосюра", "Хвильовий", "Підмогильний",
+        "Стус", "Костенко", "Гончар", "Загребельний", "Тютюнник", "Шевчук",
+        "Андрухович", "Забужко", "Жадан", "Кокотюха", "Винничук", "Прохасько",
+        "Матіос", "Кідрук", "Коваль", "Бойко", "Мельник", "Ткаченко", "Кравченко",
+        "Олійник", "Лисенко", "Гнатюк", "Савченко", "Руденко" };
+    const vector<string> UKR_INITIALS = {
+        "А", "Б", "В", "Г", "Д", "Є", "І", "К", "Л", "М",
+        "Н", "О", "П", "Р", "С", "Т", "Ю", "Я", "Ф", "Х" };
+
+    const vector<string> LAT_SURNAMES = {
+        "Smith", "Orwell", "Tolkien", "Austen", "Hemingway", "Twain", "Dickens",
+        "Christie", "King", "Rowling", "Pratchett", "Gaiman", "Atwood", "Murakami",
+        "Eco", "Kafka", "Hesse", "Remarque", "Camus", "Borges", "Marquez", "Coelho",
+        "Dumas", "Verne", "Wilde", "Woolf", "Joyce", "Faulkner", "Steinbeck",
+        "London", "Bradbury", "Asimov", "Clarke", "Herbert", "Lem", "Le Guin",
+        "Tolstoy", "Chekhov", "Nabokov", "Sapkowski" };
+    const vector<string> LAT_INITIALS = {
+        "A", "B", "C", "D", "E", "F", "G", "H", "J", "K",
+        "L", "M", "N", "P", "R", "S", "T", "V", "W", "Y" };
+
+    // Перше слово назви - з великої літери, решта - зі словника.
+    const vector<string> UKR_TITLE_HEADS = {
+        "Тіні", "Лісова", "Місто", "Зачарована", "Тигролови", "Кайдашева",
+        "Сонячна", "Вечірня", "Чорна", "Остання", "Маруся", "Запахи", "Музей",
+        "Польові", "Земля", "Дім", "Кобзар", "Сто", "Інтернат", "Безодня",
+        "Коротка", "Таємна", "Нова", "Стара" };
+    const vector<string> UKR_TITLE_WORDS = {
+        "забутих", "пісня", "рада", "книга", "історія", "ніч", "дорога", "вода",
+        "пам'ять", "світла", "доба", "осінь", "весна", "ріка", "зорі", "вітер",
+        "дім", "кохання", "міста", "війни", "степу", "моря", "листи", "тиші",
+        "снів", "предків", "ворожіння", "легенди", "і", "в", "про", "над" };
+
+    const vector<string> LAT_TITLE_HEADS = {
+        "The", "A", "Brave", "Silent", "Dark", "Last", "Lost", "Shadow",
+        "Winter", "Invisible", "Great", "Old", "New", "Burning", "Hidden", "Red",
+        "Wild", "Broken", "Secret", "Little", "Final", "Golden", "Empty", "Distant" };
+    const vector<string> LAT_TITLE_WORDS = {
+        "of", "the", "and", "night", "world", "sea", "city", "garden", "war",
+        "peace", "time", "light", "road", "house", "river", "dream", "empire",
+        "stars", "stone", "heart", "winter", "memory", "fire", "island",
+        "kingdom", "machine", "journey", "storm", "mountain", "letters",
+        "shadows", "silence" };
+
+    // Ваги довжини назви в словах (1..7): здебільшого два-три слова.
+    const vector<unsigned> TITLE_LENGTH_WEIGHTS = { 15, 30, 25, 15, 8, 4, 3 };
+
+    const vector<string> USER_GIVEN_NAMES = {
+        "olena", "andrii", "iryna", "taras", "oksana", "dmytro", "nataliia",
+        "serhii", "yuliia", "oleh", "mariia", "bohdan", "kateryna", "yurii",
+        "sofiia", "maksym", "anna", "ivan", "daryna", "petro", "viktoriia",
+        "roman", "khrystyna", "stepan" };
+    const vector<string> USER_SURNAMES = {
+        "koval", "boiko", "melnyk", "tkachenko", "shevchenko", "kravchenko",
+        "oliinyk", "lysenko", "hnatiuk", "savchenko", "rudenko", "bondar",
+        "moroz", "marchenko", "polishchuk", "kovalenko", "pavlenko", "zinchenko",
+        "levchenko", "romaniuk", "kushnir", "karpenko", "honchar", "symonenko" };
+
+    // Прості числа для перестановки "ранг популярності -> номер книги".
+    const uint64_t RANK_STRIDE = 1000003;
+    const uint64_t RANK_STRIDE_FALLBACK = 998244353;
+
+    /**
+     * @brief Рівномірне число з [0, 1): 53 старші біти генератора.
+     */
+    double nextUnit(mt19937_64& random)
+    {
+        return static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Стандартне нормальне число (перетворення Бокса-Мюллера).
+     */
+    double nextNormal(mt19937_64& random)
+    {
+        double u = 1.0 - nextUnit(random);
+        double v = nextUnit(random);
+        return sqrt(-2.0 * log(u)) * cos(2.0 * 3.14159265358979323846 * v);
+    }
+
+    size_t nextIndex(mt19937_64& random, size_t count)
+    {
+        return static_cast<size_t>(random() % count);
+    }
+
+    /**
+     * @brief Індекс за вагами (weights не порожній і не нульовий).
+     */
+    size_t nextWeighted(mt19937_64& random, const vector<unsigned>& weights)
+    {
+        unsigned total = 0;
+        for (unsigned weight : weights) total += weight;
+
+        unsigned pick = static_cast<unsigned>(random() % total);
+        for (size_t i = 0; i < weights.size(); i++)
+        {
+            if (pick < weights[i]) return i;
+            pick -= weights[i];
+        }
+        return weights.size() - 1;
+    }
+
+    /**
+     * @brief Перемішування Фішера-Єйтса: на відміну від std::shuffle,
+     * однакове на всіх стандартних бібліотеках.
+     */
+    template <typename T>
+    void shuffleStable(vector<T>& values, mt19937_64& random)
+    {
+        for (size_t i = values.size(); i > 1; i--)
+        {
+            swap(values[i - 1], values[nextIndex(random, i)]);
+        }
+    }
+
+    int64_t nextPriceKopecks(mt19937_64& random)
+    {
+        // Ціни мають логнормальний розподіл: більшість поруч із медіаною,
+        // довгий хвіст дорогих видань. Округлення - до 10 копійок.
+        double kopecks = PRICE_MEDIAN_KOPECKS * exp(PRICE_SIGMA * nextNormal(random));
+        int64_t rounded = static_cast<int64_t>(kopecks / 10) * 10;
+        return clamp(rounded, PRICE_MIN_KOPECKS, PRICE_MAX_KOPECKS);
+    }
+
+    string formatPrice(int64_t kopecks)
+    {
+        string fraction = to_string(kopecks % 100);
+        return to_string(kopecks / 100) + "." + (fraction.size() < 2 ? "0" : "") + fraction;
+    }
+
+    string makeUsername(size_t index)
+    {
+        size_t combinations = USER_GIVEN_NAMES.size() * USER_SURNAMES.size();
+        string username = USER_GIVEN_NAMES[index % USER_GIVEN_NAMES.size()] + "."
+            + USER_SURNAMES[(index / USER_GIVEN_NAMES.size()) % USER_SURNAMES.size()];
+        if (index >= combinations) username += to_string(index / combinations);
+        return username;
+    }
+
+    double helperLog(double x)
+    {
+        return abs(x) > 1e-8 ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    double helperExp(double x)
+    {
+        return abs(x) > 1e-8 ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+    }
+}
+
+ZipfDistribution::ZipfDistribution(uint64_t count, double exponent)
+    : count(max<uint64_t>(count, 1)), exponent(exponent)
+{
+    this->hIntegralFirst = this->hIntegral(1.5) - 1.0;
+    this->hIntegralLast = this->hIntegral(static_cast<double>(this->count) + 0.5);
+    this->squeeze = 2.0 - this->hIntegralInverse(this->hIntegral(2.5) - this->h(2.0));
+}
+
+uint64_t ZipfDistribution::operator()(mt19937_64& random) const
+{
+    while (true)
+    {
+        double u = this->hIntegralLast + nextUnit(random) * (this->hIntegralFirst - this->hIntegralLast);
+        double x = this->hIntegralInverse(u);
+
+        double rounded = floor(x + 0.5);
+        uint64_t k = rounded < 1.0 ? 1 : static_cast<uint64_t>(rounded);
+        if (k > this->count) k = this->count;
+
+        if (static_cast<double>(k) - x <= this->squeeze ||
+            u >= this->hIntegral(static_cast<double>(k) + 0.5) - this->h(static_cast<double>(k)))
+        {
+            return k - 1;
+        }
+    }
+}
+
+double ZipfDistribution::h(double x) const
+{
+    return exp(-this->exponent * log(x));
+}
+
+double ZipfDistribution::hIntegral(double x) const
+{
+    double logX = log(x);
+    return helperExp((1.0 - this->exponent) * logX) * logX;
+}
+
+double ZipfDistribution::hIntegralInverse(double x) const
+{
+    double t = max(x * (1.0 - this->exponent), -1.0);
+    return exp(helperLog(t) * x);
+}
+
+CatalogGenerator::CatalogGenerator(const Options& options)
+    : options(options)
+{
+    if (this->options.books == 0 || this->options.shelves <= 0)
+    {
+        throw runtime_error("CatalogGenerator: Каталог має містити книги та полиці.");
+    }
+    if (this->options.authors == 0)
+    {
+        this->options.authors = max<size_t>(1, this->options.books / BOOKS_PER_AUTHOR);
+    }
+
+    size_t admins = max<size_t>(1, llround(this->options.users * this->options.adminFraction));
+    size_t librarians = llround(this->options.users * this->options.librarianFraction);
+    if (admins + librarians >= this->options.users)
+    {
+        throw runtime_error("CatalogGenerator: Серед користувачів немає жодного читача.");
+    }
+
+    mt19937_64 random(this->options.seed + LAYOUT_STREAM);
+
+    // Користувач 0 - стандартний адміністратор, далі персонал і читачі.
+    this->users.reserve(this->options.users);
+    this->users.push_back({ ADMIN_USERNAME, 0, UserAccount::Role::Admin });
+    for (size_t i = 1; i < this->options.users; i++)
+    {
+        UserAccount::Role role = i < admins ? UserAccount::Role::Admin
+            : i < admins + librarians ? UserAccount::Role::Librarian
+            : UserAccount::Role::Reader;
+        size_t password = 1 + nextIndex(random, PASSWORDS.size() - 1);
+        this->users.push_back({ makeUsername(i - 1), password, role });
+    }
+    for (uint32_t i = 0; i < this->users.size(); i++)
+    {
+        if (this->users[i].role == UserAccount::Role::Reader) this->readers.push_back(i);
+        else this->staff.push_back(i);
+    }
+
+    // Номери полиць за спаданням заповненості, щоб "гарячі" полиці не
+    // йшли підряд від першої.
+    this->shelfRanks.resize(this->options.shelves);
+    for (int i = 0; i < this->options.shelves; i++) this->shelfRanks[i] = i + 1;
+    shuffleStable(this->shelfRanks, random);
+
+    ZipfDistribution authorRank(this->options.authors, this->options.authorSkew);
+    ZipfDistribution shelfRank(this->options.shelves, this->options.shelfSkew);
+
+    this->bookAuthors.resize(this->options.books);
+    this->bookShelves.resize(this->options.books);
+    this->bookHolders.assign(this->options.books, -1);
+    for (size_t i = 0; i < this->options.books; i++)
+    {
+        this->bookAuthors[i] = static_cast<uint32_t>(authorRank(random));
+        this->bookShelves[i] = this->shelfRanks[shelfRank(random)];
+        if (nextUnit(random) < this->options.issuedFraction)
+        {
+            this->bookHolders[i] = static_cast<int32_t>(
+                this->readers[nextIndex(random, this->readers.size())]);
+        }
+    }
+}
+
+void CatalogGenerator::WriteCatalog(ostream& output) const
+{
+    mt19937_64 random(this->options.seed + CATALOG_STREAM);
+    string row;
+    for (size_t i = 0; i < this->options.books; i++)
+    {
+        uint32_t author = this->bookAuthors[i];
+        bool ukrainian = author % 2 == 0;
+
+        row = MakeArticle(i);
+        row += ',';
+        row += GetAuthorName(author);
+        row += ',';
+        row += this->makeTitle(random, ukrainian);
+        row += ',';
+        row += formatPrice(nextPriceKopecks(random));
+        row += ',';
+        row += to_string(this->bookShelves[i]);
+        row += ',';
+        if (this->bookHolders[i] >= 0) row += this->users[this->bookHolders[i]].username;
+        row += '\n';
+        output << row;
+    }
+}
+
+void CatalogGenerator::WriteUsers(ostream& output) const
+{
+    vector<string> hashes;
+    hashes.reserve(PASSWORDS.size());
+    for (const string& password : PASSWORDS)
+    {
+        hashes.push_back(PasswordHasher::Hash(password));
+    }
+
+    for (const User& user : this->users)
+    {
+        output << UserAccount(user.username, hashes[user.password], user.role).ToFileString() << "\n";
+    }
+}
+
+size_t CatalogGenerator::WriteTrace(ostream& output) const
+{
+    mt19937_64 random(this->options.seed + TRACE_STREAM);
+
+    // Стан видач змінюється разом із трасою, щоб кожна команда була коректною.
+    vector<int32_t> holders = this->bookHolders;
+    vector<vector<uint32_t>> loans(this->users.size());
+    for (size_t i = 0; i < holders.size(); i++)
+    {
+        if (holders[i] >= 0) loans[holders[i]].push_back(static_cast<uint32_t>(i));
+    }
+
+    ZipfDistribution bookRank(this->options.books, this->options.bookSkew);
+    ZipfDistribution authorRank(this->options.authors, this->options.authorSkew);
+    ZipfDistribution shelfRank(this->options.shelves, this->options.shelfSkew);
+    uint64_t stride = this->options.books % RANK_STRIDE == 0 ? RANK_STRIDE_FALLBACK : RANK_STRIDE;
+
+    // Популярні книги розкидані по каталогу, а не зібрані на початку.
+    auto popularBook = [&]()
+        {
+            return static_cast<size_t>((bookRank(random) * stride) % this->options.books);
+        };
+
+    auto findAvailableBook = [&](size_t& book)
+        {
+            for (int attempt = 0; attempt < PICK_ATTEMPTS; attempt++)
+            {
+                // Спершу популярні книги, далі - будь-яка вільна.
+                book = attempt < PICK_ATTEMPTS / 4 ? popularBook() : nextIndex(random, holders.size());
+                if (holders[book] < 0) return true;
+            }
+            return false;
+        };
+
+    vector<uint32_t> readerOrder = this->readers;
+    vector<uint32_t> staffOrder = this->staff;
+    shuffleStable(readerOrder, random);
+    shuffleStable(staffOrder, random);
+    size_t readerLogins = 0;
+    size_t staffLogins = 0;
+
+    // Наступний користувач групи по колу, не більше LOGINS_PER_USER входів.
+    auto nextUser = [](const vector<uint32_t>& order, size_t& logins, int64_t& user)
+        {
+            if (order.empty() || logins >= order.size() * LOGINS_PER_USER) return false;
+            user = order[logins++ % order.size()];
+            return true;
+        };
+
+    vector<unsigned> mix = {
+        this->options.lookupShare, this->options.filterShare,
+        this->options.issueShare, this->options.returnShare };
+    if (this->options.lookupShare + this->options.filterShare +
+        this->options.issueShare + this->options.returnShare == 0)
+    {
+        mix[0] = 1;
+    }
+
+    output << "# library_gen: books=" << this->options.books << " users=" << this->users.size()
+        << " operations=" << this->options.operations << " seed=" << this->options.seed << "\n";
+
+    int64_t current = -1;
+    size_t remaining = 0;
+    size_t operations = 0;
+    string line;
+    while (operations < this->options.operations)
+    {
+        if (remaining == 0)
+        {
+            bool staffSession = nextUnit(random) < this->options.staffSessionFraction;
+            int64_t user = -1;
+            bool found = staffSession
+                ? nextUser(staffOrder, staffLogins, user) || nextUser(readerOrder, readerLogins, user)
+                : nextUser(readerOrder, readerLogins, user) || nextUser(staffOrder, staffLogins, user);
+
+            remaining = 1 + nextIndex(random, 2 * max<size_t>(this->options.sessionLength, 1));
+            if (found)
+            {
+                if (current >= 0) output << "LOGOUT\n";
+                current = user;
+                output << "LOGIN " << this->users[current].username << " "
+                    << this->getPassword(this->users[current]) << "\n";
+            }
+        }
+
+        const User& session = this->users[current];
+        bool isStaff = session.role != UserAccount::Role::Reader;
+        size_t kind = nextWeighted(random, mix);
+        size_t book = 0;
+        line.clear();
+
+        if (kind == 3)
+        {
+            // Читач повертає свою книгу, персонал - будь-чию.
+            int64_t holder = current;
+            for (int attempt = 0; isStaff && attempt < PICK_ATTEMPTS; attempt++)
+            {
+                holder = this->readers[nextIndex(random, this->readers.size())];
+                if (!loans[holder].empty()) break;
+            }
+
+            vector<uint32_t>& held = loans[holder];
+            if (!held.empty())
+            {
+                size_t position = nextIndex(random, held.size());
+                book = held[position];
+                held[position] = held.back();
+                held.pop_back();
+                holders[book] = -1;
+                line = "RETURN " + MakeArticle(book);
+            }
+            else
+            {
+                kind = 2;
+            }
+        }
+
+        if (kind == 2)
+        {
+            if (findAvailableBook(book))
+            {
+                int64_t reader = isStaff
+                    ? this->readers[nextIndex(random, this->readers.size())] : current;
+                holders[book] = static_cast<int32_t>(reader);
+                loans[reader].push_back(static_cast<uint32_t>(book));
+                line = "ISSUE " + MakeArticle(book);
+                if (isStaff) line += " " + this->users[reader].username;
+            }
+            else
+            {
+                kind = 0;
+            }
+        }
+
+        if (kind == 1)
+        {
+            unsigned filter = static_cast<unsigned>(random() % 100);
+            if (filter < 50)
+            {
+                line = "FILTER AUTHOR " + GetAuthorName(authorRank(random));
+            }
+            else if (filter < 75)
+            {
+                line = "FILTER SHELF " + to_string(this->shelfRanks[shelfRank(random)]);
+            }
+            else if (filter < 90)
+            {
+                int64_t from = nextPriceKopecks(random);
+                int64_t to = from + from * static_cast<int64_t>(20 + random() % 80) / 100;
+                line = "FILTER PRICE " + formatPrice(from) + " " + formatPrice(to);
+            }
+            else
+            {
+                // Пошук за початком назви.
+                const vector<string>& heads = random() % 2 == 0 ? UKR_TITLE_HEADS : LAT_TITLE_HEADS;
+                const string& head = heads[nextIndex(random, heads.size())];
+                line = "FILTER TITLE " + head + " " + head;
+            }
+        }
+
+        if (kind == 0)
+        {
+            line = "FIND " + MakeArticle(popularBook());
+        }
+
+        output << line << "\n";
+        operations++;
+        remaining--;
+    }
+
+    if (current >= 0) output << "LOGOUT\n";
+    return operations;
+}
+
+size_t CatalogGenerator::GetAuthorCount() const
+{
+    return this->options.authors;
+}
+
+string CatalogGenerator::GetAuthorName(size_t index)
+{
+    // Парні ранги - українські автори, непарні - іноземні; ім'я - прізвище
+    // з ініціалами, а після вичерпання комбінацій - ще й порядковий номер.
+    bool ukrainian = index % 2 == 0;
+    const vector<string>& surnames = ukrainian ? UKR_SURNAMES : LAT_SURNAMES;
+    const vector<string>& initials = ukrainian ? UKR_INITIALS : LAT_INITIALS;
+
+    size_t number = index / 2;
+    size_t combinations = surnames.size() * initials.size() * initials.size();
+    size_t combination = number % combinations;
+
+    const string& surname = surnames[combination % surnames.size()];
+    const string& firstInitial = initials[(combination / surnames.size()) % initials.size()];
+    const string& secondInitial = initials[combination / surnames.size() / initials.size()];
+
+    // Без ланцюжка тимчасових рядків operator+ (на ньому GCC дає -Wrestrict).
+    string name;
+    name.reserve(surname.size() + firstInitial.size() + secondInitial.size() + 16);
+    name.append(surname).append(" ");
+    name.append(firstInitial).append(".");
+    name.append(secondInitial).append(".");
+    if (number >= combinations) name.append(" ").append(to_string(number / combinations + 1));
+    return name;
+}
+
+string CatalogGenerator::MakeArticle(size_t index)
+{
+    string digits = to_string(index);
+    string article;
+    article.reserve(8 + digits.size());
+    article.append("B");
+    article.append(digits.size() < 7 ? 7 - digits.size() : 0, '0');
+    article.append(digits);
+    return article;
+}
+
+string CatalogGenerator::makeTitle(mt19937_64& random, bool ukrainian) const
+{
+    // Переважно мовою автора, зрідка - перекладні назви.
+    if (nextIndex(random, 10) == 0) ukrainian = !ukrainian;
+    const vector<string>& heads = ukrainian ? UKR_TITLE_HEADS : LAT_TITLE_HEADS;
+    const vector<string>& words = ukrainian ? UKR_TITLE_WORDS : LAT_TITLE_WORDS;
+
+    string title = heads[nextIndex(random, heads.size())];
+    size_t length = 1 + nextWeighted(random, TITLE_LENGTH_WEIGHTS);
+    for (size_t i = 1; i < length; i++)
+    {
+        title += ' ';
+        title += words[nextIndex(random, words.size())];
+    }
+    return title;
+}
+
+const string& CatalogGenerator::getPassword(const User& user) const
+{
+    return PASSWORDS[user.password];
+}
\ No newline at end of file
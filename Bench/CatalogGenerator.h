@@ -0,0 +1,156 @@
+#pragma once
+#include "../Entities/UserAccount.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <random>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class ZipfDistribution
+  * @brief Розподіл Ціпфа на рангах 0..n-1: ранг k випадає з імовірністю ~ 1/(k+1)^s.
+  *
+  * Вибірка методом rejection-inversion (Hormann, Derflinger) - O(1) пам'яті
+  * та в середньому менше двох спроб, тож годиться і для мільйонів рангів.
+  * Випадкові числа беруться безпосередньо з mt19937_64, без стандартних
+  * розподілів, реалізація яких різниться між бібліотеками: однакове зерно
+  * дає однакову послідовність і з MSVC, і з libstdc++.
+  */
+class ZipfDistribution
+{
+private:
+    uint64_t count;
+    double exponent;
+    double hIntegralFirst;
+    double hIntegralLast;
+    double squeeze;
+
+public:
+    /**
+     * @param count Кількість рангів (не менше 1).
+     * @param exponent Показник s > 0: чим більший, тим сильніший перекіс.
+     */
+    ZipfDistribution(uint64_t count, double exponent);
+
+    uint64_t operator()(mt19937_64& random) const;
+
+private:
+    double h(double x) const;
+    double hIntegral(double x) const;
+    double hIntegralInverse(double x) const;
+};
+
+ /**
+  * @class CatalogGenerator
+  * @brief Детермінований генератор синтетичних даних у форматах застосунку.
+  *
+  * Створює каталог (library_db.csv), файл користувачів (users.txt) і трасу
+  * операцій для пакетного режиму (LibraryApp --batch), щоб вимірювати Library
+  * та AuthManager на даних реалістичного розміру й форми:
+  *  - популярність авторів за Ціпфом, полиці заповнені нерівномірно;
+  *  - назви українською та англійською, від одного до семи слів;
+  *  - частка книг уже видана читачам із файлу користувачів;
+  *  - траса - сесії LOGIN ... LOGOUT із сумішшю пошуку, фільтрів, видач і
+  *    повернень; популярні книги запитуються частіше.
+  *
+  * Траса узгоджена з каталогом: видаються лише вільні книги, повертаються
+  * лише видані, тож на щойно згенерованих файлах кожна команда - "OK".
+  * Каталог і траса генеруються кожен зі свого зерна, похідного від
+  * Options::seed, тому результат не залежить від порядку викликів Write*.
+  * Кожен користувач входить не більше п'яти разів за трасу - як дозволяє
+  * обмежувач частоти AuthManager.
+  */
+class CatalogGenerator
+{
+public:
+    /**
+     * @struct Options
+     * @brief Масштаб і форма даних.
+     */
+    struct Options
+    {
+        size_t books = 20000;
+        size_t users = 1000;
+        size_t authors = 0;             ///< 0 - одна восьма від кількості книг.
+        int shelves = 500;
+        double authorSkew = 0.7;        ///< Показник Ціпфа для авторів.
+        double shelfSkew = 0.7;         ///< Показник Ціпфа для полиць.
+        double bookSkew = 1.0;          ///< Показник Ціпфа для запитів до книг.
+        double issuedFraction = 0.1;
+        double librarianFraction = 0.05;
+        double adminFraction = 0.01;
+
+        size_t operations = 100000;
+        size_t sessionLength = 50;      ///< Середня кількість команд між LOGIN і LOGOUT.
+        double staffSessionFraction = 0.1;
+        unsigned lookupShare = 70;      ///< Частки операцій траси (у відсотках чи будь-яких вагах).
+        unsigned filterShare = 10;
+        unsigned issueShare = 10;
+        unsigned returnShare = 10;
+
+        uint64_t seed = 20240601;
+    };
+
+private:
+    struct User
+    {
+        string username;
+        size_t password;
+        UserAccount::Role role;
+    };
+
+    Options options;
+    vector<User> users;
+    vector<uint32_t> readers;
+    vector<uint32_t> staff;
+    vector<uint32_t> bookAuthors;
+    vector<int> shelfRanks;
+    vector<int> bookShelves;
+    vector<int32_t> bookHolders;
+
+public:
+    /**
+     * @brief Генерує користувачів і розкладку книг (автор, полиця, читач).
+     * @throw runtime_error Якщо параметри не дають жодного читача чи книги.
+     */
+    explicit CatalogGenerator(const Options& options);
+
+    /**
+     * @brief Пише каталог у форматі CSV Library.
+     */
+    void WriteCatalog(ostream& output) const;
+
+    /**
+     * @brief Пише файл користувачів; паролі хешуються PasswordHasher.
+     *
+     * Хешується лише невеликий набір паролів (по одному разу), інакше
+     * PBKDF2 на кожного користувача займав би хвилини. Сіль випадкова, тож
+     * байти файлу від запуску до запуску різняться, але логіни й паролі - ні.
+     */
+    void WriteUsers(ostream& output) const;
+
+    /**
+     * @brief Пише трасу команд BatchRunner.
+     * @return Кількість команд каталогу (без LOGIN/LOGOUT).
+     */
+    size_t WriteTrace(ostream& output) const;
+
+    size_t GetAuthorCount() const;
+
+    /**
+     * @brief Ім'я автора за рангом популярності (0 - найпопулярніший).
+     */
+    static string GetAuthorName(size_t index);
+
+    /**
+     * @brief Артикул книги за номером: "B0000042".
+     */
+    static string MakeArticle(size_t index);
+
+private:
+    string makeTitle(mt19937_64& random, bool ukrainian) const;
+    const string& getPassword(const User& user) const;
+};
\ No newline at end of file
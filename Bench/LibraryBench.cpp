@@ -0,0 +1,200 @@
+#include "CatalogGenerator.h"
+#include "../Core/Executor.h"
+#include "../Managers/Library.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+namespace
+{
+    const vector<size_t> DEFAULT_SIZES = { 10000, 1000000 };
+    const size_t LOOKUPS = 1000000;
+    const size_t FILTERS = 200;
+    const size_t LOANS = 100000;
+    const size_t AUTHOR_COUNT = 5000;
+    const int SHELF_COUNT = 500;
+    const uint64_t SEED = 20240601;
+
+    using Clock = chrono::steady_clock;
+
+    /**
+     * @brief Потік, що нічого не виводить: приглушує повідомлення Library.
+     */
+    class NullBuffer : public streambuf
+    {
+    protected:
+        int overflow(int c) override { return c; }
+    };
+
+    /**
+     * @brief Пише синтетичний каталог у форматі CSV Library (без виданих книг,
+     * щоб видачі вимірювались на вільних примірниках).
+     */
+    void writeCatalog(const filesystem::path& path, size_t count)
+    {
+        CatalogGenerator::Options options;
+        options.books = count;
+        options.authors = AUTHOR_COUNT;
+        options.shelves = SHELF_COUNT;
+        options.issuedFraction = 0;
+        options.seed = SEED;
+
+        ofstream file(path, ios::binary);
+        CatalogGenerator(options).WriteCatalog(file);
+    }
+
+    /**
+     * @brief Друкує рядок звіту: загальний час і час на операцію.
+     */
+    void report(ostream& output, size_t books, const string& name,
+        Clock::time_point start, size_t operations)
+    {
+        double milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+        output << setw(10) << books << "  " << left << setw(22) << name << right
+            << setw(12) << fixed << setprecision(2) << milliseconds << " ms"
+            << setw(14) << setprecision(1) << milliseconds * 1e6 / operations << " ns/op\n";
+    }
+
+    /**
+     * @brief Вимірює всі операції на каталозі з count книг.
+     * @return Контрольна сума результатів (щоб компілятор нічого не викинув).
+     */
+    size_t runSize(ostream& output, const filesystem::path& directory, size_t count)
+    {
+        filesystem::path dataPath = directory / ("catalog_" + to_string(count) + ".csv");
+        writeCatalog(dataPath, count);
+        size_t checksum = 0;
+
+        Clock::time_point start = Clock::now();
+        {
+            Library loaded(dataPath.string());
+            report(output, count, "load (sync)", start, count);
+            checksum += loaded.GetBookCount();
+        }
+        filesystem::remove(dataPath.string() + ".idx");
+
+        Executor executor(max(2u, thread::hardware_concurrency()));
+        Library library(dataPath.string(), false);
+        start = Clock::now();
+        Task<size_t> load = library.LoadAsync(executor);
+        load.Start();
+        library.WaitForLoad();
+        report(output, count, "load (async)", start, count);
+
+        start = Clock::now();
+        library.SaveToFile();
+        report(output, count, "save", start, count);
+
+        mt19937_64 random(SEED + count);
+        vector<string> articles(LOOKUPS);
+        for (string& article : articles)
+        {
+            article = CatalogGenerator::MakeArticle(random() % count);
+        }
+
+        const Library& catalog = library;
+        start = Clock::now();
+        for (const string& article : articles)
+        {
+            const Book* book = catalog.FindBookByArticle(article);
+            checksum += book != nullptr ? book->GetShelfNumber() : 0;
+        }
+        report(output, count, "lookup", start, LOOKUPS);
+
+        start = Clock::now();
+        for (size_t i = 0; i < FILTERS; i++)
+        {
+            checksum += library.FilterByAuthor(CatalogGenerator::GetAuthorName(random() % AUTHOR_COUNT)).size();
+        }
+        report(output, count, "filter author", start, FILTERS);
+
+        start = Clock::now();
+        for (size_t i = 0; i < FILTERS; i++)
+        {
+            checksum += library.FilterByShelf(static_cast<int>(1 + random() % SHELF_COUNT)).size();
+        }
+        report(output, count, "filter shelf", start, FILTERS);
+
+        start = Clock::now();
+        for (size_t i = 0; i < FILTERS; i++)
+        {
+            Money from = Money::FromKopecks(static_cast<int64_t>(2000 + random() % 100000));
+            checksum += library.FilterByPriceRange(from, from + Money::FromKopecks(1000)).size();
+        }
+        report(output, count, "filter price range", start, FILTERS);
+
+        start = Clock::now();
+        for (size_t i = 0; i < LOANS; i++)
+        {
+            library.IssueBook(articles[i], "Reader " + to_string(i % 1000));
+        }
+        for (size_t i = 0; i < LOANS; i++)
+        {
+            checksum += library.ReturnBook(articles[i]) == Library::LoanStatus::Done;
+        }
+        report(output, count, "issue+return", start, 2 * LOANS);
+
+        start = Clock::now();
+        library.SortByTitle();
+        report(output, count, "sort title", start, count);
+
+        start = Clock::now();
+        library.SortByAuthor();
+        report(output, count, "sort author", start, count);
+
+        start = Clock::now();
+        library.SortByPrice();
+        report(output, count, "sort price", start, count);
+
+        return checksum;
+    }
+}
+
+/**
+ * Використання:
+ *   library_bench [кількість книг]...   - за замовчуванням 10000 і 1000000
+ *   library_bench 10000 1000000 10000000
+ *
+ * Каталоги генеруються детерміновано (одне зерно) у тимчасовому каталозі.
+ */
+int main(int argc, char* argv[])
+{
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; i++)
+    {
+        sizes.push_back(stoul(argv[i]));
+    }
+    if (sizes.empty()) sizes = DEFAULT_SIZES;
+
+    filesystem::path directory = filesystem::temp_directory_path() / "library_bench";
+    filesystem::create_directories(directory);
+
+    // Результати - у stdout, повідомлення Library приглушено.
+    ostream output(cout.rdbuf());
+    NullBuffer nullBuffer;
+    cout.rdbuf(&nullBuffer);
+
+    output << setw(10) << "books" << "  " << left << setw(22) << "operation" << right
+        << setw(15) << "total" << setw(20) << "per operation\n";
+
+    size_t checksum = 0;
+    for (size_t count : sizes)
+    {
+        if (count == 0) continue;
+        checksum += runSize(output, directory, count);
+    }
+
+    cout.rdbuf(output.rdbuf());
+    filesystem::remove_all(directory);
+    output << "checksum " << checksum << "\n";
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "CatalogGenerator.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    // Імена файлів, які читає LibraryApp у робочому каталозі.
+    const string CATALOG_FILE = "library_db.csv";
+    const string USERS_FILE = "users.txt";
+    const string TRACE_FILE = "trace.txt";
+    const string FORCE_FLAG = "--force";
+
+    // Супутні файли старих даних: індекс каталогу та журнал користувачів
+    // застосувалися б до нових файлів, тож їх треба прибрати.
+    const vector<string> STALE_FILES = { "library_db.csv.idx", "users.txt.journal" };
+
+    const string USAGE =
+        "Використання: library_gen --out <каталог> [параметри]\n"
+        "  --out <каталог>        куди писати файли (обов'язково)\n"
+        "  --force                перезаписати наявні файли даних у каталозі\n"
+        "  --books <n>            кількість книг (20000)\n"
+        "  --users <n>            кількість користувачів (1000)\n"
+        "  --authors <n>          кількість авторів (книги / 8)\n"
+        "  --shelves <n>          кількість полиць (500)\n"
+        "  --author-skew <s>      показник Ціпфа для авторів (0.7)\n"
+        "  --shelf-skew <s>       показник Ціпфа для полиць (0.7)\n"
+        "  --book-skew <s>        показник Ціпфа для запитів до книг (1.0)\n"
+        "  --issued <частка>      частка виданих книг (0.1)\n"
+        "  --operations <n>       кількість команд траси (100000, 0 - без траси)\n"
+        "  --session <n>          середня довжина сесії (50)\n"
+        "  --mix <l,f,i,r>        ваги пошуку, фільтрів, видач і повернень (70,10,10,10)\n"
+        "  --seed <n>             зерно генератора (20240601)\n"
+        "\n"
+        "Прогін траси: у каталозі --out виконати LibraryApp --batch trace.txt\n";
+
+    /**
+     * @brief Розбирає "l,f,i,r" у частки операцій траси.
+     */
+    void parseMix(const string& value, CatalogGenerator::Options& options)
+    {
+        unsigned* shares[] = {
+            &options.lookupShare, &options.filterShare, &options.issueShare, &options.returnShare };
+
+        size_t start = 0;
+        for (unsigned* share : shares)
+        {
+            if (start > value.size()) throw invalid_argument("--mix");
+            size_t end = value.find(',', start);
+            *share = static_cast<unsigned>(stoul(value.substr(start, end - start)));
+            start = (end == string::npos) ? value.size() + 1 : end + 1;
+        }
+    }
+
+    /**
+     * @brief Розбирає параметри командного рядка.
+     * @return false, якщо параметр невідомий, без значення або не задано --out.
+     */
+    bool parseArguments(int argc, char* argv[], CatalogGenerator::Options& options,
+        filesystem::path& directory, bool& force)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string name = argv[i];
+            if (name == FORCE_FLAG)
+            {
+                force = true;
+                continue;
+            }
+            if (i + 1 >= argc) return false;
+            string value = argv[++i];
+
+            if (name == "--out") directory = value;
+            else if (name == "--books") options.books = stoull(value);
+            else if (name == "--users") options.users = stoull(value);
+            else if (name == "--authors") options.authors = stoull(value);
+            else if (name == "--shelves") options.shelves = stoi(value);
+            else if (name == "--author-skew") options.authorSkew = stod(value);
+            else if (name == "--shelf-skew") options.shelfSkew = stod(value);
+            else if (name == "--book-skew") options.bookSkew = stod(value);
+            else if (name == "--issued") options.issuedFraction = stod(value);
+            else if (name == "--operations") options.operations = stoull(value);
+            else if (name == "--session") options.sessionLength = stoull(value);
+            else if (name == "--mix") parseMix(value, options);
+            else if (name == "--seed") options.seed = stoull(value);
+            else return false;
+        }
+        return !directory.empty();
+    }
+
+    /**
+     * @brief Шукає у каталозі файли, які генератор перезаписав би чи видалив.
+     * @return Перелік наявних файлів (порожній, якщо каталог вільний).
+     */
+    vector<filesystem::path> findExistingFiles(const filesystem::path& directory)
+    {
+        vector<string> names = { CATALOG_FILE, USERS_FILE, TRACE_FILE };
+        names.insert(names.end(), STALE_FILES.begin(), STALE_FILES.end());
+
+        vector<filesystem::path> existing;
+        for (const string& name : names)
+        {
+            if (filesystem::exists(directory / name)) existing.push_back(directory / name);
+        }
+        return existing;
+    }
+
+    /**
+     * @brief Пише один файл і друкує, скільки це зайняло.
+     */
+    template <typename Writer>
+    void writeFile(const filesystem::path& path, Writer writer)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        ofstream file(path, ios::binary);
+        if (!file.is_open())
+        {
+            throw runtime_error("Не вдалося відкрити файл для запису: " + path.string());
+        }
+        writer(file);
+
+        double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cerr << path.string() << ": " << static_cast<long long>(milliseconds) << " мс\n";
+    }
+}
+
+/**
+ * Генерує library_db.csv, users.txt і trace.txt заданого масштабу.
+ * Однакові параметри й зерно дають однаковий каталог і трасу.
+ */
+int main(int argc, char* argv[])
+{
+    CatalogGenerator::Options options;
+    filesystem::path directory;
+    bool force = false;
+    try
+    {
+        if (!parseArguments(argc, argv, options, directory, force))
+        {
+            cerr << USAGE;
+            return 1;
+        }
+
+        // Каталог може бути робочим каталогом застосунку зі справжніми
+        // даними, тож без --force нічого наявного не чіпаємо.
+        vector<filesystem::path> existing = findExistingFiles(directory);
+        if (!existing.empty() && !force)
+        {
+            cerr << "Помилка: Файли вже існують (додайте " << FORCE_FLAG << ", щоб перезаписати):\n";
+            for (const filesystem::path& path : existing)
+            {
+                cerr << "  " << path.string() << "\n";
+            }
+            return 1;
+        }
+
+        filesystem::create_directories(directory);
+        CatalogGenerator generator(options);
+        for (const string& stale : STALE_FILES)
+        {
+            filesystem::remove(directory / stale);
+        }
+
+        writeFile(directory / CATALOG_FILE, [&](ostream& file) { generator.WriteCatalog(file); });
+        writeFile(directory / USERS_FILE, [&](ostream& file) { generator.WriteUsers(file); });
+        if (options.operations > 0)
+        {
+            writeFile(directory / TRACE_FILE, [&](ostream& file) { generator.WriteTrace(file); });
+        }
+    }
+    catch (const exception& e)
+    {
+        cerr << "Помилка: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
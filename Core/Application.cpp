@@ -1,5 +1,12 @@
 #include "Application.h"
+#include "../Managers/QueryServer.h"
+#include "../Managers/PagedCatalog.h"
+#include "../Managers/BatchRunner.h"
 #include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <csignal>
 
 using namespace std;
 
@@ -7,26 +14,131 @@ namespace
 {
     const string DB_FILE_PATH = "library_db.csv";
     const string USERS_FILE_PATH = "users.txt";
+    const string PAGES_FILE_PATH = "library_db.pages";
+    const size_t BACKGROUND_WORKERS = 2;
+
+    atomic<QueryServer*> activeServer(nullptr);
+
+    void onInterrupt(int)
+    {
+        QueryServer* server = activeServer.load();
+        if (server != nullptr) server->Stop();
+    }
 }
 
 Application::Application()
-    : library(DB_FILE_PATH),
-    authManager(USERS_FILE_PATH),
-    uiManager(&library, &authManager)
+    : executor(BACKGROUND_WORKERS),
+    library(DB_FILE_PATH, false),
+    authManager(USERS_FILE_PATH, false),
+    uiManager(&library, &authManager, &executor)
 {
-    cout << " .\n";
+    this->libraryLoad = this->library.LoadAsync(this->executor);
+    this->libraryLoad.Start();
+
+    this->usersLoad = this->authManager.LoadUsersAsync(this->executor);
+    this->usersLoad.Start();
+
+    cout << "Додаток ініціалізовано.\n";
 }
 
 Application::~Application()
 {
-    cout << "  .\n";
+    cout << "Додаток завершує роботу.\n";
 }
 
 void Application::Run()
 {
-    cout << " ...\n";
+    cout << "Додаток запущено...\n";
 
     uiManager.StartMainLoop();
 
-    cout << "  .\n";
+    cout << "Робота додатка завершена.\n";
+}
+
+void Application::RunServer(unsigned short port, size_t workerCount)
+{
+    QueryServer server(&library, &authManager, port, workerCount);
+
+    activeServer = &server;
+    signal(SIGINT, onInterrupt);
+    signal(SIGTERM, onInterrupt);
+
+    try
+    {
+        server.Run();
+    }
+    catch (...)
+    {
+        activeServer = nullptr;
+        throw;
+    }
+
+    activeServer = nullptr;
+}
+
+size_t Application::RunBatch(const string& scriptPath, ostream& output)
+{
+    ifstream scriptFile;
+    if (!scriptPath.empty())
+    {
+        scriptFile.open(scriptPath);
+        if (!scriptFile.is_open())
+        {
+            throw runtime_error("Не вдалося відкрити файл команд " + scriptPath);
+        }
+    }
+
+    BatchRunner runner(&library, &authManager);
+    BatchRunner::Summary summary = runner.Run(
+        scriptPath.empty() ? cin : static_cast<istream&>(scriptFile), output);
+
+    cerr << "Пакетний режим: команд " << summary.commands
+         << ", помилок " << summary.failed
+         << ", час " << summary.elapsedMilliseconds << " мс\n";
+    return summary.failed;
+}
+
+void Application::RunPagedLookup(size_t cachePages)
+{
+    error_code error;
+    bool rebuild = !filesystem::exists(PAGES_FILE_PATH, error)
+        || (filesystem::exists(DB_FILE_PATH, error)
+            && filesystem::last_write_time(DB_FILE_PATH, error)
+               > filesystem::last_write_time(PAGES_FILE_PATH, error));
+    if (rebuild)
+    {
+        size_t written = PagedCatalog::BuildFromCsv(DB_FILE_PATH, PAGES_FILE_PATH);
+        cout << "Файл сторінок " << PAGES_FILE_PATH << " створено: "
+             << written << " книг.\n";
+    }
+
+    PagedCatalog catalog(PAGES_FILE_PATH, cachePages);
+    cout << "Каталог відкрито: " << catalog.GetBookCount() << " книг, кеш "
+         << cachePages << " сторінок.\n";
+
+    string article;
+    while (getline(cin, article))
+    {
+        if (!article.empty() && article.back() == '\r') article.pop_back();
+        if (article.empty()) continue;
+
+        optional<Book> book = catalog.FindBookByArticle(article);
+        if (book.has_value())
+        {
+            cout << book->ToCsvString() << "\n";
+        }
+        else
+        {
+            cout << article << ": не знайдено\n";
+        }
+    }
+
+    BufferPool::Stats stats = catalog.GetCacheStats();
+    uint64_t requests = stats.hits + stats.misses;
+    cout << "Кеш сторінок: влучань " << stats.hits
+         << ", промахів " << stats.misses
+         << ", витіснень " << stats.evictions
+         << ", у пам'яті " << stats.residentPages << "/" << stats.capacity
+         << " (частка влучань "
+         << (requests > 0 ? 100 * stats.hits / requests : 0) << "%)\n";
 }
\ No newline at end of file
@@ -1,39 +1,74 @@
 #pragma once
+#include "Executor.h"
+#include "Task.h"
 #include "../Managers/Library.h"
 #include "../Managers/AuthManager.h"
 #include "../Managers/UIManager.h"
+#include <iostream>
 
 using namespace std;
 
  /**
   * @class Application
-  * @brief   ,   '.
+  * @brief Головний клас програми, що все об'єднує.
   *
-  *     Library  AuthManager
-  *     .
+  * Створює та зберігає екземпляри Library та AuthManager
+  * і запускає головний цикл програми.
   */
 class Application
 {
 private:
+    // Порядок важливий: задачі завантаження знищуються (і дочікуються)
+    // раніше за менеджери, а виконавець - останнім.
+    Executor executor;
     Library library;
     AuthManager authManager;
     UIManager uiManager;
+    Task<size_t> libraryLoad;
+    Task<void> usersLoad;
 
 public:
     /**
-     * @brief .
-     *   .
+     * @brief Конструктор.
+     * Ініціалізує всі менеджери та запускає фонове завантаження даних,
+     * тож меню входу з'являється, не чекаючи кінця читання файлів.
      */
     Application();
 
     /**
-     * @brief .
+     * @brief Деструктор.
      */
     ~Application();
 
     /**
-     * @brief    .
-     *       .
+     * @brief Запускає головний цикл програми.
+     * Це основна точка входу в логіку програми.
      */
     void Run();
+
+    /**
+     * @brief Запускає мережевий сервер замість консольного меню.
+     * Працює, доки процес не отримає сигнал переривання (Ctrl+C).
+     * @param port TCP-порт.
+     * @param workerCount Кількість робочих потоків (0 - за кількістю ядер).
+     */
+    void RunServer(unsigned short port, size_t workerCount);
+
+    /**
+     * @brief Виконує команди з файлу або стандартного вводу без меню (BatchRunner).
+     * Підсумок (кількість команд, помилок і час) друкується в cerr.
+     * @param scriptPath Шлях до файлу команд (порожньо - стандартний ввід).
+     * @param output Потік для результатів команд.
+     * @return Кількість команд, що завершилися помилкою.
+     */
+    size_t RunBatch(const string& scriptPath, ostream& output);
+
+    /**
+     * @brief Пошук книг у каталозі, що не завантажується в пам'ять.
+     * Файл сторінок (поруч із файлом даних) перебудовується, якщо CSV новіший.
+     * Артикули читаються зі стандартного вводу по одному на рядок,
+     * наприкінці друкується статистика кешу сторінок.
+     * @param cachePages Розмір кешу в сторінках.
+     */
+    static void RunPagedLookup(size_t cachePages);
 };
\ No newline at end of file
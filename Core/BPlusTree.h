@@ -0,0 +1,637 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+ /**
+  * @class BPlusTree
+  * @brief Впорядкована множина ключів у вигляді B+-дерева в пам'яті.
+  *
+  * Ключі зберігаються лише в листках, листки зв'язані у список, тож
+  * пошук і вставка/видалення коштують O(log n), а обхід діапазону -
+  * O(log n + k). Внутрішні вузли знають кількість ключів у піддереві
+  * кожного нащадка, тож ключ за порядковим номером (At()) теж
+  * знаходиться спуском за O(log n). Масив ключів вузла займає кілька кеш-ліній
+  * (NodeKeys за замовчуванням розраховано на ~256 байтів ключів).
+  *
+  * Дерево не синхронізоване: захист - на власникові (як і в Library).
+  *
+  * @tparam Key Тип ключа (копійований, з конструктором за замовчуванням).
+  * @tparam Compare Строгий порядок ключів.
+  * @tparam NodeKeys Максимальна кількість ключів у вузлі (не менше 4).
+  */
+template<typename Key,
+    typename Compare = less<Key>,
+    size_t NodeKeys = max<size_t>(4, 256 / sizeof(Key))>
+class BPlusTree
+{
+    static_assert(NodeKeys >= 4, "Вузол B+-дерева має вміщати щонайменше 4 ключі");
+
+private:
+    static const size_t MIN_KEYS = NodeKeys / 2;
+
+    // Масиви мають запас в один елемент: вузол спершу переповнюється,
+    // а потім ділиться навпіл.
+    struct Node
+    {
+        bool isLeaf;
+        size_t count = 0;
+        array<Key, NodeKeys + 1> keys;
+
+        explicit Node(bool isLeaf) : isLeaf(isLeaf) {}
+    };
+
+    struct Leaf : Node
+    {
+        Leaf* next = nullptr;
+        Leaf* prev = nullptr;
+
+        Leaf() : Node(true) {}
+    };
+
+    struct Inner : Node
+    {
+        array<Node*, NodeKeys + 2> children{};
+        array<size_t, NodeKeys + 2> childSizes{};   ///< Кількість ключів у піддереві children[i].
+
+        Inner() : Node(false) {}
+    };
+
+    Node* root;
+    Leaf* firstLeaf;
+    size_t size;
+    Compare compare;
+
+public:
+    /**
+     * @class ConstIterator
+     * @brief Ітератор по ключах у порядку зростання.
+     */
+    class ConstIterator
+    {
+    private:
+        const Leaf* leaf;
+        size_t position;
+
+    public:
+        ConstIterator(const Leaf* leaf = nullptr, size_t position = 0)
+            : leaf(leaf), position(position)
+        {
+            this->skipExhaustedLeaves();
+        }
+
+        const Key& operator*() const { return this->leaf->keys[this->position]; }
+        const Key* operator->() const { return &this->leaf->keys[this->position]; }
+
+        ConstIterator& operator++()
+        {
+            this->position++;
+            this->skipExhaustedLeaves();
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const
+        {
+            return this->leaf == other.leaf && this->position == other.position;
+        }
+
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+
+    private:
+        void skipExhaustedLeaves()
+        {
+            while (this->leaf != nullptr && this->position >= this->leaf->count)
+            {
+                this->leaf = this->leaf->next;
+                this->position = 0;
+            }
+        }
+    };
+
+    BPlusTree() : root(nullptr), firstLeaf(nullptr), size(0)
+    {
+        this->reset();
+    }
+
+    ~BPlusTree() { destroy(this->root); }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    /**
+     * @brief Додає ключ.
+     * @return false, якщо такий ключ уже є.
+     */
+    bool Insert(const Key& key)
+    {
+        Key splitKey;
+        Node* splitNode = nullptr;
+        if (!this->insertInto(this->root, key, splitKey, splitNode))
+        {
+            return false;
+        }
+
+        if (splitNode != nullptr)
+        {
+            Inner* newRoot = new Inner();
+            newRoot->keys[0] = splitKey;
+            newRoot->children[0] = this->root;
+            newRoot->children[1] = splitNode;
+            newRoot->childSizes[0] = subtreeSize(this->root);
+            newRoot->childSizes[1] = subtreeSize(splitNode);
+            newRoot->count = 1;
+            this->root = newRoot;
+        }
+        this->size++;
+        return true;
+    }
+
+    /**
+     * @brief Видаляє ключ.
+     * @return false, якщо ключа не було.
+     */
+    bool Erase(const Key& key)
+    {
+        if (!this->eraseFrom(this->root, key))
+        {
+            return false;
+        }
+
+        if (!this->root->isLeaf && this->root->count == 0)
+        {
+            Inner* oldRoot = static_cast<Inner*>(this->root);
+            this->root = oldRoot->children[0];
+            delete oldRoot;
+        }
+        this->size--;
+        return true;
+    }
+
+    /**
+     * @brief Перевіряє наявність ключа.
+     */
+    bool Contains(const Key& key) const
+    {
+        ConstIterator it = this->LowerBound(key);
+        return it != this->end() && !this->compare(key, *it);
+    }
+
+    /**
+     * @brief Перший ключ, не менший за key.
+     */
+    ConstIterator LowerBound(const Key& key) const
+    {
+        const Node* node = this->root;
+        while (!node->isLeaf)
+        {
+            const Inner* inner = static_cast<const Inner*>(node);
+            node = inner->children[this->childIndex(inner, key)];
+        }
+
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        size_t position = lower_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count,
+            key, this->compare) - leaf->keys.begin();
+        return ConstIterator(leaf, position);
+    }
+
+    /**
+     * @brief Викликає visitor для кожного ключу з [from, to] у порядку зростання.
+     */
+    void ScanRange(const Key& from, const Key& to, const function<void(const Key&)>& visitor) const
+    {
+        for (ConstIterator it = this->LowerBound(from); it != this->end(); ++it)
+        {
+            if (this->compare(to, *it)) break;
+            visitor(*it);
+        }
+    }
+
+    /**
+     * @brief Ключ із порядковим номером index (для посторінкового обходу).
+     * Спускається за розмірами піддерев: O(log n).
+     * @return end(), якщо index >= Size().
+     */
+    ConstIterator At(size_t index) const
+    {
+        if (index >= this->size) return this->end();
+
+        const Node* node = this->root;
+        while (!node->isLeaf)
+        {
+            const Inner* inner = static_cast<const Inner*>(node);
+            size_t child = 0;
+            while (index >= inner->childSizes[child])
+            {
+                index -= inner->childSizes[child];
+                child++;
+            }
+            node = inner->children[child];
+        }
+        return ConstIterator(static_cast<const Leaf*>(node), index);
+    }
+
+    ConstIterator begin() const { return ConstIterator(this->firstLeaf, 0); }
+    ConstIterator end() const { return ConstIterator(); }
+
+    size_t Size() const { return this->size; }
+    bool IsEmpty() const { return this->size == 0; }
+
+    /**
+     * @brief Будує дерево заново з відсортованих унікальних ключів знизу
+     * вгору за O(n) - дешевше, ніж n окремих вставок.
+     * @param sortedKeys Ключі в порядку зростання без повторів.
+     */
+    void Assign(const vector<Key>& sortedKeys)
+    {
+        this->Clear();
+        if (sortedKeys.empty()) return;
+
+        vector<Node*> level;
+        vector<Key> levelMinKeys;
+
+        size_t leafCount = (sortedKeys.size() + NodeKeys - 1) / NodeKeys;
+        Leaf* previous = nullptr;
+        size_t position = 0;
+        for (size_t i = 0; i < leafCount; i++)
+        {
+            // Ключі розподіляються рівномірно, тож жоден листок не буде недозаповненим.
+            size_t take = sortedKeys.size() / leafCount + (i < sortedKeys.size() % leafCount ? 1 : 0);
+            Leaf* leaf = (i == 0) ? this->firstLeaf : new Leaf();
+            for (size_t k = 0; k < take; k++)
+            {
+                leaf->keys[k] = sortedKeys[position + k];
+            }
+            leaf->count = take;
+            leaf->prev = previous;
+            if (previous != nullptr) previous->next = leaf;
+            previous = leaf;
+
+            level.push_back(leaf);
+            levelMinKeys.push_back(sortedKeys[position]);
+            position += take;
+        }
+
+        while (level.size() > 1)
+        {
+            vector<Node*> parents;
+            vector<Key> parentMinKeys;
+
+            size_t parentCount = (level.size() + NodeKeys) / (NodeKeys + 1);
+            size_t child = 0;
+            for (size_t i = 0; i < parentCount; i++)
+            {
+                size_t take = level.size() / parentCount + (i < level.size() % parentCount ? 1 : 0);
+                Inner* inner = new Inner();
+                for (size_t k = 0; k < take; k++)
+                {
+                    inner->children[k] = level[child + k];
+                    inner->childSizes[k] = subtreeSize(level[child + k]);
+                    if (k > 0) inner->keys[k - 1] = levelMinKeys[child + k];
+                }
+                inner->count = take - 1;
+
+                parents.push_back(inner);
+                parentMinKeys.push_back(levelMinKeys[child]);
+                child += take;
+            }
+
+            level = move(parents);
+            levelMinKeys = move(parentMinKeys);
+        }
+
+        this->root = level[0];
+        this->size = sortedKeys.size();
+    }
+
+    /**
+     * @brief Видаляє всі ключі.
+     */
+    void Clear()
+    {
+        destroy(this->root);
+        this->reset();
+    }
+
+private:
+    void reset()
+    {
+        Leaf* leaf = new Leaf();
+        this->root = leaf;
+        this->firstLeaf = leaf;
+        this->size = 0;
+    }
+
+    static void destroy(Node* node)
+    {
+        if (node == nullptr) return;
+        if (node->isLeaf)
+        {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        for (size_t i = 0; i <= inner->count; i++)
+        {
+            destroy(inner->children[i]);
+        }
+        delete inner;
+    }
+
+    /**
+     * @brief Кількість ключів у піддереві: O(NodeKeys), бо внутрішній
+     * вузол уже зберігає розміри піддерев своїх нащадків.
+     */
+    static size_t subtreeSize(const Node* node)
+    {
+        if (node->isLeaf) return node->count;
+
+        const Inner* inner = static_cast<const Inner*>(node);
+        size_t total = 0;
+        for (size_t i = 0; i <= inner->count; i++) total += inner->childSizes[i];
+        return total;
+    }
+
+    /**
+     * @brief Індекс дочірнього вузла, у піддереві якого може бути key.
+     * Роздільник keys[i] більший за всі ключі children[i] і не більший
+     * за ключі children[i + 1].
+     */
+    size_t childIndex(const Inner* inner, const Key& key) const
+    {
+        return upper_bound(inner->keys.begin(), inner->keys.begin() + inner->count,
+            key, this->compare) - inner->keys.begin();
+    }
+
+    template<typename T>
+    static void insertAt(T& items, size_t count, size_t position, const typename T::value_type& value)
+    {
+        for (size_t i = count; i > position; i--) items[i] = items[i - 1];
+        items[position] = value;
+    }
+
+    template<typename T>
+    static void removeAt(T& items, size_t count, size_t position)
+    {
+        for (size_t i = position; i + 1 < count; i++) items[i] = items[i + 1];
+    }
+
+    bool insertInto(Node* node, const Key& key, Key& splitKey, Node*& splitNode)
+    {
+        if (node->isLeaf)
+        {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            size_t position = lower_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count,
+                key, this->compare) - leaf->keys.begin();
+            if (position < leaf->count && !this->compare(key, leaf->keys[position]))
+            {
+                return false;
+            }
+
+            insertAt(leaf->keys, leaf->count, position, key);
+            leaf->count++;
+            if (leaf->count > NodeKeys)
+            {
+                splitNode = this->splitLeaf(leaf);
+                splitKey = static_cast<Leaf*>(splitNode)->keys[0];
+            }
+            return true;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        size_t index = this->childIndex(inner, key);
+
+        Key childSplitKey;
+        Node* childSplitNode = nullptr;
+        if (!this->insertInto(inner->children[index], key, childSplitKey, childSplitNode))
+        {
+            return false;
+        }
+        inner->childSizes[index]++;
+
+        if (childSplitNode != nullptr)
+        {
+            size_t splitSize = subtreeSize(childSplitNode);
+            inner->childSizes[index] -= splitSize;
+            insertAt(inner->keys, inner->count, index, childSplitKey);
+            insertAt(inner->children, inner->count + 1, index + 1, childSplitNode);
+            insertAt(inner->childSizes, inner->count + 1, index + 1, splitSize);
+            inner->count++;
+            if (inner->count > NodeKeys)
+            {
+                splitNode = this->splitInner(inner, splitKey);
+            }
+        }
+        return true;
+    }
+
+    Leaf* splitLeaf(Leaf* leaf)
+    {
+        Leaf* right = new Leaf();
+        size_t keep = leaf->count / 2;
+        for (size_t i = keep; i < leaf->count; i++)
+        {
+            right->keys[i - keep] = leaf->keys[i];
+        }
+        right->count = leaf->count - keep;
+        leaf->count = keep;
+
+        right->next = leaf->next;
+        right->prev = leaf;
+        if (leaf->next != nullptr) leaf->next->prev = right;
+        leaf->next = right;
+        return right;
+    }
+
+    Inner* splitInner(Inner* inner, Key& promotedKey)
+    {
+        Inner* right = new Inner();
+        size_t middle = inner->count / 2;
+        promotedKey = inner->keys[middle];
+
+        for (size_t i = middle + 1; i < inner->count; i++)
+        {
+            right->keys[i - middle - 1] = inner->keys[i];
+        }
+        for (size_t i = middle + 1; i <= inner->count; i++)
+        {
+            right->children[i - middle - 1] = inner->children[i];
+            right->childSizes[i - middle - 1] = inner->childSizes[i];
+        }
+        right->count = inner->count - middle - 1;
+        inner->count = middle;
+        return right;
+    }
+
+    bool eraseFrom(Node* node, const Key& key)
+    {
+        if (node->isLeaf)
+        {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            size_t position = lower_bound(leaf->keys.begin(), leaf->keys.begin() + leaf->count,
+                key, this->compare) - leaf->keys.begin();
+            if (position >= leaf->count || this->compare(key, leaf->keys[position]))
+            {
+                return false;
+            }
+
+            removeAt(leaf->keys, leaf->count, position);
+            leaf->count--;
+            return true;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        size_t index = this->childIndex(inner, key);
+        if (!this->eraseFrom(inner->children[index], key))
+        {
+            return false;
+        }
+        inner->childSizes[index]--;
+
+        if (inner->children[index]->count < MIN_KEYS)
+        {
+            this->rebalanceChild(inner, index);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Виправляє недозаповненого нащадка: позичає ключ у сусіда
+     * або зливається з ним.
+     */
+    void rebalanceChild(Inner* parent, size_t index)
+    {
+        Node* left = (index > 0) ? parent->children[index - 1] : nullptr;
+        Node* right = (index < parent->count) ? parent->children[index + 1] : nullptr;
+
+        if (left != nullptr && left->count > MIN_KEYS)
+        {
+            this->borrowFromLeft(parent, index);
+        }
+        else if (right != nullptr && right->count > MIN_KEYS)
+        {
+            this->borrowFromRight(parent, index);
+        }
+        else if (left != nullptr)
+        {
+            this->mergeChildren(parent, index - 1);
+        }
+        else if (right != nullptr)
+        {
+            this->mergeChildren(parent, index);
+        }
+    }
+
+    void borrowFromLeft(Inner* parent, size_t index)
+    {
+        Node* child = parent->children[index];
+        Node* left = parent->children[index - 1];
+
+        if (child->isLeaf)
+        {
+            insertAt(child->keys, child->count, 0, left->keys[left->count - 1]);
+            child->count++;
+            left->count--;
+            parent->keys[index - 1] = child->keys[0];
+            parent->childSizes[index - 1]--;
+            parent->childSizes[index]++;
+            return;
+        }
+
+        Inner* innerChild = static_cast<Inner*>(child);
+        Inner* innerLeft = static_cast<Inner*>(left);
+        size_t movedSize = innerLeft->childSizes[innerLeft->count];
+        insertAt(innerChild->keys, innerChild->count, 0, parent->keys[index - 1]);
+        insertAt(innerChild->children, innerChild->count + 1, 0, innerLeft->children[innerLeft->count]);
+        insertAt(innerChild->childSizes, innerChild->count + 1, 0, movedSize);
+        innerChild->count++;
+        parent->childSizes[index - 1] -= movedSize;
+        parent->childSizes[index] += movedSize;
+        parent->keys[index - 1] = innerLeft->keys[innerLeft->count - 1];
+        innerLeft->count--;
+    }
+
+    void borrowFromRight(Inner* parent, size_t index)
+    {
+        Node* child = parent->children[index];
+        Node* right = parent->children[index + 1];
+
+        if (child->isLeaf)
+        {
+            child->keys[child->count] = right->keys[0];
+            child->count++;
+            removeAt(right->keys, right->count, 0);
+            right->count--;
+            parent->keys[index] = right->keys[0];
+            parent->childSizes[index]++;
+            parent->childSizes[index + 1]--;
+            return;
+        }
+
+        Inner* innerChild = static_cast<Inner*>(child);
+        Inner* innerRight = static_cast<Inner*>(right);
+        size_t movedSize = innerRight->childSizes[0];
+        innerChild->keys[innerChild->count] = parent->keys[index];
+        innerChild->children[innerChild->count + 1] = innerRight->children[0];
+        innerChild->childSizes[innerChild->count + 1] = movedSize;
+        innerChild->count++;
+        parent->keys[index] = innerRight->keys[0];
+        removeAt(innerRight->keys, innerRight->count, 0);
+        removeAt(innerRight->children, innerRight->count + 1, 0);
+        removeAt(innerRight->childSizes, innerRight->count + 1, 0);
+        innerRight->count--;
+        parent->childSizes[index] += movedSize;
+        parent->childSizes[index + 1] -= movedSize;
+    }
+
+    /**
+     * @brief Зливає children[index + 1] у children[index].
+     */
+    void mergeChildren(Inner* parent, size_t index)
+    {
+        Node* left = parent->children[index];
+        Node* right = parent->children[index + 1];
+
+        if (left->isLeaf)
+        {
+            Leaf* leftLeaf = static_cast<Leaf*>(left);
+            Leaf* rightLeaf = static_cast<Leaf*>(right);
+            for (size_t i = 0; i < rightLeaf->count; i++)
+            {
+                leftLeaf->keys[leftLeaf->count + i] = rightLeaf->keys[i];
+            }
+            leftLeaf->count += rightLeaf->count;
+
+            leftLeaf->next = rightLeaf->next;
+            if (rightLeaf->next != nullptr) rightLeaf->next->prev = leftLeaf;
+            delete rightLeaf;
+        }
+        else
+        {
+            Inner* leftInner = static_cast<Inner*>(left);
+            Inner* rightInner = static_cast<Inner*>(right);
+            leftInner->keys[leftInner->count] = parent->keys[index];
+            for (size_t i = 0; i < rightInner->count; i++)
+            {
+                leftInner->keys[leftInner->count + 1 + i] = rightInner->keys[i];
+            }
+            for (size_t i = 0; i <= rightInner->count; i++)
+            {
+                leftInner->children[leftInner->count + 1 + i] = rightInner->children[i];
+                leftInner->childSizes[leftInner->count + 1 + i] = rightInner->childSizes[i];
+            }
+            leftInner->count += rightInner->count + 1;
+            delete rightInner;
+        }
+
+        parent->childSizes[index] += parent->childSizes[index + 1];
+        removeAt(parent->keys, parent->count, index);
+        removeAt(parent->children, parent->count + 1, index + 1);
+        removeAt(parent->childSizes, parent->count + 1, index + 1);
+        parent->count--;
+    }
+};
\ No newline at end of file
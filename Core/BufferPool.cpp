@@ -0,0 +1,136 @@
+#include "BufferPool.h"
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+BufferPool::BufferPool(const string& filePath, size_t capacity)
+    : filePath(filePath),
+    capacity(max<size_t>(capacity, 1)),
+    pageCount(0)
+{
+    this->file.open(this->filePath, ios::binary);
+    if (!this->file.is_open())
+    {
+        throw runtime_error("Не вдалося відкрити файл сторінок " + this->filePath);
+    }
+
+    this->file.seekg(0, ios::end);
+    this->pageCount = static_cast<uint64_t>(this->file.tellg()) / PAGE_SIZE;
+    this->frames.reserve(this->capacity);
+    this->stats.capacity = this->capacity;
+}
+
+const char* BufferPool::Pin(uint64_t pageId)
+{
+    lock_guard<mutex> lock(this->poolMutex);
+
+    auto it = this->pageTable.find(pageId);
+    if (it != this->pageTable.end())
+    {
+        this->stats.hits++;
+        Frame& frame = this->frames[it->second];
+        if (frame.pinCount++ == 0)
+        {
+            auto position = this->lruPositions.find(it->second);
+            this->lruQueue.erase(position->second);
+            this->lruPositions.erase(position);
+        }
+        return frame.data.data();
+    }
+
+    if (pageId >= this->pageCount)
+    {
+        throw runtime_error("Сторінка " + to_string(pageId) + " за межами файлу");
+    }
+
+    this->stats.misses++;
+    size_t frameIndex = this->acquireFrame();
+    Frame& frame = this->frames[frameIndex];
+    try
+    {
+        this->readPage(pageId, frame.data.data());
+    }
+    catch (...)
+    {
+        // Витіснену сторінку кадр уже не містить: без повернення до
+        // вільних він випав би з кешу назавжди.
+        this->freeFrames.push_back(frameIndex);
+        throw;
+    }
+
+    frame.pageId = pageId;
+    frame.pinCount = 1;
+    this->pageTable[pageId] = frameIndex;
+    return frame.data.data();
+}
+
+void BufferPool::Unpin(uint64_t pageId)
+{
+    lock_guard<mutex> lock(this->poolMutex);
+
+    auto it = this->pageTable.find(pageId);
+    if (it == this->pageTable.end()) return;
+
+    Frame& frame = this->frames[it->second];
+    if (frame.pinCount > 0 && --frame.pinCount == 0)
+    {
+        this->lruPositions[it->second] =
+            this->lruQueue.insert(this->lruQueue.end(), it->second);
+    }
+}
+
+uint64_t BufferPool::GetPageCount() const
+{
+    lock_guard<mutex> lock(this->poolMutex);
+    return this->pageCount;
+}
+
+BufferPool::Stats BufferPool::GetStats() const
+{
+    lock_guard<mutex> lock(this->poolMutex);
+    Stats snapshot = this->stats;
+    snapshot.residentPages = this->pageTable.size();
+    return snapshot;
+}
+
+size_t BufferPool::acquireFrame()
+{
+    if (!this->freeFrames.empty())
+    {
+        size_t frameIndex = this->freeFrames.back();
+        this->freeFrames.pop_back();
+        return frameIndex;
+    }
+
+    if (this->frames.size() < this->capacity)
+    {
+        this->frames.emplace_back();
+        this->frames.back().data.assign(PAGE_SIZE, 0);
+        return this->frames.size() - 1;
+    }
+
+    if (this->lruQueue.empty())
+    {
+        throw runtime_error("Усі сторінки кешу закріплені");
+    }
+
+    size_t frameIndex = this->lruQueue.front();
+    Frame& victim = this->frames[frameIndex];
+    this->lruQueue.pop_front();
+    this->lruPositions.erase(frameIndex);
+    this->pageTable.erase(victim.pageId);
+    this->stats.evictions++;
+    return frameIndex;
+}
+
+void BufferPool::readPage(uint64_t pageId, char* buffer)
+{
+    this->file.clear();
+    this->file.seekg(static_cast<streamoff>(pageId * PAGE_SIZE));
+    this->file.read(buffer, PAGE_SIZE);
+    if (this->file.gcount() != static_cast<streamsize>(PAGE_SIZE))
+    {
+        throw runtime_error("Не вдалося прочитати сторінку " + to_string(pageId));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <fstream>
+#include <mutex>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class BufferPool
+  * @brief Кеш сторінок файлу фіксованого розміру з витісненням LRU (лише читання).
+  *
+  * У пам'яті тримається не більше capacity сторінок. Сторінка, до якої
+  * звертаються, "закріплюється" (Pin) і не може бути витіснена, доки її
+  * не відкріплять (Unpin). Файл відкривається лише для читання: сторінки
+  * не змінюються, тож витіснення нічого не записує.
+  */
+class BufferPool
+{
+public:
+    static const size_t PAGE_SIZE = 4096;
+
+    /**
+     * @struct Stats
+     * @brief Лічильники роботи кешу.
+     */
+    struct Stats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t capacity = 0;
+        size_t residentPages = 0;
+    };
+
+private:
+    /**
+     * @brief Кадр кешу: одна сторінка в пам'яті.
+     */
+    struct Frame
+    {
+        uint64_t pageId = 0;
+        vector<char> data;
+        int pinCount = 0;
+    };
+
+    string filePath;
+    ifstream file;
+    size_t capacity;
+    uint64_t pageCount;
+
+    // Кадри, що не закріплені, стоять у черзі LRU: спереду - найдавніше використані.
+    // Кадри без сторінки (читання якої не вдалося) чекають у freeFrames.
+    vector<Frame> frames;
+    vector<size_t> freeFrames;
+    unordered_map<uint64_t, size_t> pageTable;
+    list<size_t> lruQueue;
+    unordered_map<size_t, list<size_t>::iterator> lruPositions;
+
+    Stats stats;
+    mutable mutex poolMutex;
+
+public:
+    /**
+     * @brief Конструктор. Відкриває файл сторінок для читання.
+     * @param filePath Шлях до файлу сторінок.
+     * @param capacity Максимальна кількість сторінок у пам'яті (не менше 1).
+     * @throws runtime_error, якщо файл не вдалося відкрити.
+     */
+    BufferPool(const string& filePath, size_t capacity);
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Закріплює сторінку в пам'яті, за потреби читаючи її з диска.
+     * @param pageId Номер сторінки.
+     * @return Вказівник на PAGE_SIZE байтів сторінки (дійсний до Unpin).
+     * @throws runtime_error, якщо всі кадри закріплені або сторінки немає.
+     */
+    const char* Pin(uint64_t pageId);
+
+    /**
+     * @brief Відкріплює сторінку.
+     * @param pageId Номер сторінки.
+     */
+    void Unpin(uint64_t pageId);
+
+    /**
+     * @brief Кількість сторінок у файлі.
+     */
+    uint64_t GetPageCount() const;
+
+    /**
+     * @brief Знімок лічильників кешу.
+     */
+    Stats GetStats() const;
+
+private:
+    /**
+     * @brief Знаходить кадр для нової сторінки (вільний, ще не використаний або витіснений).
+     */
+    size_t acquireFrame();
+
+    void readPage(uint64_t pageId, char* buffer);
+};
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "ConsoleBuffer.h"
+
+using namespace std;
+
+ConsoleBuffer::ConsoleBuffer(ostream& output, size_t flushThreshold)
+    : output(output), flushThreshold(flushThreshold)
+{
+    // Запас над порогом: останній рядок перед скиданням не перевиділяє буфер.
+    this->buffer.reserve(flushThreshold + flushThreshold / 4);
+}
+
+ConsoleBuffer::~ConsoleBuffer()
+{
+    this->Flush();
+}
+
+void ConsoleBuffer::Flush()
+{
+    if (this->buffer.empty()) return;
+
+    this->output.write(this->buffer.data(), static_cast<streamsize>(this->buffer.size()));
+    this->output.flush();
+    this->buffer.clear();
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+#include <iostream>
+
+using namespace std;
+
+ /**
+  * @class ConsoleBuffer
+  * @brief Буфер виводу в консоль, що скидається великими блоками.
+  *
+  * Рядки дописуються у звичайний string, а в потік потрапляють одним
+  * write(), коли набирається flushThreshold байт. Термінал отримує кілька
+  * великих записів замість окремого запису на кожен рядок і кожен
+  * оператор <<. Місткість буфера зберігається між викликами, тож при
+  * повторному використанні пам'ять не виділяється заново.
+  */
+class ConsoleBuffer
+{
+public:
+    static const size_t DEFAULT_FLUSH_THRESHOLD = 64 * 1024;
+
+private:
+    ostream& output;
+    string buffer;
+    size_t flushThreshold;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param output Потік, у який скидається буфер.
+     * @param flushThreshold Розмір, після якого буфер скидається.
+     */
+    explicit ConsoleBuffer(ostream& output = cout,
+        size_t flushThreshold = DEFAULT_FLUSH_THRESHOLD);
+
+    ConsoleBuffer(const ConsoleBuffer&) = delete;
+    ConsoleBuffer& operator=(const ConsoleBuffer&) = delete;
+
+    /**
+     * @brief Деструктор. Скидає залишок буфера.
+     */
+    ~ConsoleBuffer();
+
+    /**
+     * @brief Рядок, у кінець якого дописується текст.
+     */
+    string& GetBuffer() { return this->buffer; }
+
+    /**
+     * @brief Скидає буфер, якщо в ньому набралося flushThreshold байт.
+     */
+    void FlushIfFull()
+    {
+        if (this->buffer.size() >= this->flushThreshold) this->Flush();
+    }
+
+    /**
+     * @brief Записує вміст буфера в потік і очищує його.
+     */
+    void Flush();
+};
\ No newline at end of file
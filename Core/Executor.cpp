@@ -0,0 +1,23 @@
+#include "Executor.h"
+
+using namespace std;
+
+Executor::Executor(size_t workerCount)
+    : pool(workerCount)
+{
+}
+
+Executor::ScheduleAwaiter Executor::Schedule()
+{
+    return ScheduleAwaiter{ this };
+}
+
+void Executor::Post(function<void()> task)
+{
+    this->pool.Submit(move(task));
+}
+
+void Executor::Shutdown()
+{
+    this->pool.Shutdown();
+}
\ No newline at end of file
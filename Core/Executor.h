@@ -0,0 +1,60 @@
+#pragma once
+#include "WorkerPool.h"
+#include <coroutine>
+#include <functional>
+
+using namespace std;
+
+ /**
+  * @class Executor
+  * @brief Невеликий виконавець для корутин поверх WorkerPool.
+  *
+  * "co_await executor.Schedule()" переносить подальше виконання
+  * корутини в один із робочих потоків.
+  */
+class Executor
+{
+private:
+    WorkerPool pool;
+
+public:
+    /**
+     * @brief Awaiter, що відновлює корутину в робочому потоці.
+     */
+    struct ScheduleAwaiter
+    {
+        Executor* executor;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(coroutine_handle<> handle) const
+        {
+            this->executor->Post([handle] { handle.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Конструктор.
+     * @param workerCount Кількість потоків (0 - за кількістю ядер).
+     */
+    explicit Executor(size_t workerCount);
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Повертає awaiter для переходу в робочий потік.
+     */
+    ScheduleAwaiter Schedule();
+
+    /**
+     * @brief Ставить звичайну функцію в чергу виконання.
+     * @param task Функція для виконання.
+     */
+    void Post(function<void()> task);
+
+    /**
+     * @brief Дочікується задач у черзі та зупиняє потоки.
+     */
+    void Shutdown();
+};
\ No newline at end of file
@@ -0,0 +1,406 @@
+#include "LoadGenerator.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <stdexcept>
+#include <memory>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    typedef chrono::steady_clock Clock;
+
+#ifdef _WIN32
+    typedef SOCKET NativeSocket;
+    const NativeSocket NO_SOCKET = INVALID_SOCKET;
+
+    void closeNativeSocket(NativeSocket socket) { closesocket(socket); }
+#else
+    typedef int NativeSocket;
+    const NativeSocket NO_SOCKET = -1;
+
+    void closeNativeSocket(NativeSocket socket) { close(socket); }
+#endif
+
+    /**
+     * @brief Блокуюче клієнтське з'єднання з построковим читанням.
+     */
+    class ClientConnection
+    {
+    private:
+        NativeSocket socket;
+        string buffer;
+        size_t bufferPos;
+
+    public:
+        ClientConnection(const string& host, unsigned short port)
+            : socket(NO_SOCKET), bufferPos(0)
+        {
+            this->socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (this->socket == NO_SOCKET)
+            {
+                throw runtime_error("Не вдалося створити сокет.");
+            }
+
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1 ||
+                connect(this->socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                closeNativeSocket(this->socket);
+                throw runtime_error("Не вдалося підключитися до " + host + ":" + to_string(port));
+            }
+
+            int noDelay = 1;
+            setsockopt(this->socket, IPPROTO_TCP, TCP_NODELAY,
+                reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+        }
+
+        ~ClientConnection() { closeNativeSocket(this->socket); }
+
+        ClientConnection(const ClientConnection&) = delete;
+        ClientConnection& operator=(const ClientConnection&) = delete;
+
+        void Send(const string& data)
+        {
+            size_t sent = 0;
+            while (sent < data.size())
+            {
+                int n = static_cast<int>(send(this->socket, data.data() + sent,
+                    static_cast<int>(data.size() - sent), 0));
+                if (n <= 0) throw runtime_error("З'єднання розірвано під час надсилання.");
+                sent += static_cast<size_t>(n);
+            }
+        }
+
+        string ReadLine()
+        {
+            while (true)
+            {
+                size_t end = this->buffer.find('\n', this->bufferPos);
+                if (end != string::npos)
+                {
+                    string line = this->buffer.substr(this->bufferPos, end - this->bufferPos);
+                    this->bufferPos = end + 1;
+                    return line;
+                }
+
+                this->buffer.erase(0, this->bufferPos);
+                this->bufferPos = 0;
+
+                char chunk[16 * 1024];
+                int n = static_cast<int>(recv(this->socket, chunk, static_cast<int>(sizeof(chunk)), 0));
+                if (n <= 0) throw runtime_error("З'єднання розірвано під час читання.");
+                this->buffer.append(chunk, static_cast<size_t>(n));
+            }
+        }
+    };
+
+    const string RESP_TRY_LATER = "ERR TRY_LATER";
+    const string RESP_RATE_LIMITED = "ERR RATE_LIMITED";
+    const chrono::milliseconds RETRY_DELAY(1);
+
+    /**
+     * @brief Надсилає LOGIN, повторюючи його, поки сервер відповідає
+     * TRY_LATER або RATE_LIMITED.
+     * @return Остаточна відповідь сервера.
+     */
+    string loginWithRetry(ClientConnection& connection, const string& username, const string& password)
+    {
+        string request = "LOGIN " + username + " " + password + "\n";
+        while (true)
+        {
+            connection.Send(request);
+            string response = connection.ReadLine();
+            if (response != RESP_TRY_LATER && response != RESP_RATE_LIMITED) return response;
+            this_thread::sleep_for(RETRY_DELAY);
+        }
+    }
+
+    double percentile(const vector<double>& sorted, double fraction)
+    {
+        if (sorted.empty()) return 0.0;
+        size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[min(index, sorted.size() - 1)];
+    }
+
+    void printLatencies(const vector<double>& sorted)
+    {
+        cout << "Затримка, мкс: p50=" << percentile(sorted, 0.50)
+            << " p90=" << percentile(sorted, 0.90)
+            << " p99=" << percentile(sorted, 0.99)
+            << " max=" << (sorted.empty() ? 0.0 : sorted.back()) << "\n";
+    }
+}
+
+LoadGenerator::LoadGenerator(const Options& options)
+    : options(options)
+{
+    if (this->options.connections == 0) this->options.connections = 1;
+    if (this->options.pipelineDepth == 0) this->options.pipelineDepth = 1;
+}
+
+bool LoadGenerator::Run()
+{
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        cerr << "Помилка: Не вдалося ініціалізувати Winsock.\n";
+        return false;
+    }
+#endif
+
+    vector<string> articles = this->fetchArticles();
+    if (articles.empty())
+    {
+        cerr << "Помилка: Сервер недоступний або каталог порожній.\n";
+        return false;
+    }
+
+    cout << "Навантаження: " << this->options.connections << " з'єднань x "
+        << this->options.requestsPerConnection << " запитів, глибина конвеєра "
+        << this->options.pipelineDepth << ", змін " << this->options.writePercent << "%"
+        << ", з'єднань входу " << this->options.loginConnections << ".\n";
+
+    vector<vector<double>> latencies(this->options.connections);
+    vector<size_t> errors(this->options.connections, 0);
+    vector<thread> threads;
+
+    atomic<size_t> ready(0);
+
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < this->options.connections; i++)
+    {
+        threads.emplace_back([this, &articles, &latencies, &errors, &ready, i]
+            {
+                try
+                {
+                    this->runConnection(articles, static_cast<uint32_t>(i + 1),
+                        latencies[i], errors[i], ready);
+                }
+                catch (const exception& e)
+                {
+                    cerr << "Помилка з'єднання " << i << ": " << e.what() << "\n";
+                }
+            });
+    }
+
+    // Хвиля входів починається, коли всі з'єднання каталогу вже увійшли:
+    // інакше обмеження частоти входів не пустило б і їх.
+    while (ready < this->options.connections)
+    {
+        this_thread::sleep_for(RETRY_DELAY);
+    }
+
+    atomic<bool> done(false);
+    vector<vector<double>> loginLatencies(this->options.loginConnections);
+    vector<size_t> loginRejected(this->options.loginConnections, 0);
+    vector<size_t> loginLimited(this->options.loginConnections, 0);
+    vector<size_t> loginErrors(this->options.loginConnections, 0);
+    vector<thread> loginThreads;
+    for (size_t i = 0; i < this->options.loginConnections; i++)
+    {
+        loginThreads.emplace_back([this, &done, &loginLatencies, &loginRejected, &loginLimited, &loginErrors, i]
+            {
+                try
+                {
+                    this->runLoginConnection(done, loginLatencies[i],
+                        loginRejected[i], loginLimited[i], loginErrors[i]);
+                }
+                catch (const exception& e)
+                {
+                    cerr << "Помилка з'єднання входу " << i << ": " << e.what() << "\n";
+                }
+            });
+    }
+
+    for (thread& t : threads) t.join();
+    double elapsedSec = chrono::duration<double>(Clock::now() - start).count();
+
+    done = true;
+    for (thread& t : loginThreads) t.join();
+
+    vector<double> all;
+    size_t totalErrors = 0;
+    for (size_t i = 0; i < this->options.connections; i++)
+    {
+        all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+        totalErrors += errors[i];
+    }
+    sort(all.begin(), all.end());
+
+    cout << fixed << setprecision(1);
+    cout << "Виконано запитів: " << all.size() << " за " << elapsedSec << " с"
+        << " (відповідей ERR: " << totalErrors << ")\n";
+    cout << "Пропускна здатність: " << (elapsedSec > 0 ? all.size() / elapsedSec : 0.0) << " запитів/с\n";
+    printLatencies(all);
+
+    if (this->options.loginConnections > 0)
+    {
+        vector<double> logins;
+        size_t rejected = 0;
+        size_t limited = 0;
+        size_t failed = 0;
+        for (size_t i = 0; i < this->options.loginConnections; i++)
+        {
+            logins.insert(logins.end(), loginLatencies[i].begin(), loginLatencies[i].end());
+            rejected += loginRejected[i];
+            limited += loginLimited[i];
+            failed += loginErrors[i];
+        }
+        sort(logins.begin(), logins.end());
+
+        cout << "Входів: " << logins.size() << " (" << (elapsedSec > 0 ? logins.size() / elapsedSec : 0.0)
+            << "/с), відхилено TRY_LATER: " << rejected << ", RATE_LIMITED: " << limited
+            << ", інших ERR: " << failed << "\n";
+        printLatencies(logins);
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return !all.empty();
+}
+
+vector<string> LoadGenerator::fetchArticles() const
+{
+    vector<string> articles;
+    try
+    {
+        ClientConnection connection(this->options.host, this->options.port);
+        if (loginWithRetry(connection, this->options.username, this->options.password).rfind("OK", 0) != 0)
+        {
+            return articles;
+        }
+        connection.Send("LIST\n");
+
+        string header = connection.ReadLine();
+        if (header.rfind("OK ", 0) != 0) return articles;
+
+        size_t count = stoul(header.substr(3));
+        articles.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            string row = connection.ReadLine();
+            articles.push_back(row.substr(0, row.find(',')));
+        }
+        connection.Send("QUIT\n");
+    }
+    catch (const exception& e)
+    {
+        cerr << "Помилка: " << e.what() << "\n";
+    }
+    return articles;
+}
+
+void LoadGenerator::runConnection(const vector<string>& articles, uint32_t seed,
+    vector<double>& latencies, size_t& errors, atomic<size_t>& ready) const
+{
+    string loginResponse;
+    unique_ptr<ClientConnection> connection;
+    try
+    {
+        connection = make_unique<ClientConnection>(this->options.host, this->options.port);
+        loginResponse = loginWithRetry(*connection, this->options.username, this->options.password);
+    }
+    catch (...)
+    {
+        ready++;
+        throw;
+    }
+    ready++;
+
+    if (loginResponse.rfind("OK", 0) != 0)
+    {
+        throw runtime_error("Невірні облікові дані для навантаження.");
+    }
+
+    mt19937 random(seed);
+    uniform_int_distribution<size_t> pickArticle(0, articles.size() - 1);
+    uniform_int_distribution<int> pickPercent(0, 99);
+
+    latencies.reserve(this->options.requestsPerConnection);
+    size_t remaining = this->options.requestsPerConnection;
+    string frame;
+
+    while (remaining > 0)
+    {
+        size_t batch = min(remaining, this->options.pipelineDepth);
+        frame.clear();
+        for (size_t i = 0; i < batch; i++)
+        {
+            const string& article = articles[pickArticle(random)];
+            if (pickPercent(random) < this->options.writePercent)
+            {
+                frame += (random() & 1) ? "ISSUE " : "RETURN ";
+            }
+            else
+            {
+                frame += "FIND ";
+            }
+            frame += article;
+            frame += '\n';
+        }
+
+        Clock::time_point sentAt = Clock::now();
+        connection->Send(frame);
+
+        for (size_t i = 0; i < batch; i++)
+        {
+            string response = connection->ReadLine();
+            latencies.push_back(chrono::duration<double, micro>(Clock::now() - sentAt).count());
+            if (response.rfind("ERR", 0) == 0) errors++;
+        }
+        remaining -= batch;
+    }
+
+    connection->Send("QUIT\n");
+}
+void LoadGenerator::runLoginConnection(const atomic<bool>& done,
+    vector<double>& latencies, size_t& rejected, size_t& limited, size_t& errors) const
+{
+    ClientConnection connection(this->options.host, this->options.port);
+    string request = "LOGIN " + this->options.username + " " + this->options.password + "\n";
+
+    while (!done)
+    {
+        Clock::time_point sentAt = Clock::now();
+        connection.Send(request);
+        string response = connection.ReadLine();
+
+        if (response == RESP_RATE_LIMITED)
+        {
+            limited++;
+            this_thread::sleep_for(RETRY_DELAY);
+            continue;
+        }
+        if (response == RESP_TRY_LATER)
+        {
+            rejected++;
+            this_thread::sleep_for(RETRY_DELAY);
+            continue;
+        }
+        latencies.push_back(chrono::duration<double, micro>(Clock::now() - sentAt).count());
+        if (response.rfind("ERR", 0) == 0) errors++;
+    }
+
+    connection.Send("QUIT\n");
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class LoadGenerator
+  * @brief Генератор навантаження для QueryServer.
+  *
+  * Відкриває кілька з'єднань, у кожному надсилає запити пачками
+  * (pipelining) і вимірює затримку кожного запиту від надсилання пачки
+  * до отримання відповіді. Наприкінці друкує пропускну здатність
+  * та перцентилі затримки (p50/p90/p99).
+  *
+  * Додаткові з'єднання входу (після того, як з'єднання каталогу
+  * увійшли) весь цей час без пауз надсилають LOGIN,
+  * імітуючи хвилю входів: звіт показує затримку входу окремо, а
+  * затримка запитів до каталогу - чи не страждають вони від неї.
+  */
+class LoadGenerator
+{
+public:
+    /**
+     * @struct Options
+     * @brief Параметри прогону.
+     */
+    struct Options
+    {
+        string host = "127.0.0.1";
+        unsigned short port = 7070;
+        size_t connections = 8;
+        size_t requestsPerConnection = 10000;
+        size_t pipelineDepth = 16;
+        int writePercent = 0;
+        size_t loginConnections = 0;
+        string username = "admin";
+        string password = "admin123";
+    };
+
+private:
+    Options options;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param options Параметри прогону.
+     */
+    explicit LoadGenerator(const Options& options);
+
+    /**
+     * @brief Виконує прогін і друкує звіт у консоль.
+     * @return true, якщо вдалося підключитися та виконати запити.
+     */
+    bool Run();
+
+private:
+    /**
+     * @brief Отримує список артикулів каталогу через команду LIST.
+     * @return Артикули (порожньо, якщо сервер недоступний).
+     */
+    vector<string> fetchArticles() const;
+
+    /**
+     * @brief Навантаження одного з'єднання.
+     * @param articles Артикули, з яких випадково обираються ключі.
+     * @param seed Зерно генератора випадкових чисел.
+     * @param latencies Сюди додаються затримки запитів (мкс).
+     * @param errors Лічильник відповідей "ERR".
+     * @param ready Збільшується, щойно з'єднання увійшло (або не змогло).
+     */
+    void runConnection(const vector<string>& articles, uint32_t seed,
+        vector<double>& latencies, size_t& errors, atomic<size_t>& ready) const;
+
+    /**
+     * @brief Повторює LOGIN в одному з'єднанні, доки не встановлено done.
+     * @param done Ознака завершення навантаження на каталог.
+     * @param latencies Сюди додаються затримки прийнятих входів (мкс).
+     * @param rejected Лічильник відповідей "ERR TRY_LATER".
+     * @param limited Лічильник відповідей "ERR RATE_LIMITED".
+     * @param errors Лічильник інших відповідей "ERR".
+     */
+    void runLoginConnection(const atomic<bool>& done, vector<double>& latencies,
+        size_t& rejected, size_t& limited, size_t& errors) const;
+};
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+ /**
+  * @class LoadStatus
+  * @brief Стан фонового завантаження даних (не почато / триває / завершено /
+  * перервано помилкою).
+  *
+  * Дозволяє іншим потокам дочекатися кінця завантаження. Якщо
+  * завантаження не починалося, Wait() не блокує. Дані у стані Failed
+  * неповні, тож зберігати їх поверх файлу не можна.
+  */
+class LoadStatus
+{
+public:
+    enum class State
+    {
+        NotLoaded,
+        Loading,
+        Loaded,
+        Failed
+    };
+
+private:
+    mutable mutex stateMutex;
+    mutable condition_variable stateCondition;
+    State state;
+
+public:
+    explicit LoadStatus(State initial = State::NotLoaded) : state(initial) {}
+
+    /**
+     * @brief Позначає початок завантаження.
+     */
+    void Begin()
+    {
+        lock_guard<mutex> lock(this->stateMutex);
+        this->state = State::Loading;
+    }
+
+    /**
+     * @brief Позначає кінець завантаження та будить тих, хто чекає.
+     */
+    void Finish()
+    {
+        this->complete(State::Loaded);
+    }
+
+    /**
+     * @brief Позначає, що завантаження перервала помилка, та будить тих, хто чекає.
+     */
+    void Fail()
+    {
+        this->complete(State::Failed);
+    }
+
+    /**
+     * @brief Чекає, поки триває завантаження.
+     */
+    void Wait() const
+    {
+        unique_lock<mutex> lock(this->stateMutex);
+        this->stateCondition.wait(lock, [this] { return this->state != State::Loading; });
+    }
+
+    State Get() const
+    {
+        lock_guard<mutex> lock(this->stateMutex);
+        return this->state;
+    }
+
+private:
+    void complete(State finalState)
+    {
+        {
+            lock_guard<mutex> lock(this->stateMutex);
+            this->state = finalState;
+        }
+        this->stateCondition.notify_all();
+    }
+};
\ No newline at end of file
@@ -1,28 +1,140 @@
 #include "Application.h"
+#include "LoadGenerator.h"
 #include <iostream>
 #include <exception>
+#include <string>
+
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 using namespace std;
 
-int main()
+namespace
 {
+    const string SERVER_FLAG = "--server";
+    const string LOADGEN_FLAG = "--loadgen";
+    const string PAGED_FLAG = "--paged";
+    const string BATCH_FLAG = "--batch";
+    const string STDIN_PATH = "-";
+    const unsigned short DEFAULT_SERVER_PORT = 7070;
+    const size_t DEFAULT_CACHE_PAGES = 256;
+
+    /**
+     * @brief Перенаправляє буфер потоку на час існування об'єкта й
+     * повертає попередній навіть тоді, коли виконання перервав виняток.
+     */
+    class StreamRedirect
+    {
+    private:
+        ostream& stream;
+        streambuf* previous;
+
+    public:
+        StreamRedirect(ostream& stream, streambuf* target)
+            : stream(stream), previous(stream.rdbuf(target))
+        {
+        }
+
+        ~StreamRedirect()
+        {
+            this->stream.rdbuf(this->previous);
+        }
+
+        StreamRedirect(const StreamRedirect&) = delete;
+        StreamRedirect& operator=(const StreamRedirect&) = delete;
+    };
+}
+
+/**
+ * Використання:
+ *   LibraryApp                              - консольне меню
+ *   LibraryApp --server [порт] [потоки]     - мережевий сервер
+ *   LibraryApp --loadgen [порт] [з'єднання] [запити] [конвеєр] [% змін] [з'єднань входу]
+ *                                           - навантаження на запущений сервер
+ *   LibraryApp --paged [сторінок кешу]      - пошук без завантаження каталогу в пам'ять
+ *   LibraryApp --batch [файл команд | -]    - команди без меню (зі стандартного вводу за замовчуванням)
+ */
+int main(int argc, char* argv[])
+{
+#ifdef _WIN32
     SetConsoleCP(1251);
     SetConsoleOutputCP(1251);
 
+    // UIManager очищує екран ANSI-послідовністю, тож у консолі Windows
+    // їх обробку треба ввімкнути.
+    HANDLE consoleOutput = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD consoleMode = 0;
+    if (GetConsoleMode(consoleOutput, &consoleMode))
+    {
+        SetConsoleMode(consoleOutput, consoleMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#endif
+
     try
     {
+        if (argc > 1 && argv[1] == LOADGEN_FLAG)
+        {
+            LoadGenerator::Options options;
+            if (argc > 2) options.port = static_cast<unsigned short>(stoi(argv[2]));
+            if (argc > 3) options.connections = stoul(argv[3]);
+            if (argc > 4) options.requestsPerConnection = stoul(argv[4]);
+            if (argc > 5) options.pipelineDepth = stoul(argv[5]);
+            if (argc > 6) options.writePercent = stoi(argv[6]);
+            if (argc > 7) options.loginConnections = stoul(argv[7]);
+
+            LoadGenerator generator(options);
+            return generator.Run() ? 0 : 1;
+        }
+
+        if (argc > 1 && argv[1] == PAGED_FLAG)
+        {
+            size_t cachePages = (argc > 2) ? stoul(argv[2]) : DEFAULT_CACHE_PAGES;
+            Application::RunPagedLookup(cachePages);
+            return 0;
+        }
+
+        if (argc > 1 && argv[1] == BATCH_FLAG)
+        {
+            // У stdout ідуть лише результати команд, а повідомлення
+            // менеджерів перенаправляються в stderr, щоб вивід можна
+            // було розбирати скриптом.
+            ostream results(cout.rdbuf());
+            StreamRedirect redirect(cout, cerr.rdbuf());
+
+            string scriptPath = (argc > 2 && argv[2] != STDIN_PATH) ? argv[2] : "";
+            size_t failed;
+            {
+                Application batchApp;
+                failed = batchApp.RunBatch(scriptPath, results);
+            }
+            return failed == 0 ? 0 : 1;
+        }
+
         Application app;
-        app.Run();
+
+        if (argc > 1 && argv[1] == SERVER_FLAG)
+        {
+            unsigned short port = (argc > 2)
+                ? static_cast<unsigned short>(stoi(argv[2]))
+                : DEFAULT_SERVER_PORT;
+            size_t workers = (argc > 3) ? stoul(argv[3]) : 0;
+
+            app.RunServer(port, workers);
+        }
+        else
+        {
+            app.Run();
+        }
     }
     catch (const std::exception& e)
     {
-        cerr << " : " << e.what() << "\n";
+        cerr << "КРИТИЧНА ПОМИЛКА: " << e.what() << "\n";
         return 1;
     }
     catch (...)
     {
-        cerr << "   .\n";
+        cerr << "Виникла невідома критична помилка.\n";
         return 2;
     }
 
@@ -0,0 +1,354 @@
+#include "PasswordHasher.h"
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+using namespace std;
+
+namespace
+{
+    const string HASH_PREFIX = "pbkdf2-sha256";
+    const char HASH_SEPARATOR = '$';
+    const size_t SALT_SIZE = 16;
+    const size_t DIGEST_SIZE = 32;
+    const size_t BLOCK_SIZE = 64;
+    const char HEX_DIGITS[] = "0123456789abcdef";
+
+    const uint32_t ROUND_CONSTANTS[64] =
+    {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    typedef array<uint8_t, DIGEST_SIZE> Digest;
+
+    uint32_t rotateRight(uint32_t value, int bits)
+    {
+        return (value >> bits) | (value << (32 - bits));
+    }
+
+    /**
+     * @brief Потокове обчислення SHA-256 (FIPS 180-4).
+     */
+    class Sha256
+    {
+    private:
+        uint32_t state[8];
+        uint8_t block[BLOCK_SIZE];
+        size_t blockLength;
+        uint64_t totalLength;
+
+    public:
+        Sha256()
+            : state{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 },
+            block{},
+            blockLength(0),
+            totalLength(0)
+        {
+        }
+
+        void Update(const uint8_t* data, size_t length)
+        {
+            this->totalLength += length;
+            while (length > 0)
+            {
+                size_t chunk = min(length, BLOCK_SIZE - this->blockLength);
+                memcpy(this->block + this->blockLength, data, chunk);
+                this->blockLength += chunk;
+                data += chunk;
+                length -= chunk;
+
+                if (this->blockLength == BLOCK_SIZE)
+                {
+                    this->compress();
+                    this->blockLength = 0;
+                }
+            }
+        }
+
+        Digest Final()
+        {
+            uint64_t bitLength = this->totalLength * 8;
+
+            this->block[this->blockLength++] = 0x80;
+            if (this->blockLength > BLOCK_SIZE - 8)
+            {
+                memset(this->block + this->blockLength, 0, BLOCK_SIZE - this->blockLength);
+                this->compress();
+                this->blockLength = 0;
+            }
+            memset(this->block + this->blockLength, 0, BLOCK_SIZE - 8 - this->blockLength);
+            for (int i = 0; i < 8; i++)
+            {
+                this->block[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bitLength >> (8 * i));
+            }
+            this->compress();
+
+            Digest digest;
+            for (int i = 0; i < 8; i++)
+            {
+                digest[4 * i] = static_cast<uint8_t>(this->state[i] >> 24);
+                digest[4 * i + 1] = static_cast<uint8_t>(this->state[i] >> 16);
+                digest[4 * i + 2] = static_cast<uint8_t>(this->state[i] >> 8);
+                digest[4 * i + 3] = static_cast<uint8_t>(this->state[i]);
+            }
+            return digest;
+        }
+
+    private:
+        void compress()
+        {
+            uint32_t w[64];
+            for (int i = 0; i < 16; i++)
+            {
+                w[i] = (uint32_t(this->block[4 * i]) << 24) | (uint32_t(this->block[4 * i + 1]) << 16) |
+                    (uint32_t(this->block[4 * i + 2]) << 8) | uint32_t(this->block[4 * i + 3]);
+            }
+            for (int i = 16; i < 64; i++)
+            {
+                uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            uint32_t a = this->state[0], b = this->state[1], c = this->state[2], d = this->state[3];
+            uint32_t e = this->state[4], f = this->state[5], g = this->state[6], h = this->state[7];
+            for (int i = 0; i < 64; i++)
+            {
+                uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+                uint32_t choice = (e & f) ^ (~e & g);
+                uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+                uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+                uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+                uint32_t temp2 = s0 + majority;
+
+                h = g;
+                g = f;
+                f = e;
+                e = d + temp1;
+                d = c;
+                c = b;
+                b = a;
+                a = temp1 + temp2;
+            }
+
+            this->state[0] += a; this->state[1] += b; this->state[2] += c; this->state[3] += d;
+            this->state[4] += e; this->state[5] += f; this->state[6] += g; this->state[7] += h;
+        }
+    };
+
+    /**
+     * @brief HMAC-SHA256 із ключем, підготовленим один раз.
+     *
+     * Стани після блоків ipad/opad обчислюються в конструкторі й далі
+     * лише копіюються, тож кожна ітерація PBKDF2 коштує два стиснення
+     * замість чотирьох.
+     */
+    class HmacSha256
+    {
+    private:
+        Sha256 inner;
+        Sha256 outer;
+
+    public:
+        explicit HmacSha256(string_view key)
+        {
+            uint8_t keyBlock[BLOCK_SIZE] = {};
+            if (key.size() > BLOCK_SIZE)
+            {
+                Sha256 keyHash;
+                keyHash.Update(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+                Digest digest = keyHash.Final();
+                memcpy(keyBlock, digest.data(), digest.size());
+            }
+            else
+            {
+                memcpy(keyBlock, key.data(), key.size());
+            }
+
+            uint8_t pad[BLOCK_SIZE];
+            for (size_t i = 0; i < BLOCK_SIZE; i++) pad[i] = keyBlock[i] ^ 0x36;
+            this->inner.Update(pad, BLOCK_SIZE);
+            for (size_t i = 0; i < BLOCK_SIZE; i++) pad[i] = keyBlock[i] ^ 0x5c;
+            this->outer.Update(pad, BLOCK_SIZE);
+        }
+
+        Digest Compute(const uint8_t* data, size_t length) const
+        {
+            Sha256 innerHash = this->inner;
+            innerHash.Update(data, length);
+            Digest innerDigest = innerHash.Final();
+
+            Sha256 outerHash = this->outer;
+            outerHash.Update(innerDigest.data(), innerDigest.size());
+            return outerHash.Final();
+        }
+    };
+
+    /**
+     * @brief Блок T_i функції PBKDF2-HMAC-SHA256 (RFC 8018, розділ 5.2).
+     * @param blockIndex Номер блоку виходу, починаючи з 1.
+     */
+    Digest deriveBlock(const HmacSha256& hmac, const uint8_t* salt, size_t saltLength,
+        uint32_t iterations, uint32_t blockIndex)
+    {
+        vector<uint8_t> firstInput(saltLength + 4);
+        memcpy(firstInput.data(), salt, saltLength);
+        for (size_t i = 0; i < 4; i++)
+        {
+            firstInput[saltLength + i] = static_cast<uint8_t>(blockIndex >> (24 - 8 * i));
+        }
+
+        Digest u = hmac.Compute(firstInput.data(), firstInput.size());
+        Digest result = u;
+        for (uint32_t i = 1; i < iterations; i++)
+        {
+            u = hmac.Compute(u.data(), u.size());
+            for (size_t j = 0; j < result.size(); j++) result[j] ^= u[j];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Хеш для збереження: рівно один блок виходу.
+     */
+    Digest deriveKey(const string& password, const uint8_t* salt, size_t saltLength, uint32_t iterations)
+    {
+        return deriveBlock(HmacSha256(password), salt, saltLength, iterations, 1);
+    }
+
+    string toHex(const uint8_t* data, size_t length)
+    {
+        string hex;
+        hex.reserve(length * 2);
+        for (size_t i = 0; i < length; i++)
+        {
+            hex += HEX_DIGITS[data[i] >> 4];
+            hex += HEX_DIGITS[data[i] & 0x0f];
+        }
+        return hex;
+    }
+
+    bool fromHex(string_view hex, uint8_t* out, size_t length)
+    {
+        if (hex.size() != length * 2) return false;
+        for (size_t i = 0; i < length; i++)
+        {
+            auto result = from_chars(hex.data() + 2 * i, hex.data() + 2 * i + 2, out[i], 16);
+            if (result.ec != errc() || result.ptr != hex.data() + 2 * i + 2) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Порівнює рядки, не виходячи раніше на першій відмінності.
+     */
+    bool constantTimeEquals(string_view a, string_view b)
+    {
+        uint8_t difference = a.size() == b.size() ? 0 : 1;
+        size_t length = min(a.size(), b.size());
+        for (size_t i = 0; i < length; i++)
+        {
+            difference |= static_cast<uint8_t>(a[i] ^ b[i]);
+        }
+        return difference == 0;
+    }
+
+    /**
+     * @brief Розібраний рядок "pbkdf2-sha256$ітерації$сіль$хеш".
+     */
+    struct ParsedHash
+    {
+        uint32_t iterations;
+        uint8_t salt[SALT_SIZE];
+        uint8_t hash[DIGEST_SIZE];
+    };
+
+    bool parseHash(string_view stored, ParsedHash& parsed)
+    {
+        if (stored.substr(0, HASH_PREFIX.size()) != HASH_PREFIX) return false;
+        stored.remove_prefix(HASH_PREFIX.size());
+        if (stored.empty() || stored[0] != HASH_SEPARATOR) return false;
+        stored.remove_prefix(1);
+
+        size_t iterationsEnd = stored.find(HASH_SEPARATOR);
+        if (iterationsEnd == string_view::npos) return false;
+        auto result = from_chars(stored.data(), stored.data() + iterationsEnd, parsed.iterations);
+        if (result.ec != errc() || result.ptr != stored.data() + iterationsEnd || parsed.iterations == 0)
+        {
+            return false;
+        }
+        stored.remove_prefix(iterationsEnd + 1);
+
+        size_t saltEnd = stored.find(HASH_SEPARATOR);
+        if (saltEnd == string_view::npos) return false;
+        return fromHex(stored.substr(0, saltEnd), parsed.salt, SALT_SIZE) &&
+            fromHex(stored.substr(saltEnd + 1), parsed.hash, DIGEST_SIZE);
+    }
+}
+
+string PasswordHasher::Hash(const string& password, uint32_t iterations)
+{
+    if (iterations == 0) iterations = 1;
+
+    uint8_t salt[SALT_SIZE];
+    random_device randomSource;
+    for (size_t i = 0; i < SALT_SIZE; i += sizeof(uint32_t))
+    {
+        uint32_t value = randomSource();
+        memcpy(salt + i, &value, sizeof(value));
+    }
+
+    Digest hash = deriveKey(password, salt, SALT_SIZE, iterations);
+    return HASH_PREFIX + HASH_SEPARATOR + to_string(iterations) + HASH_SEPARATOR
+        + toHex(salt, SALT_SIZE) + HASH_SEPARATOR + toHex(hash.data(), hash.size());
+}
+
+bool PasswordHasher::Verify(const string& password, const string& stored)
+{
+    ParsedHash parsed;
+    if (!parseHash(stored, parsed))
+    {
+        return !IsHash(stored) && constantTimeEquals(password, stored);
+    }
+
+    Digest hash = deriveKey(password, parsed.salt, SALT_SIZE, parsed.iterations);
+    return constantTimeEquals(
+        string_view(reinterpret_cast<const char*>(hash.data()), hash.size()),
+        string_view(reinterpret_cast<const char*>(parsed.hash), DIGEST_SIZE));
+}
+
+string PasswordHasher::DeriveKey(const string& password, const string& salt,
+    uint32_t iterations, size_t length)
+{
+    HmacSha256 hmac(password);
+    const uint8_t* saltBytes = reinterpret_cast<const uint8_t*>(salt.data());
+
+    string key;
+    key.reserve(length);
+    for (uint32_t blockIndex = 1; key.size() < length; blockIndex++)
+    {
+        Digest block = deriveBlock(hmac, saltBytes, salt.size(), max<uint32_t>(iterations, 1), blockIndex);
+        size_t take = min(block.size(), length - key.size());
+        key.append(reinterpret_cast<const char*>(block.data()), take);
+    }
+    return key;
+}
+
+bool PasswordHasher::IsHash(const string& stored)
+{
+    return stored.size() > HASH_PREFIX.size() &&
+        stored.compare(0, HASH_PREFIX.size(), HASH_PREFIX) == 0 &&
+        stored[HASH_PREFIX.size()] == HASH_SEPARATOR;
+}
\ No newline at end of file
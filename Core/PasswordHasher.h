@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class PasswordHasher
+  * @brief Хешування паролів повільною функцією PBKDF2-HMAC-SHA256.
+  *
+  * Пароль зберігається як рядок "pbkdf2-sha256$ітерації$сіль$хеш"
+  * (сіль та хеш - у шістнадцятковому вигляді), тож кількість ітерацій
+  * можна збільшувати, не ламаючи старих записів. Повільність навмисна:
+  * перевірку варто виконувати в окремому обмеженому пулі потоків.
+  */
+class PasswordHasher
+{
+public:
+    /**
+     * @brief Кількість ітерацій для нових хешів.
+     */
+    static const uint32_t DEFAULT_ITERATIONS = 20000;
+
+    /**
+     * @brief Хешує пароль із новою випадковою сіллю.
+     * @param password Пароль у відкритому вигляді.
+     * @param iterations Кількість ітерацій PBKDF2.
+     * @return Рядок для збереження у файлі користувачів.
+     */
+    static string Hash(const string& password, uint32_t iterations = DEFAULT_ITERATIONS);
+
+    /**
+     * @brief Перевіряє пароль за збереженим рядком.
+     *
+     * Рядок, що не є хешем, вважається паролем у відкритому вигляді зі
+     * старого файлу користувачів і порівнюється напряму.
+     * Порівняння виконується за сталий час.
+     */
+    static bool Verify(const string& password, const string& stored);
+
+    /**
+     * @brief PBKDF2-HMAC-SHA256 (RFC 8018) з довільною сіллю та довжиною виходу.
+     * Hash() і Verify() використовують ту саму функцію з 16-байтною сіллю
+     * та 32-байтним виходом.
+     * @param password Пароль.
+     * @param salt Сіль (довільні байти).
+     * @param iterations Кількість ітерацій (0 рахується як 1).
+     * @param length Довжина ключа в байтах.
+     * @return Ключ (сирі байти).
+     */
+    static string DeriveKey(const string& password, const string& salt,
+        uint32_t iterations, size_t length);
+
+    /**
+     * @brief Перевіряє, чи є рядок хешем у форматі Hash().
+     */
+    static bool IsHash(const string& stored);
+};
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "RoaringBitmap.h"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+using namespace std;
+
+bool RoaringBitmap::Add(uint32_t value)
+{
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+    size_t index = this->findContainer(key);
+    if (index == this->containers.size() || this->containers[index].key != key)
+    {
+        Container container;
+        container.key = key;
+        this->containers.insert(this->containers.begin() + index, std::move(container));
+    }
+
+    Container& container = this->containers[index];
+    if (container.IsBitmap())
+    {
+        uint64_t mask = uint64_t(1) << (low % 64);
+        uint64_t& word = container.words[low / 64];
+        if ((word & mask) != 0) return false;
+        word |= mask;
+        container.cardinality++;
+        return true;
+    }
+
+    // Позиції будуються за зростанням, тож зазвичай значення дописується в кінець.
+    auto position = container.values.end();
+    if (!container.values.empty() && container.values.back() >= low)
+    {
+        position = lower_bound(container.values.begin(), container.values.end(), low);
+        if (*position == low) return false;
+    }
+    container.values.insert(position, low);
+    container.cardinality++;
+
+    if (container.cardinality > ARRAY_LIMIT) normalize(container);
+    return true;
+}
+
+bool RoaringBitmap::Remove(uint32_t value)
+{
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+    size_t index = this->findContainer(key);
+    if (index == this->containers.size() || this->containers[index].key != key)
+    {
+        return false;
+    }
+
+    Container& container = this->containers[index];
+    if (container.IsBitmap())
+    {
+        uint64_t mask = uint64_t(1) << (low % 64);
+        uint64_t& word = container.words[low / 64];
+        if ((word & mask) == 0) return false;
+        word &= ~mask;
+        container.cardinality--;
+        if (container.cardinality <= ARRAY_LIMIT) normalize(container);
+    }
+    else
+    {
+        auto position = lower_bound(container.values.begin(), container.values.end(), low);
+        if (position == container.values.end() || *position != low) return false;
+        container.values.erase(position);
+        container.cardinality--;
+    }
+
+    if (container.cardinality == 0)
+    {
+        this->containers.erase(this->containers.begin() + index);
+    }
+    return true;
+}
+
+bool RoaringBitmap::Contains(uint32_t value) const
+{
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+    size_t index = this->findContainer(key);
+    if (index == this->containers.size() || this->containers[index].key != key)
+    {
+        return false;
+    }
+
+    const Container& container = this->containers[index];
+    if (container.IsBitmap())
+    {
+        return (container.words[low / 64] >> (low % 64)) & 1;
+    }
+    return binary_search(container.values.begin(), container.values.end(), low);
+}
+
+size_t RoaringBitmap::Cardinality() const
+{
+    size_t total = 0;
+    for (const Container& container : this->containers)
+    {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+bool RoaringBitmap::IsEmpty() const
+{
+    return this->containers.empty();
+}
+
+void RoaringBitmap::Clear()
+{
+    this->containers.clear();
+}
+
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other)
+{
+    *this = And(*this, other);
+    return *this;
+}
+
+RoaringBitmap RoaringBitmap::And(const RoaringBitmap& left, const RoaringBitmap& right)
+{
+    RoaringBitmap result;
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < left.containers.size() && j < right.containers.size())
+    {
+        uint16_t leftKey = left.containers[i].key;
+        uint16_t rightKey = right.containers[j].key;
+
+        if (leftKey < rightKey)
+        {
+            i++;
+        }
+        else if (rightKey < leftKey)
+        {
+            j++;
+        }
+        else
+        {
+            Container container = intersect(left.containers[i], right.containers[j]);
+            if (container.cardinality > 0)
+            {
+                result.containers.push_back(std::move(container));
+            }
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+vector<uint32_t> RoaringBitmap::ToVector() const
+{
+    vector<uint32_t> values;
+    values.reserve(this->Cardinality());
+    this->ForEach([&values](uint32_t value) { values.push_back(value); });
+    return values;
+}
+
+int RoaringBitmap::countTrailingZeros(uint64_t word)
+{
+    return countr_zero(word);
+}
+
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& left, const Container& right)
+{
+    Container result;
+    result.key = left.key;
+
+    if (left.IsBitmap() && right.IsBitmap())
+    {
+        result.words.resize(BITMAP_WORDS);
+        uint32_t cardinality = 0;
+        for (size_t i = 0; i < BITMAP_WORDS; i++)
+        {
+            result.words[i] = left.words[i] & right.words[i];
+            cardinality += static_cast<uint32_t>(popcount(result.words[i]));
+        }
+        result.cardinality = cardinality;
+        normalize(result);
+        return result;
+    }
+
+    if (left.IsBitmap() || right.IsBitmap())
+    {
+        const Container& sparse = left.IsBitmap() ? right : left;
+        const Container& dense = left.IsBitmap() ? left : right;
+        for (uint16_t low : sparse.values)
+        {
+            if ((dense.words[low / 64] >> (low % 64)) & 1)
+            {
+                result.values.push_back(low);
+            }
+        }
+    }
+    else
+    {
+        set_intersection(left.values.begin(), left.values.end(),
+            right.values.begin(), right.values.end(),
+            back_inserter(result.values));
+    }
+
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    return result;
+}
+
+void RoaringBitmap::normalize(Container& container)
+{
+    if (container.IsBitmap() && container.cardinality <= ARRAY_LIMIT)
+    {
+        vector<uint16_t> values;
+        values.reserve(container.cardinality);
+        for (size_t i = 0; i < BITMAP_WORDS; i++)
+        {
+            uint64_t word = container.words[i];
+            while (word != 0)
+            {
+                values.push_back(static_cast<uint16_t>(i * 64 + countTrailingZeros(word)));
+                word &= word - 1;
+            }
+        }
+        container.values = std::move(values);
+        container.words.clear();
+        container.words.shrink_to_fit();
+    }
+    else if (!container.IsBitmap() && container.cardinality > ARRAY_LIMIT)
+    {
+        container.words.assign(BITMAP_WORDS, 0);
+        for (uint16_t low : container.values)
+        {
+            container.words[low / 64] |= uint64_t(1) << (low % 64);
+        }
+        container.values.clear();
+        container.values.shrink_to_fit();
+    }
+}
+
+size_t RoaringBitmap::findContainer(uint16_t key) const
+{
+    // Найчастіше звертаються до останнього контейнера (дописування позицій).
+    if (!this->containers.empty() && this->containers.back().key == key)
+    {
+        return this->containers.size() - 1;
+    }
+
+    auto it = lower_bound(this->containers.begin(), this->containers.end(), key,
+        [](const Container& container, uint16_t value) { return container.key < value; });
+    return it - this->containers.begin();
+}
\ No newline at end of file
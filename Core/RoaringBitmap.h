@@ -0,0 +1,126 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+ /**
+  * @class RoaringBitmap
+  * @brief Стиснена множина 32-бітних чисел (схема "roaring").
+  *
+  * Простір значень поділено на блоки по 65536: старші 16 біт обирають
+  * контейнер, молодші зберігаються в ньому. Розріджений контейнер - це
+  * відсортований масив 16-бітних значень, щільний - бітова карта з 1024
+  * слів. Перетин щільних контейнерів обчислюється пословно (по 64 біти
+  * за операцію), тож AND кількох множин коштує частку від перебору.
+  */
+class RoaringBitmap
+{
+public:
+    // Контейнер, у якому більше значень, зберігається бітовою картою.
+    static const size_t ARRAY_LIMIT = 4096;
+    static const size_t BITMAP_WORDS = 65536 / 64;
+
+private:
+    struct Container
+    {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        vector<uint16_t> values;
+        vector<uint64_t> words;
+
+        bool IsBitmap() const { return !this->words.empty(); }
+    };
+
+    // Упорядковані за key.
+    vector<Container> containers;
+
+public:
+    /**
+     * @brief Додає значення.
+     * @return false, якщо значення вже було в множині.
+     */
+    bool Add(uint32_t value);
+
+    /**
+     * @brief Прибирає значення.
+     * @return false, якщо значення не було в множині.
+     */
+    bool Remove(uint32_t value);
+
+    bool Contains(uint32_t value) const;
+
+    /**
+     * @brief Кількість значень у множині.
+     */
+    size_t Cardinality() const;
+
+    bool IsEmpty() const;
+    void Clear();
+
+    /**
+     * @brief Залишає лише значення, що є і в other.
+     */
+    RoaringBitmap& operator&=(const RoaringBitmap& other);
+
+    /**
+     * @brief Перетин двох множин.
+     */
+    static RoaringBitmap And(const RoaringBitmap& left, const RoaringBitmap& right);
+
+    /**
+     * @brief Перебирає значення за зростанням.
+     * @param visitor Функція, що приймає uint32_t.
+     */
+    template<typename Visitor>
+    void ForEach(Visitor visitor) const
+    {
+        for (const Container& container : this->containers)
+        {
+            uint32_t high = static_cast<uint32_t>(container.key) << 16;
+            if (!container.IsBitmap())
+            {
+                for (uint16_t low : container.values)
+                {
+                    visitor(high | low);
+                }
+                continue;
+            }
+
+            for (size_t i = 0; i < BITMAP_WORDS; i++)
+            {
+                uint64_t word = container.words[i];
+                while (word != 0)
+                {
+                    uint32_t bit = static_cast<uint32_t>(countTrailingZeros(word));
+                    visitor(high | static_cast<uint32_t>(i * 64 + bit));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Значення множини за зростанням.
+     */
+    vector<uint32_t> ToVector() const;
+
+private:
+    static int countTrailingZeros(uint64_t word);
+
+    /**
+     * @brief Перетин двох контейнерів з однаковим key (порожній, якщо перетину немає).
+     */
+    static Container intersect(const Container& left, const Container& right);
+
+    /**
+     * @brief Перетворює контейнер на масив або бітову карту залежно від кількості значень.
+     */
+    static void normalize(Container& container);
+
+    /**
+     * @brief Індекс контейнера з таким key або позиція, куди його вставити.
+     */
+    size_t findContainer(uint16_t key) const;
+};
\ No newline at end of file
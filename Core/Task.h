@@ -0,0 +1,233 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <utility>
+#include <type_traits>
+
+using namespace std;
+
+namespace TaskDetail
+{
+     /**
+      * @class PromiseBase
+      * @brief Спільна частина promise для Task: старт, завершення, продовження.
+      *
+      * Стан захищено м'ютексом, бо задача може завершитися в робочому
+      * потоці саме тоді, коли інший потік на неї чекає або робить co_await.
+      */
+    class PromiseBase
+    {
+    private:
+        mutex stateMutex;
+        condition_variable finishedCondition;
+        coroutine_handle<> continuation;
+        bool started = false;
+        bool finished = false;
+        exception_ptr error;
+
+    public:
+        /**
+         * @brief Awaiter фінальної точки: повідомляє про завершення
+         * та передає керування тому, хто чекав через co_await.
+         */
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept { return false; }
+
+            template<typename Promise>
+            coroutine_handle<> await_suspend(coroutine_handle<Promise> handle) noexcept
+            {
+                return static_cast<PromiseBase&>(handle.promise()).complete();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { this->error = current_exception(); }
+
+        /**
+         * @brief Запускає корутину, якщо її ще не запущено.
+         */
+        void Start(coroutine_handle<> self)
+        {
+            {
+                lock_guard<mutex> lock(this->stateMutex);
+                if (this->started) return;
+                this->started = true;
+            }
+            self.resume();
+        }
+
+        /**
+         * @brief Реєструє продовження для co_await.
+         * @return Корутину, яку треба продовжити зараз.
+         */
+        coroutine_handle<> Await(coroutine_handle<> self, coroutine_handle<> awaiting)
+        {
+            lock_guard<mutex> lock(this->stateMutex);
+            if (this->finished) return awaiting;
+
+            this->continuation = awaiting;
+            if (!this->started)
+            {
+                this->started = true;
+                return self;
+            }
+            return noop_coroutine();
+        }
+
+        /**
+         * @brief Блокує потік, доки запущена корутина не завершиться.
+         */
+        void WaitIfStarted()
+        {
+            unique_lock<mutex> lock(this->stateMutex);
+            if (!this->started) return;
+            this->finishedCondition.wait(lock, [this] { return this->finished; });
+        }
+
+        bool IsFinished()
+        {
+            lock_guard<mutex> lock(this->stateMutex);
+            return this->finished;
+        }
+
+        void RethrowIfFailed()
+        {
+            if (this->error) rethrow_exception(this->error);
+        }
+
+    private:
+        coroutine_handle<> complete() noexcept
+        {
+            lock_guard<mutex> lock(this->stateMutex);
+            this->finished = true;
+            this->finishedCondition.notify_all();
+            return this->continuation ? this->continuation : noop_coroutine();
+        }
+    };
+
+    template<typename T>
+    class Promise : public PromiseBase
+    {
+    public:
+        optional<T> value;
+
+        template<typename U>
+        void return_value(U&& result) { this->value.emplace(std::forward<U>(result)); }
+    };
+
+    template<>
+    class Promise<void> : public PromiseBase
+    {
+    public:
+        void return_void() {}
+    };
+}
+
+ /**
+  * @class Task
+  * @brief Лінива корутина з результатом типу T.
+  *
+  * Починає виконання при першому co_await, Start() або Get().
+  * Її можна чекати з іншої корутини (co_await) або синхронно (Get()).
+  * Деструктор дочікується завершення вже запущеної задачі, тому
+  * Task можна зберігати як "фонову операцію" без ризику висячих посилань.
+  */
+template<typename T = void>
+class Task
+{
+public:
+    struct promise_type : public TaskDetail::Promise<T>
+    {
+        Task get_return_object()
+        {
+            return Task(coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+private:
+    coroutine_handle<promise_type> handle;
+
+public:
+    Task() : handle(nullptr) {}
+
+    explicit Task(coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    Task(Task&& other) noexcept : handle(exchange(other.handle, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            this->reset();
+            this->handle = exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { this->reset(); }
+
+    /**
+     * @brief Чи містить об'єкт корутину.
+     */
+    bool IsValid() const { return this->handle != nullptr; }
+
+    /**
+     * @brief Чи завершилась корутина.
+     */
+    bool IsReady() const { return this->handle && this->handle.promise().IsFinished(); }
+
+    /**
+     * @brief Запускає корутину на поточному потоці (до першої точки очікування).
+     */
+    void Start() { this->handle.promise().Start(this->handle); }
+
+    /**
+     * @brief Запускає (за потреби) і синхронно чекає результат.
+     * @return Результат корутини; виняток корутини прокидається далі.
+     */
+    T Get()
+    {
+        this->Start();
+        this->handle.promise().WaitIfStarted();
+        return this->takeResult();
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    coroutine_handle<> await_suspend(coroutine_handle<> awaiting)
+    {
+        return this->handle.promise().Await(this->handle, awaiting);
+    }
+
+    T await_resume() { return this->takeResult(); }
+
+private:
+    T takeResult()
+    {
+        this->handle.promise().RethrowIfFailed();
+        if constexpr (!is_void_v<T>)
+        {
+            return std::move(*this->handle.promise().value);
+        }
+    }
+
+    void reset()
+    {
+        if (this->handle)
+        {
+            this->handle.promise().WaitIfStarted();
+            this->handle.destroy();
+            this->handle = nullptr;
+        }
+    }
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "WorkerPool.h"
+
+using namespace std;
+
+WorkerPool::WorkerPool(size_t workerCount, size_t queueCapacity)
+    : queueCapacity(queueCapacity),
+    stopping(false)
+{
+    if (workerCount == 0)
+    {
+        workerCount = thread::hardware_concurrency();
+        if (workerCount == 0) workerCount = 2;
+    }
+
+    this->workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        this->workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    this->Shutdown();
+}
+
+void WorkerPool::Shutdown()
+{
+    {
+        lock_guard<mutex> lock(this->queueMutex);
+        this->stopping = true;
+    }
+    this->queueCondition.notify_all();
+
+    for (thread& worker : this->workers)
+    {
+        if (worker.joinable()) worker.join();
+    }
+    this->workers.clear();
+}
+
+void WorkerPool::Submit(function<void()> task)
+{
+    {
+        lock_guard<mutex> lock(this->queueMutex);
+        this->tasks.push(move(task));
+    }
+    this->queueCondition.notify_one();
+}
+
+bool WorkerPool::TrySubmit(function<void()> task)
+{
+    {
+        lock_guard<mutex> lock(this->queueMutex);
+        if (this->stopping) return false;
+        if (this->queueCapacity != 0 && this->tasks.size() >= this->queueCapacity) return false;
+
+        this->tasks.push(move(task));
+    }
+    this->queueCondition.notify_one();
+    return true;
+}
+
+size_t WorkerPool::GetWorkerCount() const
+{
+    return this->workers.size();
+}
+
+void WorkerPool::workerLoop()
+{
+    while (true)
+    {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(this->queueMutex);
+            this->queueCondition.wait(lock, [this]
+                {
+                    return this->stopping || !this->tasks.empty();
+                });
+
+            if (this->tasks.empty()) return;
+
+            task = move(this->tasks.front());
+            this->tasks.pop();
+        }
+        task();
+    }
+}
\ No newline at end of file
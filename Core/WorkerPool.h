@@ -0,0 +1,77 @@
+#pragma once
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+
+using namespace std;
+
+ /**
+  * @class WorkerPool
+  * @brief Простий пул робочих потоків із загальною чергою задач.
+  *
+  * Задачі виконуються у порядку надходження будь-яким вільним потоком.
+  * Черга може бути обмеженою: тоді TrySubmit() відмовляє, коли вона
+  * заповнена, замість того щоб накопичувати задачі без кінця.
+  * Деструктор дочікується завершення вже поставлених задач.
+  */
+class WorkerPool
+{
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queueMutex;
+    condition_variable queueCondition;
+    size_t queueCapacity;
+    bool stopping;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param workerCount Кількість потоків (0 - за кількістю ядер).
+     * @param queueCapacity Найбільша кількість задач, що чекають у черзі
+     * (0 - без обмеження). Враховується лише в TrySubmit().
+     */
+    explicit WorkerPool(size_t workerCount, size_t queueCapacity = 0);
+
+    /**
+     * @brief Деструктор. Викликає Shutdown().
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Ставить задачу в чергу на виконання.
+     * @param task Функція, яку потрібно виконати.
+     */
+    void Submit(function<void()> task);
+
+    /**
+     * @brief Ставить задачу в чергу, якщо в ній є місце.
+     * @param task Функція, яку потрібно виконати.
+     * @return false, якщо черга заповнена або пул зупинено.
+     */
+    bool TrySubmit(function<void()> task);
+
+    /**
+     * @brief Виконує задачі, що залишились у черзі, та зупиняє потоки.
+     * Повторний виклик нічого не робить.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Отримує кількість робочих потоків.
+     * @return Кількість потоків.
+     */
+    size_t GetWorkerCount() const;
+
+private:
+    /**
+     * @brief Головний цикл робочого потоку.
+     */
+    void workerLoop();
+};
\ No newline at end of file
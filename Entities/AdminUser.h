@@ -1,33 +0,0 @@
-#pragma once
-#include "BaseUser.h"
-#include <string>
-
-using namespace std;
-
- /**
-  * @class AdminUser
-  * @brief   -.
-  *
-  *  BaseUser    
-  *      ().
-  */
-class AdminUser : public BaseUser
-{
-private:
-    string username;
-    string password;
-
-public:
-    /**
-     * @brief .
-     * @param username .
-     * @param password .
-     */
-    AdminUser(const string& username, const string& password);
-
-    string GetUsername() const override;
-    bool CheckPassword(const string& password) const override;
-    string GetUserType() const override;
-    string ToFileString() const override;
-    bool IsAdmin() const override;
-};
\ No newline at end of file
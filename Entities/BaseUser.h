@@ -1,51 +0,0 @@
-#pragma once
-#include <string>
-
-using namespace std;
-
- /**
-  * @class BaseUser
-  * @brief      .
-  *
-  *      ,
-  *       .
-  */
-class BaseUser
-{
-public:
-    /**
-     * @brief ³ .
-     */
-    virtual ~BaseUser() {}
-
-    /**
-     * @brief   .
-     * @return   string.
-     */
-    virtual string GetUsername() const = 0;
-
-    /**
-     * @brief ,     .
-     * @param password   .
-     * @return true,   ,  false.
-     */
-    virtual bool CheckPassword(const string& password) const = 0;
-
-    /**
-     * @brief     (., "Admin"  "Standard").
-     * @return    string.
-     */
-    virtual string GetUserType() const = 0;
-
-    /**
-     * @brief       (CSV-).
-     * @return   .
-     */
-    virtual string ToFileString() const = 0;
-
-    /**
-     * @brief ,     .
-     * @return true,    ,  false.
-     */
-    virtual bool IsAdmin() const = 0;
-};
\ No newline at end of file
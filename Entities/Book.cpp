@@ -1,7 +1,8 @@
 #include "Book.h"
 #include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <charconv>
+#include <stdexcept>
+#include <cstring>
 
 using namespace std;
 
@@ -10,19 +11,77 @@ namespace
     const string DEFAULT_ARTICLE = "N/A";
     const string DEFAULT_AUTHOR = "Unknown";
     const string DEFAULT_TITLE = "Untitled";
-    const double DEFAULT_PRICE = 0.0;
+    const Money DEFAULT_PRICE;
     const int DEFAULT_SHELF = 0;
     const string MOVE_MARKER = "MOVED";
+
+    const char CSV_SEPARATOR = ',';
+
+    const char CARD_SEPARATOR[] = "----------------------------------------\n";
+    const size_t TABLE_ARTICLE_WIDTH = 8;
+    const size_t TABLE_TEXT_WIDTH = 18;
+    const size_t TABLE_PRICE_WIDTH = 11;
+    const size_t TABLE_SHELF_WIDTH = 8;
+    const char STATUS_AVAILABLE[] = "Доступна";
+
+    /**
+     * @brief Дописує текст і доповнює його пробілами до ширини колонки.
+     * Ширина рахується в байтах: консоль працює в однобайтовій CP1251.
+     * Задовгий текст не обрізається, а відділяється одним пробілом.
+     */
+    void appendPadded(string& output, string_view text, size_t width)
+    {
+        output += text;
+        output.append(text.size() < width ? width - text.size() : 1, ' ');
+    }
+
+    /**
+     * @brief Дописує число без потоків, вирівнюючи його праворуч.
+     */
+    void appendRightAligned(string& output, string_view text, size_t width)
+    {
+        if (text.size() < width) output.append(width - text.size(), ' ');
+        output += text;
+    }
+
+    /**
+     * @brief Повертає поле рядка CSV, що починається з position, і
+     * переводить position за роздільник.
+     */
+    string_view nextCsvField(string_view line, size_t& position)
+    {
+        if (position > line.size()) return {};
+
+        size_t end = line.find(CSV_SEPARATOR, position);
+        if (end == string_view::npos) end = line.size();
+
+        string_view field = line.substr(position, end - position);
+        position = end + 1;
+        return field;
+    }
+
+    int parseShelfNumber(string_view field)
+    {
+        int shelfNumber = 0;
+        auto [end, error] = from_chars(field.data(), field.data() + field.size(), shelfNumber);
+        if (error == errc::result_out_of_range)
+        {
+            throw out_of_range("Book: номер полиці за межами діапазону");
+        }
+        if (error != errc() || end != field.data() + field.size())
+        {
+            throw invalid_argument("Book: некоректний номер полиці");
+        }
+        return shelfNumber;
+    }
 }
 
 Book::Book()
-    : article(DEFAULT_ARTICLE),
-    authorName(DEFAULT_AUTHOR),
-    bookTitle(DEFAULT_TITLE),
-    price(DEFAULT_PRICE),
+    : price(DEFAULT_PRICE),
     shelfNumber(DEFAULT_SHELF),
-    readerFullName("")
+    fieldLengths{}
 {
+    this->assignFields(DEFAULT_ARTICLE, DEFAULT_AUTHOR, DEFAULT_TITLE, "");
 }
 
 Book::Book(
@@ -33,36 +92,44 @@ Book::Book(
     int shelfNumber,
     const string& readerFullName
 )
-    : article(article),
-    authorName(authorName),
-    bookTitle(bookTitle),
-    price(price),
+    : Book(article, authorName, bookTitle, Money::FromDouble(price), shelfNumber, readerFullName)
+{
+}
+
+Book::Book(
+    const string& article,
+    const string& authorName,
+    const string& bookTitle,
+    Money price,
+    int shelfNumber,
+    const string& readerFullName
+)
+    : price(price),
     shelfNumber(shelfNumber),
-    readerFullName(readerFullName)
+    fieldLengths{}
 {
+    this->assignFields(article, authorName, bookTitle, readerFullName);
 }
 
 Book::Book(const Book& other)
-    : article(other.article),
-    authorName(other.authorName),
-    bookTitle(other.bookTitle),
-    price(other.price),
+    : price(other.price),
     shelfNumber(other.shelfNumber),
-    readerFullName(other.readerFullName)
+    fieldLengths{}
 {
+    this->assignFields(
+        other.getField(FIELD_ARTICLE), other.getField(FIELD_AUTHOR),
+        other.getField(FIELD_TITLE), other.getField(FIELD_READER));
 }
 
 Book::Book(Book&& other) noexcept
-    : article(std::move(other.article)),
-    authorName(std::move(other.authorName)),
-    bookTitle(std::move(other.bookTitle)),
-    price(other.price),
+    : price(other.price),
     shelfNumber(other.shelfNumber),
-    readerFullName(std::move(other.readerFullName))
+    fieldLengths{}
 {
+    this->stealFields(other);
+
     other.price = DEFAULT_PRICE;
     other.shelfNumber = DEFAULT_SHELF;
-    other.article = MOVE_MARKER;
 }
 
 Book& Book::operator=(Book&& other) noexcept
@@ -70,66 +137,74 @@ Book& Book::operator=(Book&& other) noexcept
     if (this == &other)
         return *this;
 
-    this->article = std::move(other.article);
-    this->authorName = std::move(other.authorName);
-    this->bookTitle = std::move(other.bookTitle);
+    this->releaseFields();
+    this->stealFields(other);
     this->price = other.price;
     this->shelfNumber = other.shelfNumber;
-    this->readerFullName = std::move(other.readerFullName);
 
     other.price = DEFAULT_PRICE;
     other.shelfNumber = DEFAULT_SHELF;
-    other.article = MOVE_MARKER;
 
     return *this;
 }
 
 Book::~Book()
 {
-    //if (this->article != MOVE_MARKER)
+    //if (this->GetArticle() != MOVE_MARKER)
     //{
-    //    cout << "'  '" << this->bookTitle
-    //        << "' (: " << this->article
-    //        << ") .\n";
+    //    cout << "Об'єкт книги '" << this->GetBookTitle()
+    //        << "' (Арт: " << this->GetArticle()
+    //        << ") знищується.\n";
     //}
+    this->releaseFields();
 }
 
 void Book::SetArticle(const string& article)
 {
-    this->article = article;
+    this->setField(FIELD_ARTICLE, article);
 }
 
 string Book::GetArticle() const
 {
-    return this->article;
+    return string(this->getField(FIELD_ARTICLE));
 }
 
 void Book::SetAuthorName(const string& authorName)
 {
-    this->authorName = authorName;
+    this->setField(FIELD_AUTHOR, authorName);
 }
 
 string Book::GetAuthorName() const
 {
-    return this->authorName;
+    return string(this->getField(FIELD_AUTHOR));
 }
 
 void Book::SetBookTitle(const string& bookTitle)
 {
-    this->bookTitle = bookTitle;
+    this->setField(FIELD_TITLE, bookTitle);
 }
 
 string Book::GetBookTitle() const
 {
-    return this->bookTitle;
+    return string(this->getField(FIELD_TITLE));
 }
 
 void Book::SetPrice(double price)
+{
+    this->price = Money::FromDouble(price);
+}
+
+void Book::SetPrice(Money price)
 {
     this->price = price;
 }
 
 double Book::GetPrice() const
+{
+    return this->price.ToDouble();
+}
+
+Money Book::GetExactPrice() const
 {
     return this->price;
 }
@@ -146,17 +221,17 @@ int Book::GetShelfNumber() const
 
 void Book::SetReaderFullName(const string& readerFullName)
 {
-    this->readerFullName = readerFullName;
+    this->setField(FIELD_READER, readerFullName);
 }
 
 string Book::GetReaderFullName() const
 {
-    return this->readerFullName;
+    return string(this->getField(FIELD_READER));
 }
 
 string Book::GetId() const
 {
-    return this->article;
+    return string(this->getField(FIELD_ARTICLE));
 }
 
 string Book::GetTypeName() const
@@ -166,56 +241,138 @@ string Book::GetTypeName() const
 
 bool Book::IsAvailable() const
 {
-    return this->readerFullName.empty();
+    return this->fieldLengths[FIELD_READER] == 0;
 }
 
 void Book::IssueToReader(const string& readerName)
 {
-    this->readerFullName = readerName;
+    this->setField(FIELD_READER, readerName);
 }
 
 void Book::ReturnToLibrary()
 {
-    this->readerFullName = "";
+    this->setField(FIELD_READER, "");
 }
 
 void Book::Display() const
 {
-    cout << "----------------------------------------\n";
-    cout << ":    " << this->bookTitle << "\n";
-    cout << ":    " << this->authorName << "\n";
-    cout << ":  " << this->article << "\n";
-    cout << "ֳ:     " << fixed << setprecision(2) << this->price << " \n";
-    cout << ":   " << this->shelfNumber << "\n";
+    string card;
+    this->AppendCard(card);
+    cout.write(card.data(), static_cast<streamsize>(card.size()));
+}
+
+void Book::AppendCard(string& output) const
+{
+    output += CARD_SEPARATOR;
+    output += "Назва:    ";
+    output += this->getField(FIELD_TITLE);
+    output += "\nАвтор:    ";
+    output += this->getField(FIELD_AUTHOR);
+    output += "\nАртикул:  ";
+    output += this->getField(FIELD_ARTICLE);
+    output += "\nЦіна:     ";
+    this->price.AppendTo(output);
+    output += " грн\nПолиця:   ";
+
+    char shelf[16];
+    auto result = to_chars(shelf, shelf + sizeof(shelf), this->shelfNumber);
+    output.append(shelf, result.ptr);
 
     if (IsAvailable())
     {
-        cout << ":   \n";
+        output += "\nСтатус:   Доступна\n";
     }
     else
     {
-        cout << ":     " << this->readerFullName << "\n";
+        output += "\nСтатус:   Видана читачу ";
+        output += this->getField(FIELD_READER);
+        output += "\n";
     }
-    cout << "----------------------------------------\n";
+    output += CARD_SEPARATOR;
 }
 
-string Book::ToCsvString() const
+void Book::AppendTableHeader(string& output)
+{
+    appendPadded(output, "Артикул", TABLE_ARTICLE_WIDTH);
+    appendPadded(output, "Назва", TABLE_TEXT_WIDTH);
+    appendPadded(output, "Автор", TABLE_TEXT_WIDTH);
+    appendRightAligned(output, "Ціна", TABLE_PRICE_WIDTH);
+    appendRightAligned(output, "Полиця", TABLE_SHELF_WIDTH);
+    output += "  Статус\n";
+    output.append(TABLE_ARTICLE_WIDTH + 2 * TABLE_TEXT_WIDTH + TABLE_PRICE_WIDTH
+        + TABLE_SHELF_WIDTH + 16, '-');
+    output += '\n';
+}
+
+void Book::AppendTableRow(string& output) const
 {
-    stringstream ss;
+    appendPadded(output, this->getField(FIELD_ARTICLE), TABLE_ARTICLE_WIDTH);
+    appendPadded(output, this->getField(FIELD_TITLE), TABLE_TEXT_WIDTH);
+    appendPadded(output, this->getField(FIELD_AUTHOR), TABLE_TEXT_WIDTH);
+
+    size_t priceStart = output.size();
+    this->price.AppendTo(output);
+    size_t priceLength = output.size() - priceStart;
+    if (priceLength < TABLE_PRICE_WIDTH)
+    {
+        output.insert(priceStart, TABLE_PRICE_WIDTH - priceLength, ' ');
+    }
+
+    char shelf[16];
+    auto result = to_chars(shelf, shelf + sizeof(shelf), this->shelfNumber);
+    appendRightAligned(output, string_view(shelf, result.ptr - shelf), TABLE_SHELF_WIDTH);
 
-    ss << fixed << setprecision(2) << this->price;
-    string formattedPrice = ss.str();
+    output += "  ";
+    if (IsAvailable())
+        output += STATUS_AVAILABLE;
+    else
+        output += this->getField(FIELD_READER);
+    output += '\n';
+}
 
-    string csvRow = this->article + "," +
-        this->authorName + "," +
-        this->bookTitle + "," +
-        formattedPrice + "," +
-        to_string(this->shelfNumber) + "," +
-        this->readerFullName;
+string Book::ToCsvString() const
+{
+    // Ціна та номер полиці пишуться без потоків: ~24 символи на числа.
+    string csvRow;
+    csvRow.reserve(this->getTotalLength() + 32);
+
+    csvRow += this->getField(FIELD_ARTICLE);
+    csvRow += CSV_SEPARATOR;
+    csvRow += this->getField(FIELD_AUTHOR);
+    csvRow += CSV_SEPARATOR;
+    csvRow += this->getField(FIELD_TITLE);
+    csvRow += CSV_SEPARATOR;
+    this->price.AppendTo(csvRow);
+    csvRow += CSV_SEPARATOR;
+
+    char shelf[16];
+    auto result = to_chars(shelf, shelf + sizeof(shelf), this->shelfNumber);
+    csvRow.append(shelf, result.ptr);
+    csvRow += CSV_SEPARATOR;
+    csvRow += this->getField(FIELD_READER);
 
     return csvRow;
 }
 
+Book Book::FromCsvString(const string& line)
+{
+    string_view row(line);
+    size_t position = 0;
+
+    string_view article = nextCsvField(row, position);
+    string_view authorName = nextCsvField(row, position);
+    string_view bookTitle = nextCsvField(row, position);
+    Money price = Money::Parse(nextCsvField(row, position));
+    int shelfNumber = parseShelfNumber(nextCsvField(row, position));
+    string_view readerFullName = nextCsvField(row, position);
+
+    Book book;
+    book.assignFields(article, authorName, bookTitle, readerFullName);
+    book.price = price;
+    book.shelfNumber = shelfNumber;
+    return book;
+}
+
 Book& Book::operator=(const Book& other)
 {
     if (this == &other)
@@ -223,12 +380,112 @@ Book& Book::operator=(const Book& other)
         return *this;
     }
 
-    this->article = other.article;
-    this->authorName = other.authorName;
-    this->bookTitle = other.bookTitle;
+    this->assignFields(
+        other.getField(FIELD_ARTICLE), other.getField(FIELD_AUTHOR),
+        other.getField(FIELD_TITLE), other.getField(FIELD_READER));
     this->price = other.price;
     this->shelfNumber = other.shelfNumber;
-    this->readerFullName = other.readerFullName;
 
     return *this;
-}
\ No newline at end of file
+}
+
+size_t Book::getTotalLength() const
+{
+    size_t total = 0;
+    for (uint16_t length : this->fieldLengths)
+    {
+        total += length;
+    }
+    return total;
+}
+
+bool Book::isInline() const
+{
+    return this->getTotalLength() <= INLINE_CAPACITY;
+}
+
+const char* Book::getFieldData() const
+{
+    return this->isInline() ? this->inlineFields : this->heapFields;
+}
+
+string_view Book::getField(Field field) const
+{
+    size_t offset = 0;
+    for (int i = 0; i < field; i++)
+    {
+        offset += this->fieldLengths[i];
+    }
+    return string_view(this->getFieldData() + offset, this->fieldLengths[field]);
+}
+
+void Book::assignFields(string_view article, string_view authorName,
+    string_view bookTitle, string_view readerFullName)
+{
+    const string_view fields[FIELD_COUNT] = { article, authorName, bookTitle, readerFullName };
+
+    size_t total = 0;
+    for (string_view field : fields)
+    {
+        if (field.size() > MAX_FIELD_LENGTH)
+        {
+            throw length_error("Book: поле задовге");
+        }
+        total += field.size();
+    }
+
+    // Нові поля спершу збираються окремо: вони можуть вказувати на старий буфер.
+    char buffer[INLINE_CAPACITY];
+    char* target = total <= INLINE_CAPACITY ? buffer : new char[total];
+    size_t offset = 0;
+    for (string_view field : fields)
+    {
+        field.copy(target + offset, field.size());
+        offset += field.size();
+    }
+
+    this->releaseFields();
+    for (int i = 0; i < FIELD_COUNT; i++)
+    {
+        this->fieldLengths[i] = static_cast<uint16_t>(fields[i].size());
+    }
+
+    if (target == buffer)
+        memcpy(this->inlineFields, buffer, total);
+    else
+        this->heapFields = target;
+}
+
+void Book::setField(Field field, string_view value)
+{
+    string_view fields[FIELD_COUNT];
+    for (int i = 0; i < FIELD_COUNT; i++)
+    {
+        fields[i] = this->getField(static_cast<Field>(i));
+    }
+    fields[field] = value;
+    this->assignFields(fields[FIELD_ARTICLE], fields[FIELD_AUTHOR], fields[FIELD_TITLE], fields[FIELD_READER]);
+}
+
+void Book::stealFields(Book& other)
+{
+    memcpy(this->fieldLengths, other.fieldLengths, sizeof(this->fieldLengths));
+    if (other.isInline())
+        memcpy(this->inlineFields, other.inlineFields, INLINE_CAPACITY);
+    else
+        this->heapFields = other.heapFields;
+
+    // Переміщена книга лишається з маркером замість артикулу.
+    memset(other.fieldLengths, 0, sizeof(other.fieldLengths));
+    other.fieldLengths[FIELD_ARTICLE] = static_cast<uint16_t>(MOVE_MARKER.size());
+    MOVE_MARKER.copy(other.inlineFields, MOVE_MARKER.size());
+}
+
+void Book::releaseFields()
+{
+    if (!this->isInline())
+    {
+        delete[] this->heapFields;
+    }
+    memset(this->fieldLengths, 0, sizeof(this->fieldLengths));
+}
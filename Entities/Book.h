@@ -1,41 +1,69 @@
 #pragma once
 #include "IStorable.h"
+#include "Money.h"
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <cstdint>
 
 using namespace std;
 
 /**
  * @class Book
- * @brief ,     .
+ * @brief Клас, що представляє книгу в бібліотеці.
  *
- *  IStorable      ,
- *   , , ,     .
+ * Відповідає концепту Storable і зберігає всю інформацію про книгу,
+ * таку як артикул, автор, назва, а також хто її взяв. Віртуальних
+ * методів немає, тож в об'єкті немає й вказівника на vtable.
+ *
+ * Текстові поля лежать підряд в одному буфері: короткі записи
+ * (до INLINE_CAPACITY символів разом) - прямо в об'єкті, довші - в
+ * одному блоці в купі. Тож об'єкт займає 56 байт замість ~150 і
+ * потребує не більше одного виділення пам'яті.
  */
-class Book : public IStorable
+class Book
 {
+public:
+    static const size_t INLINE_CAPACITY = 32;
+
+    /**
+     * @brief Найбільша довжина текстового поля (байт): довжини зберігаються в uint16_t.
+     */
+    static const size_t MAX_FIELD_LENGTH = UINT16_MAX;
+
 private:
-    string article;
-    string authorName;
-    string bookTitle;
-    double price;
+    enum Field
+    {
+        FIELD_ARTICLE,
+        FIELD_AUTHOR,
+        FIELD_TITLE,
+        FIELD_READER,
+        FIELD_COUNT
+    };
+
+    Money price;
     int shelfNumber;
-    string readerFullName;
+    uint16_t fieldLengths[FIELD_COUNT];
+    union
+    {
+        char inlineFields[INLINE_CAPACITY];
+        char* heapFields;
+    };
 
 public:
     /**
-     * @brief   .
+     * @brief Конструктор за замовчуванням.
      */
     Book();
 
     /**
-     * @brief      .
-     * @param article  ( ID).
-     * @param authorName ' .
-     * @param bookTitle  .
-     * @param price .
-     * @param shelfNumber  .
-     * @param readerFullName ϲ  (  ).
+     * @brief Конструктор з параметрами для створення книги.
+     * @param article Артикул (унікальний ID).
+     * @param authorName Ім'я автора.
+     * @param bookTitle Назва книги.
+     * @param price Вартість.
+     * @param shelfNumber Номер етажерки.
+     * @param readerFullName ПІБ читача (за замовчуванням порожньо).
      */
     Book(
         const string& article,
@@ -47,35 +75,47 @@ public:
     );
 
     /**
-     * @brief  .
-     * @param other  ' Book  .
+     * @brief Конструктор з точною ціною (у копійках).
+     */
+    Book(
+        const string& article,
+        const string& authorName,
+        const string& bookTitle,
+        Money price,
+        int shelfNumber,
+        const string& readerFullName = ""
+    );
+
+    /**
+     * @brief Конструктор копіювання.
+     * @param other Інший об'єкт Book для копіювання.
      */
     Book(const Book& other);
 
     /**
-     * @brief   (Move Constructor).
+     * @brief Конструктор переміщення (Move Constructor).
      */
     Book(Book&& other) noexcept;
 
     /**
-     * @brief     (Move Assignment).
+     * @brief Оператор присвоєння з переміщенням (Move Assignment).
      */
     Book& operator=(Book&& other) noexcept;
 
     /**
-     * @brief .
+     * @brief Деструктор.
      */
     ~Book();
 
     /**
-     * @brief   .
-     * @param article  .
+     * @brief Встановлює артикул книги.
+     * @param article Новий артикул.
      */
     void SetArticle(const string& article);
 
     /**
-     * @brief   .
-     * @return   string.
+     * @brief Отримує артикул книги.
+     * @return Артикул як string.
      */
     string GetArticle() const;
 
@@ -86,49 +126,104 @@ public:
     string GetBookTitle() const;
 
     void SetPrice(double price);
+    void SetPrice(Money price);
     double GetPrice() const;
 
+    /**
+     * @brief Точна ціна (ціле число копійок) для сортування та підсумків.
+     */
+    Money GetExactPrice() const;
+
     void SetShelfNumber(int shelfNumber);
     int GetShelfNumber() const;
 
     void SetReaderFullName(const string& readerFullName);
     string GetReaderFullName() const;
 
-    string GetId() const override;
-    string GetTypeName() const override;
+    string GetId() const;
+    string GetTypeName() const;
 
     /**
-     * @brief ,    (    ).
-     * @return true,  , false -  .
+     * @brief Перевіряє, чи книга доступна (не на руках у читача).
+     * @return true, якщо доступна, false - якщо видана.
      */
     bool IsAvailable() const;
 
     /**
-     * @brief   .
-     * @param readerName ϲ ,   .
+     * @brief Видає книгу читачу.
+     * @param readerName ПІБ читача, якому видається книга.
      */
     void IssueToReader(const string& readerName);
 
     /**
-     * @brief     ( ).
+     * @brief Повертає книгу до бібліотеки (робить доступною).
      */
     void ReturnToLibrary();
 
     /**
-     * @brief      .
+     * @brief Виводить інформацію про книгу в консоль (одним записом).
      */
     void Display() const;
 
     /**
-     * @brief       CSV.
-     * @return  string   CSV.
+     * @brief Дописує картку книги (як Display()) у кінець рядка.
+     */
+    void AppendCard(string& output) const;
+
+    /**
+     * @brief Дописує заголовок компактної таблиці книг у кінець рядка.
+     */
+    static void AppendTableHeader(string& output);
+
+    /**
+     * @brief Дописує книгу одним рядком компактної таблиці.
+     * Числа форматуються без потоків, тож рядок - лише кілька append.
+     */
+    void AppendTableRow(string& output) const;
+
+    /**
+     * @brief Конвертує дані книги в рядок формату CSV.
+     * @return Рядок string у форматі CSV.
      */
     string ToCsvString() const;
 
     /**
-     * @brief   .
-     * @param other  ' Book  .
-     * @return    ' (*this).
+     * @brief Створює книгу з рядка формату CSV (обернена до ToCsvString()).
+     * @param line Рядок CSV.
+     * @return Книга з даними рядка.
+     * @throws invalid_argument або out_of_range, якщо ціна чи номер полиці пошкоджені.
+     */
+    static Book FromCsvString(const string& line);
+
+    /**
+     * @brief Копіювальний оператор присвоєння.
+     * @param other Інший об'єкт Book для копіювання.
+     * @return Посилання на цей об'єкт (*this).
      */
     Book& operator=(const Book& other);
-};
\ No newline at end of file
+
+private:
+    size_t getTotalLength() const;
+    bool isInline() const;
+    const char* getFieldData() const;
+    string_view getField(Field field) const;
+
+    /**
+     * @brief Записує всі текстові поля в новий буфер і звільняє старий.
+     * Поля можуть вказувати на поточний буфер.
+     * @throws length_error, якщо поле довше за 65535 символів.
+     */
+    void assignFields(string_view article, string_view authorName,
+        string_view bookTitle, string_view readerFullName);
+
+    void setField(Field field, string_view value);
+
+    /**
+     * @brief Забирає буфер іншої книги, лишаючи її в стані "переміщено".
+     */
+    void stealFields(Book& other);
+
+    void releaseFields();
+};
+
+static_assert(Storable<Book>, "Book повинна відповідати концепту Storable");
\ No newline at end of file
@@ -1,36 +1,22 @@
 #pragma once
 #include <string>
+#include <concepts>
 
 using namespace std;
 
  /**
-  * @class IStorable
-  * @brief    ()  ',
-  *   .
+  * @brief Контракт для об'єктів, що можуть зберігатися.
   *
-  *   ,     -,
-  * ,      .
+  * Тип повинен надавати унікальний ідентифікатор, назву типу та
+  * перетворення в рядок CSV і назад. Код сховищ пишеться один раз як
+  * шаблон над Storable і для кожного типу викликає методи напряму,
+  * без віртуальних викликів і без vtable в кожному об'єкті.
   */
-class IStorable
+template<typename T>
+concept Storable = requires(const T& item, const string& line)
 {
-public:
-    /**
-     * @brief ³ .
-     *
-     *      
-     *   '     .
-     */
-    virtual ~IStorable() {}
-
-    /**
-     * @brief    ' ().
-     * @return  string,   ID.
-     */
-    virtual string GetId() const = 0;
-
-    /**
-     * @brief    '.
-     * @return  string (, "Book").
-     */
-    virtual string GetTypeName() const = 0;
+    { item.GetId() } -> convertible_to<string>;
+    { item.GetTypeName() } -> convertible_to<string>;
+    { item.ToCsvString() } -> convertible_to<string>;
+    { T::FromCsvString(line) } -> same_as<T>;
 };
\ No newline at end of file
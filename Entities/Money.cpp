@@ -0,0 +1,124 @@
+#include "Money.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    const size_t FRACTION_DIGITS = 2;
+
+    // Найбільше значення, яке ще можна помножити на 10 і додати цифру.
+    const int64_t MAX_BEFORE_DIGIT = (numeric_limits<int64_t>::max() - 9) / 10;
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+}
+
+Money Money::FromDouble(double hryvnias)
+{
+    double kopecks = round(hryvnias * KOPECKS_PER_HRYVNIA);
+    if (!isfinite(kopecks) ||
+        kopecks >= static_cast<double>(numeric_limits<int64_t>::max()) ||
+        kopecks <= static_cast<double>(numeric_limits<int64_t>::min()))
+    {
+        throw out_of_range("Money: сума за межами діапазону");
+    }
+    return Money(static_cast<int64_t>(kopecks));
+}
+
+Money Money::Parse(string_view text)
+{
+    size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+    {
+        negative = text[i] == '-';
+        i++;
+    }
+
+    int64_t value = 0;
+    size_t digits = 0;
+    for (; i < text.size() && isDigit(text[i]); i++, digits++)
+    {
+        if (value > MAX_BEFORE_DIGIT) throw out_of_range("Money: сума за межами діапазону");
+        value = value * 10 + (text[i] - '0');
+    }
+
+    // Копійки: рівно два знаки, решта лише округлює.
+    size_t fractionDigits = 0;
+    bool roundUp = false;
+    if (i < text.size() && text[i] == '.')
+    {
+        i++;
+        for (; i < text.size() && isDigit(text[i]); i++, digits++)
+        {
+            if (fractionDigits < FRACTION_DIGITS)
+            {
+                if (value > MAX_BEFORE_DIGIT) throw out_of_range("Money: сума за межами діапазону");
+                value = value * 10 + (text[i] - '0');
+                fractionDigits++;
+            }
+            else if (fractionDigits++ == FRACTION_DIGITS)
+            {
+                roundUp = text[i] >= '5';
+            }
+        }
+    }
+
+    if (digits == 0 || i != text.size())
+    {
+        throw invalid_argument("Money: некоректна сума");
+    }
+
+    for (; fractionDigits < FRACTION_DIGITS; fractionDigits++)
+    {
+        if (value > MAX_BEFORE_DIGIT) throw out_of_range("Money: сума за межами діапазону");
+        value *= 10;
+    }
+    if (roundUp) value++;
+
+    return Money(negative ? -value : value);
+}
+
+string Money::ToString() const
+{
+    string text;
+    this->AppendTo(text);
+    return text;
+}
+
+void Money::AppendTo(string& output) const
+{
+    // "-" + до 19 цифр гривень + "." + 2 цифри копійок.
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* begin = end;
+
+    // Від'ємне число обробляємо як беззнакове, щоб не переповнити INT64_MIN.
+    uint64_t magnitude = this->kopecks < 0
+        ? 0 - static_cast<uint64_t>(this->kopecks)
+        : static_cast<uint64_t>(this->kopecks);
+
+    *--begin = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+    *--begin = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+    *--begin = '.';
+    do
+    {
+        *--begin = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (this->kopecks < 0) *--begin = '-';
+
+    output.append(begin, end);
+}
+
+ostream& operator<<(ostream& output, const Money& money)
+{
+    return output << money.ToString();
+}
\ No newline at end of file
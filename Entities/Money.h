@@ -0,0 +1,89 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <compare>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class Money
+  * @brief Грошова сума з фіксованою точкою: ціле число копійок.
+  *
+  * На відміну від double, суми та порівняння точні, а текстовий вигляд
+  * ("123.45") розбирається і формується без iostreams і без втрат.
+  */
+class Money
+{
+public:
+    static const int64_t KOPECKS_PER_HRYVNIA = 100;
+
+private:
+    int64_t kopecks;
+
+    constexpr explicit Money(int64_t kopecks) : kopecks(kopecks) {}
+
+public:
+    /**
+     * @brief Нульова сума.
+     */
+    constexpr Money() : kopecks(0) {}
+
+    /**
+     * @brief Створює суму з кількості копійок.
+     */
+    static constexpr Money FromKopecks(int64_t kopecks) { return Money(kopecks); }
+
+    /**
+     * @brief Створює суму з гривень, округлюючи до найближчої копійки.
+     * @throws out_of_range, якщо значення не вміщується.
+     */
+    static Money FromDouble(double hryvnias);
+
+    /**
+     * @brief Розбирає суму у форматі "[-]гривні[.копійки]" (напр., "693.93").
+     * Зайві знаки після другого округлюються.
+     * @param text Текст суми.
+     * @return Сума.
+     * @throws invalid_argument, якщо текст не є числом; out_of_range, якщо
+     * значення не вміщується.
+     */
+    static Money Parse(string_view text);
+
+    int64_t GetKopecks() const { return this->kopecks; }
+
+    /**
+     * @brief Сума в гривнях (для відображення та наближених обчислень).
+     */
+    double ToDouble() const { return static_cast<double>(this->kopecks) / KOPECKS_PER_HRYVNIA; }
+
+    /**
+     * @brief Текстовий вигляд з двома знаками після крапки.
+     */
+    string ToString() const;
+
+    /**
+     * @brief Дописує ToString() у кінець рядка без проміжних рядків.
+     */
+    void AppendTo(string& output) const;
+
+    auto operator<=>(const Money& other) const = default;
+
+    Money& operator+=(Money other)
+    {
+        this->kopecks += other.kopecks;
+        return *this;
+    }
+
+    Money& operator-=(Money other)
+    {
+        this->kopecks -= other.kopecks;
+        return *this;
+    }
+
+    friend Money operator+(Money left, Money right) { return left += right; }
+    friend Money operator-(Money left, Money right) { return left -= right; }
+};
+
+ostream& operator<<(ostream& output, const Money& money);
\ No newline at end of file
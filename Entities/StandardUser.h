@@ -1,33 +0,0 @@
-#pragma once
-#include "BaseUser.h"
-#include <string>
-
-using namespace std;
-
- /**
-  * @class StandardUser
-  * @brief     ( ).
-  *
-  *  BaseUser    
-  *     .
-  */
-class StandardUser : public BaseUser
-{
-private:
-    string username;
-    string password;
-
-public:
-    /**
-     * @brief .
-     * @param username .
-     * @param password .
-     */
-    StandardUser(const string& username, const string& password);
-
-    string GetUsername() const override;
-    bool CheckPassword(const string& password) const override;
-    string GetUserType() const override;
-    string ToFileString() const override;
-    bool IsAdmin() const override;
-};
\ No newline at end of file
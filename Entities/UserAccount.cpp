@@ -0,0 +1,128 @@
+#include "UserAccount.h"
+#include "../Core/PasswordHasher.h"
+
+using namespace std;
+
+namespace
+{
+    const string TYPE_ADMIN = "Admin";
+    const string TYPE_LIBRARIAN = "Librarian";
+    const string TYPE_USER = "User";
+    const string TYPE_STANDARD_LEGACY = "Standard";
+    const char FIELD_SEPARATOR = ':';
+
+    constexpr UserAccount::PermissionMask bit(UserAccount::Permission permission)
+    {
+        return static_cast<UserAccount::PermissionMask>(permission);
+    }
+
+    const UserAccount::PermissionMask READER_PERMISSIONS =
+        bit(UserAccount::Permission::ViewCatalog) |
+        bit(UserAccount::Permission::SortCatalog) |
+        bit(UserAccount::Permission::BorrowBooks);
+
+    const UserAccount::PermissionMask LIBRARIAN_PERMISSIONS = READER_PERMISSIONS |
+        bit(UserAccount::Permission::IssueToOthers) |
+        bit(UserAccount::Permission::EditCatalog) |
+        bit(UserAccount::Permission::ImportExport) |
+        bit(UserAccount::Permission::ViewStatistics);
+
+    const UserAccount::PermissionMask ADMIN_PERMISSIONS = LIBRARIAN_PERMISSIONS |
+        bit(UserAccount::Permission::ManageUsers);
+}
+
+UserAccount::UserAccount(const string& username, const string& passwordHash, Role role)
+    : username(username), passwordHash(passwordHash), role(role)
+{
+}
+
+const string& UserAccount::GetUsername() const
+{
+    return this->username;
+}
+
+bool UserAccount::CheckPassword(const string& password) const
+{
+    return PasswordHasher::Verify(password, this->passwordHash);
+}
+
+bool UserAccount::NeedsRehash() const
+{
+    return !PasswordHasher::IsHash(this->passwordHash);
+}
+
+const string& UserAccount::GetPasswordHash() const
+{
+    return this->passwordHash;
+}
+
+UserAccount::Role UserAccount::GetRole() const
+{
+    return this->role;
+}
+
+bool UserAccount::IsAdmin() const
+{
+    return this->role == Role::Admin;
+}
+
+UserAccount::PermissionMask UserAccount::GetPermissions() const
+{
+    return GetRolePermissions(this->role);
+}
+
+UserAccount::PermissionMask UserAccount::GetRolePermissions(Role role)
+{
+    switch (role)
+    {
+    case Role::Admin: return ADMIN_PERMISSIONS;
+    case Role::Librarian: return LIBRARIAN_PERMISSIONS;
+    default: return READER_PERMISSIONS;
+    }
+}
+
+string UserAccount::GetRoleName(Role role)
+{
+    switch (role)
+    {
+    case Role::Admin: return TYPE_ADMIN;
+    case Role::Librarian: return TYPE_LIBRARIAN;
+    default: return TYPE_USER;
+    }
+}
+
+string UserAccount::GetUserType() const
+{
+    return GetRoleName(this->role);
+}
+
+string UserAccount::ToFileString() const
+{
+    return this->GetUserType() + FIELD_SEPARATOR + this->username + FIELD_SEPARATOR + this->passwordHash;
+}
+
+bool UserAccount::FromFileString(string_view line, UserAccount& account)
+{
+    size_t typeEnd = line.find(FIELD_SEPARATOR);
+    if (typeEnd == string_view::npos) return false;
+
+    size_t nameEnd = line.find(FIELD_SEPARATOR, typeEnd + 1);
+    if (nameEnd == string_view::npos) return false;
+
+    string_view type = line.substr(0, typeEnd);
+    Role role;
+    if (type == TYPE_ADMIN)
+        role = Role::Admin;
+    else if (type == TYPE_LIBRARIAN)
+        role = Role::Librarian;
+    else if (type == TYPE_USER || type == TYPE_STANDARD_LEGACY)
+        role = Role::Reader;
+    else
+        return false;
+
+    account = UserAccount(
+        string(line.substr(typeEnd + 1, nameEnd - typeEnd - 1)),
+        string(line.substr(nameEnd + 1)),
+        role);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class UserAccount
+  * @brief Обліковий запис користувача системи.
+  *
+  * Звичайне значення без віртуальних методів: записи всіх користувачів
+  * лежать підряд в одному масиві (UserDirectory), а роль задається
+  * полем, а не класом-нащадком. Права ролі - маска бітів Permission,
+  * тож перевірка доступу до операції - одна бітова операція. Пароль зберігається лише як хеш
+  * PasswordHasher; рядки паролів у відкритому вигляді зі старих файлів
+  * ще приймаються, доки їх не буде перехешовано.
+  */
+class UserAccount
+{
+public:
+    /**
+     * @brief Роль користувача.
+     */
+    enum class Role
+    {
+        Reader,
+        Librarian,
+        Admin
+    };
+
+    /**
+     * @brief Окремі права на операції (біти маски PermissionMask).
+     */
+    enum class Permission : uint32_t
+    {
+        ViewCatalog = 1u << 0,
+        SortCatalog = 1u << 1,
+        BorrowBooks = 1u << 2,
+        IssueToOthers = 1u << 3,
+        EditCatalog = 1u << 4,
+        ImportExport = 1u << 5,
+        ViewStatistics = 1u << 6,
+        ManageUsers = 1u << 7
+    };
+
+    /**
+     * @brief Набір прав: об'єднання бітів Permission.
+     */
+    using PermissionMask = uint32_t;
+
+private:
+    string username;
+    string passwordHash;
+    Role role;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param username Логін.
+     * @param passwordHash Збережений пароль (результат PasswordHasher::Hash()).
+     * @param role Роль користувача.
+     */
+    UserAccount(const string& username, const string& passwordHash, Role role);
+
+    const string& GetUsername() const;
+
+    /**
+     * @brief Перевіряє, чи наданий пароль є вірним.
+     * Повільна операція (PBKDF2), її варто виконувати поза блокуваннями.
+     * @param password Пароль для перевірки.
+     * @return true, якщо пароль вірний, інакше false.
+     */
+    bool CheckPassword(const string& password) const;
+
+    /**
+     * @brief Перевіряє, чи пароль ще збережено у відкритому вигляді.
+     */
+    bool NeedsRehash() const;
+
+    const string& GetPasswordHash() const;
+
+    Role GetRole() const;
+
+    /**
+     * @brief Перевіряє, чи має користувач права адміністратора.
+     */
+    bool IsAdmin() const;
+
+    /**
+     * @brief Отримує права ролі користувача.
+     */
+    PermissionMask GetPermissions() const;
+
+    /**
+     * @brief Отримує набір прав ролі.
+     */
+    static PermissionMask GetRolePermissions(Role role);
+
+    /**
+     * @brief Перевіряє, чи входить право до набору.
+     */
+    static bool HasPermission(PermissionMask permissions, Permission permission)
+    {
+        return (permissions & static_cast<PermissionMask>(permission)) != 0;
+    }
+
+    /**
+     * @brief Отримує назву типу ролі ("Admin", "Librarian" або "User").
+     */
+    static string GetRoleName(Role role);
+
+    /**
+     * @brief Отримує назву типу користувача ("Admin", "Librarian" або "User").
+     */
+    string GetUserType() const;
+
+    /**
+     * @brief Отримує рядок для збереження у файл ("Тип:логін:хеш").
+     */
+    string ToFileString() const;
+
+    /**
+     * @brief Розбирає рядок файлу користувачів (обернена до ToFileString()).
+     * @param line Рядок "Тип:логін:хеш"; тип "Admin", "Librarian", "User" або "Standard".
+     * @param account Сюди записується результат.
+     * @return false, якщо рядок пошкоджений або тип невідомий.
+     */
+    static bool FromFileString(string_view line, UserAccount& account);
+};
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include "AuthManager.h"
-#include "../Entities/StandardUser.h"
-#include "../Entities/AdminUser.h"
+#include "../Core/PasswordHasher.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <memory>
+#include <vector>
+#include <algorithm>
+#include <future>
+#include <thread>
 
 using namespace std;
 
@@ -12,245 +12,360 @@ namespace
 {
     const string ADMIN_USERNAME = "admin";
     const string ADMIN_DEFAULT_PASS = "admin123";
+
+    // Перевірки чекають у черзі не довше, ніж займає ця кількість хешувань
+    // на кожен потік пулу; надлишок відхиляється одразу.
+    const size_t VERIFIER_QUEUE_PER_THREAD = 8;
+
+    const chrono::seconds SESSION_IDLE_TIMEOUT(30 * 60);
+
+    // Логін: 5 спроб підряд, далі одна на 5 секунд.
+    const double USER_ATTEMPT_BURST = 5;
+    const double USER_ATTEMPTS_PER_SECOND = 0.2;
+
+    // Адреса клієнта: за нею може бути багато користувачів (NAT).
+    const double SOURCE_ATTEMPT_BURST = 30;
+    const double SOURCE_ATTEMPTS_PER_SECOND = 5;
+
+    const size_t MAX_RATE_LIMIT_KEYS = 100000;
+
+    /**
+     * @brief Кількість потоків перевірки паролів: половина ядер, щоб
+     * решта лишалася запитам до каталогу.
+     */
+    size_t verifierThreadCount()
+    {
+        size_t cores = thread::hardware_concurrency();
+        return max<size_t>(1, cores / 2);
+    }
 }
 
-AuthManager::AuthManager(const string& usersFilePath)
+AuthManager::AuthManager(const string& usersFilePath, bool loadNow)
     : usersFilePath(usersFilePath),
-    currentUser(nullptr)
+    directory(usersFilePath),
+    sessions(SESSION_IDLE_TIMEOUT),
+    userLimiter(USER_ATTEMPT_BURST, USER_ATTEMPTS_PER_SECOND, MAX_RATE_LIMIT_KEYS),
+    sourceLimiter(SOURCE_ATTEMPT_BURST, SOURCE_ATTEMPTS_PER_SECOND, MAX_RATE_LIMIT_KEYS),
+    verifierPool(verifierThreadCount(), verifierThreadCount() * VERIFIER_QUEUE_PER_THREAD)
 {
+    if (!loadNow) return;
+
+    this->loadStatus.Begin();
     try
     {
         this->loadUsers();
     }
     catch (const exception& e)
     {
-        cerr << ":     . " << e.what() << "\n";
+        cerr << "Помилка: Не вдалося завантажити файл користувачів. " << e.what() << "\n";
     }
+    this->loadStatus.Finish();
 }
 
-AuthManager::~AuthManager()
+AuthManager::LoginStatus AuthManager::Login(const string& username, const string& password, string& token,
+    const string& source)
 {
+    token.clear();
+
+    // Обмеження перевіряються до пошуку користувача та хешування пароля.
+    if ((!source.empty() && !this->sourceLimiter.TryAcquire(source)) ||
+        !this->userLimiter.TryAcquire(username))
+    {
+        return LoginStatus::RateLimited;
+    }
+
+    optional<UserAccount> account;
+    LoginStatus status = this->Authenticate(username, password, account);
+    if (status == LoginStatus::Success)
+    {
+        token = this->sessions.Create(account->GetUsername(), account->GetRole());
+    }
+    return status;
 }
 
-bool AuthManager::Login(const string& username, const string& password)
+AuthManager::LoginStatus AuthManager::Authenticate(const string& username, const string& password,
+    optional<UserAccount>& account)
 {
-    auto it = this->users.find(username);
+    account.reset();
+    this->loadStatus.Wait();
 
-    if (it != this->users.end())
+    optional<UserAccount> candidate;
+    {
+        shared_lock<shared_mutex> lock(this->usersMutex);
+        const UserAccount* found = this->directory.Find(username);
+        if (found != nullptr) candidate = *found;
+    }
+    if (!candidate)
     {
-        if (it->second->CheckPassword(password))
+        return LoginStatus::InvalidCredentials;
+    }
+
+    string upgradedHash;
+    LoginStatus status = this->verifyPassword(*candidate, password, upgradedHash);
+    if (status != LoginStatus::Success)
+    {
+        return status;
+    }
+
+    if (!upgradedHash.empty())
+    {
+        this->upgradePasswordHash(*candidate, upgradedHash);
+    }
+
+    account = move(candidate);
+    return LoginStatus::Success;
+}
+
+AuthManager::LoginStatus AuthManager::verifyPassword(const UserAccount& account,
+    const string& password, string& upgradedHash)
+{
+    promise<bool> verified;
+    future<bool> result = verified.get_future();
+
+    // Задача посилається на локальні змінні: це безпечно, бо ми чекаємо
+    // на її результат, а прийнята пулом задача виконується завжди.
+    bool accepted = this->verifierPool.TrySubmit([&account, &password, &upgradedHash, &verified]
         {
-            this->currentUser = it->second.get();
-            return true;
-        }
+            try
+            {
+                bool valid = account.CheckPassword(password);
+                if (valid && account.NeedsRehash())
+                {
+                    upgradedHash = PasswordHasher::Hash(password);
+                }
+                verified.set_value(valid);
+            }
+            catch (...)
+            {
+                verified.set_exception(current_exception());
+            }
+        });
+
+    if (!accepted)
+    {
+        return LoginStatus::Busy;
     }
+    return result.get() ? LoginStatus::Success : LoginStatus::InvalidCredentials;
+}
 
-    this->currentUser = nullptr;
-    return false;
+void AuthManager::upgradePasswordHash(const UserAccount& verified, const string& upgradedHash)
+{
+    unique_lock<shared_mutex> lock(this->usersMutex);
+
+    // Поки пароль перевірявся, адміністратор міг змінити чи видалити запис.
+    const UserAccount* current = this->directory.Find(verified.GetUsername());
+    if (current == nullptr || current->GetPasswordHash() != verified.GetPasswordHash())
+    {
+        return;
+    }
+
+    try
+    {
+        this->directory.Replace(UserAccount(verified.GetUsername(), upgradedHash, verified.GetRole()));
+    }
+    catch (const exception& e)
+    {
+        cerr << "Попередження: Не вдалося зберегти хеш пароля. " << e.what() << "\n";
+    }
 }
 
-void AuthManager::Logout()
+optional<SessionTable::SessionInfo> AuthManager::GetSession(const string& token)
 {
-    this->currentUser = nullptr;
+    return this->sessions.Find(token);
 }
 
-bool AuthManager::IsAdmin() const
+void AuthManager::Logout(const string& token)
 {
-    return this->IsLoggedIn() && this->currentUser->IsAdmin();
+    this->sessions.Remove(token);
 }
 
-bool AuthManager::IsLoggedIn() const
+bool AuthManager::HasPermission(const string& token, UserAccount::Permission permission)
 {
-    return this->currentUser != nullptr;
+    optional<SessionTable::SessionInfo> session = this->sessions.Find(token);
+    return session && UserAccount::HasPermission(session->permissions, permission);
 }
 
-string AuthManager::GetCurrentUser() const
+bool AuthManager::IsLoggedIn(const string& token)
 {
-    if (this->IsLoggedIn())
-    {
-        return this->currentUser->GetUsername();
-    }
-    return "";
+    return this->sessions.Find(token).has_value();
+}
+
+string AuthManager::GetCurrentUser(const string& token)
+{
+    optional<SessionTable::SessionInfo> session = this->sessions.Find(token);
+    return session ? session->username : "";
 }
 
 bool AuthManager::CreateUser(
+    const string& token,
     const string& username,
     const string& password,
-    bool isAdmin)
+    UserAccount::Role role)
 {
-    if (!this->IsAdmin())
+    if (!this->HasPermission(token, UserAccount::Permission::ManageUsers))
     {
-        cerr << ": ҳ    .\n";
+        cerr << "Помилка: Тільки адміністратор може створювати користувачів.\n";
         return false;
     }
 
     if (username.empty() || password.empty())
     {
-        cerr << ":       .\n";
+        cerr << "Помилка: Логін та пароль не можуть бути порожніми.\n";
         return false;
     }
 
-    if (this->users.find(username) != this->users.end())
-    {
-        cerr << ":  '" << username << "'  .\n";
-        return false;
-    }
-
-    unique_ptr<BaseUser> newUser;
-    if (isAdmin)
-    {
-        newUser = make_unique<AdminUser>(username, password);
-    }
-    else
-    {
-        newUser = make_unique<StandardUser>(username, password);
-    }
+    // Хешування повільне, тому виконується до захоплення блокування.
+    UserAccount account(username, PasswordHasher::Hash(password), role);
 
-    this->users[username] = move(newUser);
+    this->loadStatus.Wait();
+    unique_lock<shared_mutex> lock(this->usersMutex);
 
     try
     {
-        this->saveUsers();
-        cout << " '" << username << "'  .\n";
+        if (!this->directory.Add(account))
+        {
+            cerr << "Помилка: Користувач '" << username << "' вже існує.\n";
+            return false;
+        }
+        cout << "Користувача '" << username << "' успішно створено.\n";
         return true;
     }
     catch (const exception& e)
     {
-        cerr << ":     . " << e.what() << "\n";
-        this->users.erase(username);
+        cerr << "Помилка: Не вдалося зберегти файл користувачів. " << e.what() << "\n";
         return false;
     }
 }
 
-bool AuthManager::DeleteUser(const string& username)
+bool AuthManager::DeleteUser(const string& token, const string& username)
 {
-    if (!this->IsAdmin())
+    if (!this->HasPermission(token, UserAccount::Permission::ManageUsers))
     {
-        cerr << ": ҳ    .\n";
+        cerr << "Помилка: Тільки адміністратор може видаляти користувачів.\n";
         return false;
     }
 
     if (username == ADMIN_USERNAME)
     {
-        cerr << ":     .\n";
-        return false;
-    }
-
-    auto it = this->users.find(username);
-    if (it == this->users.end())
-    {
-        cerr << ":  '" << username << "'  .\n";
+        cerr << "Помилка: Неможливо видалити головний акаунт адміністратора.\n";
         return false;
     }
 
-    this->users.erase(it);
+    this->loadStatus.Wait();
+    unique_lock<shared_mutex> lock(this->usersMutex);
 
     try
     {
-        this->saveUsers();
-        cout << " '" << username << "'  .\n";
+        if (!this->directory.Remove(username))
+        {
+            cerr << "Помилка: Користувача '" << username << "' не знайдено.\n";
+            return false;
+        }
+        this->sessions.RemoveUser(username);
+        cout << "Користувача '" << username << "' успішно видалено.\n";
         return true;
     }
     catch (const exception& e)
     {
-        cerr << ":       . " << e.what() << "\n";
+        cerr << "Помилка: Не вдалося зберегти файл користувачів після видалення. " << e.what() << "\n";
         return false;
     }
 }
 
-void AuthManager::ListUsers() const
+void AuthManager::ListUsers(const string& token)
 {
-    if (!this->IsAdmin())
+    if (!this->HasPermission(token, UserAccount::Permission::ManageUsers))
     {
-        cerr << ": ҳ    .\n";
+        cerr << "Помилка: Тільки адміністратор може переглядати список.\n";
         return;
     }
 
-    for (const auto& pair : this->users)
+    this->loadStatus.Wait();
+    shared_lock<shared_mutex> lock(this->usersMutex);
+
+    // Довідник не впорядкований, а список виводиться за абеткою, як і раніше.
+    vector<const UserAccount*> sorted;
+    sorted.reserve(this->directory.GetCount());
+    for (const UserAccount& account : this->directory.GetAccounts())
     {
-        string type = pair.second->GetUserType();
-        string displayType = (type == "Admin") ? "" : "";
+        sorted.push_back(&account);
+    }
+    sort(sorted.begin(), sorted.end(),
+        [](const UserAccount* a, const UserAccount* b)
+        {
+            return a->GetUsername() < b->GetUsername();
+        });
 
-        cout << "- " << pair.second->GetUsername()
+    for (const UserAccount* account : sorted)
+    {
+        string displayType;
+        switch (account->GetRole())
+        {
+        case UserAccount::Role::Admin: displayType = "Адміністратор"; break;
+        case UserAccount::Role::Librarian: displayType = "Бібліотекар"; break;
+        default: displayType = "Читач"; break;
+        }
+
+        cout << "- " << account->GetUsername()
             << " [" << displayType << "]\n";
     }
 }
 
 void AuthManager::loadUsers()
 {
-    ifstream file(this->usersFilePath);
-    if (!file.is_open())
-    {
-        cout << "   .      ...\n";
+    unique_lock<shared_mutex> lock(this->usersMutex);
 
-        this->users[ADMIN_USERNAME] =
-            make_unique<AdminUser>(ADMIN_USERNAME, ADMIN_DEFAULT_PASS);
-
-        this->saveUsers();
+    if (!this->directory.Load())
+    {
+        cout << "Файл користувачів не знайдено. Створення нового з адміністратором за замовчуванням...\n";
+        this->ensureDefaultAdmin();
         return;
     }
 
-    string line;
-    int lineCount = 0;
-    while (getline(file, line))
+    if (this->directory.Find(ADMIN_USERNAME) == nullptr)
     {
-        lineCount++;
-        if (line.empty()) continue;
+        cout << "Адміністратора не знайдено. Додавання адміністратора за замовчуванням...\n";
+        this->ensureDefaultAdmin();
+    }
 
-        stringstream ss(line);
-        string userType, username, password;
+    cout << "Успішно завантажено " << this->directory.GetCount() << " користувачів.\n";
+}
 
-        if (getline(ss, userType, ':') &&
-            getline(ss, username, ':') &&
-            getline(ss, password))
-        {
-            if (userType == "Admin")
-            {
-                this->users[username] =
-                    make_unique<AdminUser>(username, password);
-            }
-            else if (userType == "User" || userType == "Standard")
-            {
-                this->users[username] =
-                    make_unique<StandardUser>(username, password);
-            }
-            else
-            {
-                cerr << ":   " << lineCount
-                    << " (  : " << userType << ")\n";
-            }
-        }
-        else
-        {
-            cerr << ":      "
-                << lineCount << "\n";
-        }
-    }
+void AuthManager::ensureDefaultAdmin()
+{
+    if (this->directory.Find(ADMIN_USERNAME) != nullptr) return;
 
-    if (this->users.find(ADMIN_USERNAME) == this->users.end())
-    {
-        cout << "  .    ...\n";
-        this->users[ADMIN_USERNAME] =
-            make_unique<AdminUser>(ADMIN_USERNAME, ADMIN_DEFAULT_PASS);
-        this->saveUsers();
-    }
+    this->directory.Add(UserAccount(ADMIN_USERNAME,
+        PasswordHasher::Hash(ADMIN_DEFAULT_PASS), UserAccount::Role::Admin));
+    this->directory.Compact();
+}
 
-    file.close();
-    cout << "  " << this->users.size() << " .\n";
+Task<void> AuthManager::LoadUsersAsync(Executor& executor)
+{
+    this->loadStatus.Begin();
+    return this->loadUsersInBackground(executor);
 }
 
-void AuthManager::saveUsers() const
+Task<void> AuthManager::loadUsersInBackground(Executor& executor)
 {
-    ofstream file(this->usersFilePath);
-    if (!file.is_open())
+    co_await executor.Schedule();
+
+    try
     {
-        throw runtime_error("      : "
-            + this->usersFilePath);
+        this->loadUsers();
     }
-
-    for (const auto& pair : this->users)
+    catch (const exception& e)
     {
-        file << pair.second->ToFileString() << "\n";
+        cerr << "Помилка: Не вдалося завантажити файл користувачів. " << e.what() << "\n";
     }
-    file.close();
+    this->loadStatus.Finish();
+}
+
+Task<void> AuthManager::SaveUsersAsync(Executor& executor)
+{
+    co_await executor.Schedule();
+
+    this->loadStatus.Wait();
+    unique_lock<shared_mutex> lock(this->usersMutex);
+    this->directory.Compact();
 }
\ No newline at end of file
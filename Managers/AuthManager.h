@@ -1,105 +1,201 @@
 #pragma once
-#include "../Entities/BaseUser.h"
+#include "UserDirectory.h"
+#include "SessionTable.h"
+#include "RateLimiter.h"
+#include "../Entities/UserAccount.h"
+#include "../Core/Task.h"
+#include "../Core/Executor.h"
+#include "../Core/LoadStatus.h"
+#include "../Core/WorkerPool.h"
 #include <string>
-#include <map>
-#include <memory>
+#include <optional>
+#include <shared_mutex>
 
 using namespace std;
 
  /**
   * @class AuthManager
-  * @brief      .
+  * @brief Керує всіма аспектами облікових записів користувачів.
   *
-  *  map   '- BaseUser
-  *     unique_ptr.
+  * Облікові записи зберігаються в UserDirectory: пошук при вході - O(1),
+  * а створення та видалення користувача дописують один рядок у журнал
+  * замість перезапису всього файлу.
+  *
+  * Вхід відкриває сесію з непрозорим токеном (SessionTable); усі
+  * перевірки прав виконуються за токеном, тож один процес може
+  * обслуговувати багато користувачів одночасно. Права ролі (читач,
+  * бібліотекар, адміністратор) зберігаються в сесії маскою бітів.
+  *
+  * Паролі зберігаються як хеші PBKDF2. Перевірка пароля навмисно повільна,
+  * тому виконується в окремому пулі з кількох потоків з обмеженою чергою:
+  * хвиля входів займає лише ці потоки, а не всі ядра, і при переповненні
+  * черги відразу отримує відмову (LoginStatus::Busy). Ще раніше, до
+  * будь-якого хешування, спроби входу обмежуються за логіном і за
+  * адресою клієнта (RateLimiter), тож підбір пароля не витрачає CPU.
   */
 class AuthManager
 {
+public:
+    /**
+     * @brief Результат перевірки облікових даних.
+     */
+    enum class LoginStatus
+    {
+        Success,
+        InvalidCredentials,
+        Busy,
+        RateLimited
+    };
+
 private:
     string usersFilePath;
-    map<string, unique_ptr<BaseUser>> users;
-    BaseUser* currentUser;
+    UserDirectory directory;
+    SessionTable sessions;
+    RateLimiter userLimiter;
+    RateLimiter sourceLimiter;
+    mutable shared_mutex usersMutex;
+    LoadStatus loadStatus;
+
+    // Оголошено останнім, щоб пул зупинявся раніше за довідник.
+    WorkerPool verifierPool;
 
 public:
     /**
-     * @brief .
-     * @param usersFilePath     (., "users.txt").
+     * @brief Конструктор.
+     * @param usersFilePath Шлях до файлу користувачів (напр., "users.txt").
+     * @param loadNow Якщо false, база завантажується пізніше через LoadUsersAsync().
      */
-    AuthManager(const string& usersFilePath);
+    AuthManager(const string& usersFilePath, bool loadNow = true);
+
+    AuthManager(const AuthManager&) = delete;
+    AuthManager& operator=(const AuthManager&) = delete;
 
     /**
-     * @brief .
-     *     unique_ptr.
+     * @brief Вхід у систему: перевіряє облікові дані та відкриває сесію.
+     * Сесій може бути скільки завгодно (напр., по одній на клієнта сервера).
+     * @param username Логін користувача.
+     * @param password Пароль користувача.
+     * @param token Сюди записується токен нової сесії при успіху.
+     * @param source Адреса клієнта для обмеження частоти (порожньо - не обмежувати за адресою).
+     * @return Success, InvalidCredentials, Busy, якщо черга перевірок заповнена,
+     * або RateLimited, якщо спроб з цим логіном чи адресою забагато.
      */
-    ~AuthManager();
+    LoginStatus Login(const string& username, const string& password, string& token,
+        const string& source = "");
 
-    AuthManager(const AuthManager&) = delete;
-    AuthManager& operator=(const AuthManager&) = delete;
+    /**
+     * @brief Перевіряє облікові дані, не відкриваючи сесії і без обмеження частоти.
+     * Пароль у відкритому вигляді зі старого файлу після успішного входу
+     * перехешовується та записується в журнал.
+     * @param username Логін користувача.
+     * @param password Пароль користувача.
+     * @param account Сюди записується копія облікового запису при успіху.
+     * @return Success, InvalidCredentials або Busy, якщо черга перевірок заповнена.
+     */
+    LoginStatus Authenticate(const string& username, const string& password,
+        optional<UserAccount>& account);
 
     /**
-     * @brief    .
-     * @param username  .
-     * @param password  .
-     * @return true,     ,  false.
+     * @brief Знаходить сесію за токеном і продовжує її строк.
+     * @return Дані сесії, або порожнє значення, якщо сесія закінчилась.
      */
-    bool Login(const string& username, const string& password);
+    optional<SessionTable::SessionInfo> GetSession(const string& token);
 
     /**
-     * @brief   .
+     * @brief Вихід із системи: закриває сесію.
      */
-    void Logout();
+    void Logout(const string& token);
 
     /**
-     * @brief ,     .
-     * @return true,    - ,  false.
+     * @brief Перевіряє, чи має користувач сесії право на операцію.
+     * Права обчислено при вході, тож це пошук сесії і одна бітова перевірка.
+     * @return true, якщо сесія активна і право є в її масці, інакше false.
      */
-    bool IsAdmin() const;
+    bool HasPermission(const string& token, UserAccount::Permission permission);
 
     /**
-     * @brief ,     .
-     * @return true,   ,  false.
+     * @brief Перевіряє, чи активна сесія.
+     * @return true, якщо сесія активна, інакше false.
      */
-    bool IsLoggedIn() const;
+    bool IsLoggedIn(const string& token);
 
     /**
-     * @brief  '  .
-     * @return      .
+     * @brief Отримує ім'я користувача сесії.
+     * @return Логін користувача або порожній рядок, якщо сесія закінчилась.
      */
-    string GetCurrentUser() const;
+    string GetCurrentUser(const string& token);
 
     /**
-     * @brief    (  ).
-     * @param username  .
-     * @param password  .
-     * @param isAdmin      .
-     * @return true,  , false -      .
+     * @brief Створює нового користувача (право ManageUsers).
+     * @param token Сесія, від імені якої виконується дія.
+     * @param username Новий логін.
+     * @param password Новий пароль.
+     * @param role Роль нового користувача.
+     * @return true, якщо успішно, false - якщо користувач існує або немає прав.
      */
     bool CreateUser(
+        const string& token,
         const string& username,
         const string& password,
-        bool isAdmin
+        UserAccount::Role role
     );
 
     /**
-     * @brief   (  ).
-     * @param username    .
-     * @return true,  , false -       .
+     * @brief Видаляє користувача (право ManageUsers) і закриває його сесії.
+     * @param token Сесія, від імені якої виконується дія.
+     * @param username Логін користувача для видалення.
+     * @return true, якщо успішно, false - якщо користувач не знайдений або немає прав.
      */
-    bool DeleteUser(const string& username);
+    bool DeleteUser(const string& token, const string& username);
 
     /**
-     * @brief      (  ).
+     * @brief Показує список всіх зареєстрованих користувачів (право ManageUsers).
+     * @param token Сесія, від імені якої виконується дія.
      */
-    void ListUsers() const;
+    void ListUsers(const string& token);
+
+    /**
+     * @brief Асинхронно завантажує базу користувачів.
+     * Вхід у систему до завершення завантаження чекає на нього.
+     * @param executor Виконавець для читання файлу.
+     */
+    Task<void> LoadUsersAsync(Executor& executor);
+
+    /**
+     * @brief Асинхронно ущільнює базу користувачів: переписує файл
+     * поточним станом і очищує журнал змін.
+     * @param executor Виконавець для фонового запису.
+     */
+    Task<void> SaveUsersAsync(Executor& executor);
 
 private:
     /**
-     * @brief     .
+     * @brief Завантажує базу користувачів з файлу.
      */
     void loadUsers();
 
     /**
-     * @brief      .
+     * @brief Корутина фонового завантаження (тіло LoadUsersAsync).
+     */
+    Task<void> loadUsersInBackground(Executor& executor);
+
+    /**
+     * @brief Перевіряє пароль у пулі перевірок і чекає на результат.
+     * @param account Обліковий запис (копія, без блокувань).
+     * @param password Пароль для перевірки.
+     * @param upgradedHash Новий хеш, якщо пароль був збережений відкрито.
+     */
+    LoginStatus verifyPassword(const UserAccount& account, const string& password,
+        string& upgradedHash);
+
+    /**
+     * @brief Зберігає новий хеш пароля, якщо запис не змінився з часу перевірки.
+     */
+    void upgradePasswordHash(const UserAccount& verified, const string& upgradedHash);
+
+    /**
+     * @brief Додає адміністратора за замовчуванням, якщо його немає.
+     * Викликається під unique_lock на usersMutex.
      */
-    void saveUsers() const;
+    void ensureDefaultAdmin();
 };
\ No newline at end of file
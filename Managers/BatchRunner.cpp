@@ -0,0 +1,450 @@
+#include "BatchRunner.h"
+#include "Library.h"
+#include "AuthManager.h"
+#include "../Core/ConsoleBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace std;
+
+namespace
+{
+    const string RESP_OK = "OK";
+    const string RESP_QUEUED = "OK QUEUED";
+    const string ERR_BAD_REQUEST = "ERR BAD_REQUEST";
+    const string ERR_UNKNOWN_COMMAND = "ERR UNKNOWN_COMMAND";
+    const string ERR_AUTH_REQUIRED = "ERR AUTH_REQUIRED";
+    const string ERR_AUTH_FAILED = "ERR AUTH_FAILED";
+    const string ERR_TRY_LATER = "ERR TRY_LATER";
+    const string ERR_RATE_LIMITED = "ERR RATE_LIMITED";
+    const string ERR_FORBIDDEN = "ERR FORBIDDEN";
+    const string ERR_NOT_FOUND = "ERR NOT_FOUND";
+    const string ERR_ALREADY_EXISTS = "ERR ALREADY_EXISTS";
+    const string ERR_BOOK_BUSY = "ERR BOOK_BUSY";
+    const string ERR_BOOK_AVAILABLE = "ERR BOOK_AVAILABLE";
+    const string ERR_IMPORT = "ERR IMPORT";
+    const string ERR_IO = "ERR IO";
+    const string ERR_NOT_LOADED = "ERR NOT_LOADED";
+    const string ERR_NO_TRANSACTION = "ERR NO_TRANSACTION";
+    const string ERR_IN_TRANSACTION = "ERR IN_TRANSACTION";
+    const char COMMENT_MARKER = '#';
+
+    /**
+     * @brief Відокремлює перше слово від решти рядка.
+     */
+    string nextToken(string& rest)
+    {
+        size_t start = rest.find_first_not_of(' ');
+        if (start == string::npos)
+        {
+            rest.clear();
+            return "";
+        }
+
+        size_t end = rest.find(' ', start);
+        string token = rest.substr(start, end == string::npos ? string::npos : end - start);
+
+        size_t next = (end == string::npos) ? string::npos : rest.find_first_not_of(' ', end);
+        rest = (next == string::npos) ? "" : rest.substr(next);
+        return token;
+    }
+
+    string toUpper(string value)
+    {
+        transform(value.begin(), value.end(), value.begin(),
+            [](unsigned char c) { return static_cast<char>(toupper(c)); });
+        return value;
+    }
+
+    string formatCommitError(const LibraryTransaction::CommitResult& result)
+    {
+        string code;
+        switch (result.status)
+        {
+        case LibraryTransaction::Status::NotFound: code = ERR_NOT_FOUND; break;
+        case LibraryTransaction::Status::AlreadyExists: code = ERR_ALREADY_EXISTS; break;
+        case LibraryTransaction::Status::BookBusy: code = ERR_BOOK_BUSY; break;
+        case LibraryTransaction::Status::BookAvailable: code = ERR_BOOK_AVAILABLE; break;
+        case LibraryTransaction::Status::InvalidRequest: code = ERR_BAD_REQUEST; break;
+        default: code = ERR_NOT_LOADED; break;
+        }
+        return code + " " + to_string(result.failedOperation + 1) + "\n";
+    }
+}
+
+BatchRunner::BatchRunner(Library* library, AuthManager* authManager)
+    : library(library), authManager(authManager), permissions(0), modified(false)
+{
+    if (this->library == nullptr || this->authManager == nullptr)
+    {
+        throw runtime_error("BatchRunner: Менеджери не ініціалізовані (null).");
+    }
+}
+
+BatchRunner::Summary BatchRunner::Run(istream& input, ostream& output)
+{
+    Summary summary;
+    ConsoleBuffer console(output);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    string line;
+    while (getline(input, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        size_t first = line.find_first_not_of(' ');
+        if (first == string::npos || line[first] == COMMENT_MARKER) continue;
+
+        summary.commands++;
+        if (!this->execute(line, console.GetBuffer())) summary.failed++;
+        console.FlushIfFull();
+    }
+
+    // Усі зміни прогону фіксуються одним записом файлу - і лише поверх
+    // повністю завантаженого каталогу.
+    if (this->modified)
+    {
+        this->library->WaitForLoad();
+        if (this->library->IsLoaded())
+        {
+            shared_lock<shared_mutex> lock(this->library->GetMutex());
+            this->library->SaveToFile();
+        }
+        else
+        {
+            cerr << "Помилка: Каталог завантажено не повністю, зміни не збережено.\n";
+        }
+    }
+    console.Flush();
+
+    summary.elapsedMilliseconds = chrono::duration<double, milli>(
+        chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+bool BatchRunner::execute(const string& line, string& output)
+{
+    string arguments = line;
+    string name = toUpper(nextToken(arguments));
+
+    string response;
+    if (name == "LOGIN")
+    {
+        response = this->executeLogin(arguments);
+    }
+    else if (name == "LOGOUT")
+    {
+        this->authManager->Logout(this->sessionToken);
+        this->sessionToken.clear();
+        this->username.clear();
+        this->permissions = 0;
+        this->transaction.reset();
+        response = RESP_OK + "\n";
+    }
+    else if (this->username.empty())
+    {
+        response = ERR_AUTH_REQUIRED + "\n";
+    }
+    else
+    {
+        // Пакетний режим не обслуговує запити під час завантаження, а
+        // дочікується повного каталогу; після нього це лише одна перевірка.
+        this->library->WaitForLoad();
+        try
+        {
+            response = this->executeCatalogCommand(name, arguments);
+        }
+        catch (const exception&)
+        {
+            response = ERR_BAD_REQUEST + "\n";
+        }
+    }
+
+    output += response;
+    return response.compare(0, 3, "ERR") != 0;
+}
+
+string BatchRunner::executeLogin(string& arguments)
+{
+    string login = nextToken(arguments);
+    if (login.empty() || arguments.empty()) return ERR_BAD_REQUEST + "\n";
+
+    string token;
+    AuthManager::LoginStatus status = this->authManager->Login(login, arguments, token);
+    if (status == AuthManager::LoginStatus::Busy) return ERR_TRY_LATER + "\n";
+    if (status == AuthManager::LoginStatus::RateLimited) return ERR_RATE_LIMITED + "\n";
+
+    optional<SessionTable::SessionInfo> session;
+    if (status == AuthManager::LoginStatus::Success)
+    {
+        session = this->authManager->GetSession(token);
+    }
+    if (!session) return ERR_AUTH_FAILED + "\n";
+
+    // Права читаються один раз: далі кожна команда - лише бітова перевірка.
+    this->authManager->Logout(this->sessionToken);
+    this->sessionToken = token;
+    this->username = session->username;
+    this->permissions = session->permissions;
+    return RESP_OK + " " + UserAccount::GetRoleName(session->role) + "\n";
+}
+
+string BatchRunner::executeCatalogCommand(const string& name, string& arguments)
+{
+    if (name == "BEGIN" || name == "COMMIT" || name == "ABORT")
+    {
+        return this->executeTransactionCommand(name);
+    }
+
+    if (name == "FIND")
+    {
+        if (!this->can(UserAccount::Permission::ViewCatalog)) return ERR_FORBIDDEN + "\n";
+        string article = nextToken(arguments);
+        if (article.empty()) return ERR_BAD_REQUEST + "\n";
+
+        shared_lock<shared_mutex> lock(this->library->GetMutex());
+        const Library* catalog = this->library;
+        const Book* book = catalog->FindBookByArticle(article);
+        if (book == nullptr) return ERR_NOT_FOUND + "\n";
+        return RESP_OK + " " + book->ToCsvString() + "\n";
+    }
+
+    if (name == "FILTER")
+    {
+        if (!this->can(UserAccount::Permission::ViewCatalog)) return ERR_FORBIDDEN + "\n";
+        string field = toUpper(nextToken(arguments));
+
+        shared_lock<shared_mutex> lock(this->library->GetMutex());
+
+        if (field == "AVAILABLE") return formatBookList(this->library->GetAvailableBooks());
+        if (field == "ISSUED") return formatBookList(this->library->GetIssuedBooks());
+        if (arguments.empty()) return ERR_BAD_REQUEST + "\n";
+
+        if (field == "AUTHOR") return formatBookList(this->library->FilterByAuthor(arguments));
+        if (field == "SHELF") return formatBookList(this->library->FilterByShelf(stoi(arguments)));
+        if (field == "PRICE")
+        {
+            Money minPrice = Money::Parse(nextToken(arguments));
+            Money maxPrice = Money::Parse(nextToken(arguments));
+            return formatBookList(this->library->FilterByPriceRange(minPrice, maxPrice));
+        }
+        if (field == "TITLE")
+        {
+            string fromTitle = nextToken(arguments);
+            string toTitle = nextToken(arguments);
+            if (toTitle.empty()) return ERR_BAD_REQUEST + "\n";
+            return formatBookList(this->library->FilterByTitleRange(fromTitle, toTitle));
+        }
+        return ERR_BAD_REQUEST + "\n";
+    }
+
+    if (name == "EXPORT")
+    {
+        if (!this->can(UserAccount::Permission::ImportExport)) return ERR_FORBIDDEN + "\n";
+        if (arguments.empty()) return ERR_BAD_REQUEST + "\n";
+
+        return this->library->ExportCsv(arguments) ? RESP_OK + "\n" : ERR_IO + "\n";
+    }
+
+    if (name == "SORT")
+    {
+        if (!this->can(UserAccount::Permission::SortCatalog)) return ERR_FORBIDDEN + "\n";
+        string field = toUpper(nextToken(arguments));
+
+        unique_lock<shared_mutex> lock(this->library->GetMutex());
+        if (field == "TITLE") this->library->SortByTitle();
+        else if (field == "AUTHOR") this->library->SortByAuthor();
+        else if (field == "PRICE") this->library->SortByPrice();
+        else return ERR_BAD_REQUEST + "\n";
+
+        this->modified = true;
+        return RESP_OK + "\n";
+    }
+
+    if (name == "ADD")
+    {
+        if (!this->can(UserAccount::Permission::EditCatalog)) return ERR_FORBIDDEN + "\n";
+        Book book = Book::FromCsvString(arguments);
+        if (book.GetId().empty()) return ERR_BAD_REQUEST + "\n";
+
+        if (this->transaction)
+        {
+            this->transaction->StageAdd(book);
+            return RESP_QUEUED + "\n";
+        }
+
+        unique_lock<shared_mutex> lock(this->library->GetMutex());
+        if (!this->library->AddBook(book)) return ERR_ALREADY_EXISTS + "\n";
+
+        this->modified = true;
+        return RESP_OK + "\n";
+    }
+
+    if (name == "UPDATE")
+    {
+        if (!this->can(UserAccount::Permission::EditCatalog)) return ERR_FORBIDDEN + "\n";
+        string article = nextToken(arguments);
+        Book book = Book::FromCsvString(arguments);
+        if (article.empty() || book.GetId().empty()) return ERR_BAD_REQUEST + "\n";
+
+        if (this->transaction)
+        {
+            this->transaction->StageUpdate(article, book);
+            return RESP_QUEUED + "\n";
+        }
+
+        unique_lock<shared_mutex> lock(this->library->GetMutex());
+        if (this->library->FindBookByArticle(article) == nullptr) return ERR_NOT_FOUND + "\n";
+        if (!this->library->UpdateBook(article, book)) return ERR_ALREADY_EXISTS + "\n";
+
+        this->modified = true;
+        return RESP_OK + "\n";
+    }
+
+    if (name == "DELETE")
+    {
+        if (!this->can(UserAccount::Permission::EditCatalog)) return ERR_FORBIDDEN + "\n";
+        string article = nextToken(arguments);
+        if (article.empty()) return ERR_BAD_REQUEST + "\n";
+
+        if (this->transaction)
+        {
+            this->transaction->StageDelete(article);
+            return RESP_QUEUED + "\n";
+        }
+
+        unique_lock<shared_mutex> lock(this->library->GetMutex());
+        if (!this->library->DeleteBook(article)) return ERR_NOT_FOUND + "\n";
+
+        this->modified = true;
+        return RESP_OK + "\n";
+    }
+
+    if (name == "IMPORT")
+    {
+        if (!this->can(UserAccount::Permission::ImportExport)) return ERR_FORBIDDEN + "\n";
+        if (arguments.empty()) return ERR_BAD_REQUEST + "\n";
+
+        Library::BulkResult result;
+        try
+        {
+            unique_lock<shared_mutex> lock(this->library->GetMutex());
+            result = this->library->ImportCsv(arguments, true);
+        }
+        catch (const exception&)
+        {
+            return ERR_IO + "\n";
+        }
+        if (!result.Succeeded())
+        {
+            // Як і в меню, пакет застосовується повністю або ніяк; у відповіді -
+            // кількість помилок і номер першого хибного рядка.
+            return ERR_IMPORT + " " + to_string(result.errors.size()) + " "
+                + to_string(result.errors.front().row) + "\n";
+        }
+
+        this->modified = this->modified || result.applied > 0;
+        return RESP_OK + " " + to_string(result.applied) + "\n";
+    }
+
+    if (name == "ISSUE" || name == "RETURN")
+    {
+        if (!this->can(UserAccount::Permission::BorrowBooks)) return ERR_FORBIDDEN + "\n";
+        string article = nextToken(arguments);
+        if (article.empty()) return ERR_BAD_REQUEST + "\n";
+
+        Library::LoanStatus status;
+        if (name == "ISSUE")
+        {
+            // Як і в інших інтерфейсах, на інше ПІБ видає лише персонал.
+            string readerName = this->username;
+            if (!arguments.empty())
+            {
+                if (!this->can(UserAccount::Permission::IssueToOthers)) return ERR_FORBIDDEN + "\n";
+                readerName = arguments;
+            }
+
+            if (this->transaction)
+            {
+                this->transaction->StageIssue(article, readerName);
+                return RESP_QUEUED + "\n";
+            }
+
+            unique_lock<shared_mutex> lock(this->library->GetMutex());
+            status = this->library->IssueBook(article, readerName);
+        }
+        else
+        {
+            if (this->transaction)
+            {
+                this->transaction->StageReturn(article);
+                return RESP_QUEUED + "\n";
+            }
+
+            unique_lock<shared_mutex> lock(this->library->GetMutex());
+            status = this->library->ReturnBook(article);
+        }
+
+        if (status == Library::LoanStatus::NotFound) return ERR_NOT_FOUND + "\n";
+        if (status == Library::LoanStatus::AlreadyIssued) return ERR_BOOK_BUSY + "\n";
+        if (status == Library::LoanStatus::NotIssued) return ERR_BOOK_AVAILABLE + "\n";
+        if (status == Library::LoanStatus::ReaderNameTooLong) return ERR_BAD_REQUEST + "\n";
+
+        this->modified = true;
+        return RESP_OK + "\n";
+    }
+
+    return ERR_UNKNOWN_COMMAND + "\n";
+}
+
+string BatchRunner::executeTransactionCommand(const string& name)
+{
+    if (name == "BEGIN")
+    {
+        if (this->transaction) return ERR_IN_TRANSACTION + "\n";
+
+        this->transaction = make_unique<LibraryTransaction>(*this->library);
+        return RESP_OK + "\n";
+    }
+
+    if (!this->transaction) return ERR_NO_TRANSACTION + "\n";
+
+    if (name == "ABORT")
+    {
+        this->transaction.reset();
+        return RESP_OK + "\n";
+    }
+
+    // COMMIT
+    size_t operationCount = this->transaction->GetOperationCount();
+    LibraryTransaction::CommitResult result;
+    {
+        unique_lock<shared_mutex> lock(this->library->GetMutex());
+        result = this->transaction->Commit();
+    }
+    this->transaction.reset();
+
+    if (!result.Succeeded()) return formatCommitError(result);
+
+    this->modified = this->modified || operationCount > 0;
+    return RESP_OK + " " + to_string(operationCount) + "\n";
+}
+
+bool BatchRunner::can(UserAccount::Permission permission) const
+{
+    return UserAccount::HasPermission(this->permissions, permission);
+}
+
+string BatchRunner::formatBookList(const vector<Book>& books)
+{
+    string response = RESP_OK + " " + to_string(books.size()) + "\n";
+    for (const Book& book : books)
+    {
+        response += book.ToCsvString();
+        response += '\n';
+    }
+    return response;
+}
\ No newline at end of file
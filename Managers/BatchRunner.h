@@ -0,0 +1,95 @@
+#pragma once
+#include "../Entities/UserAccount.h"
+#include "LibraryTransaction.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstddef>
+#include <memory>
+
+using namespace std;
+
+class Library;
+class AuthManager;
+class Book;
+
+ /**
+  * @class BatchRunner
+  * @brief Неінтерактивний (пакетний) інтерфейс до Library та AuthManager.
+  *
+  * Читає команди з потоку по одній на рядок і виконує їх без жодних
+  * запитів до користувача. Результати друкуються у форматі, зручному
+  * для скриптів (як у QueryServer): "OK [дані]" або "ERR <код>", списки -
+  * "OK <n>" і далі n рядків CSV. Порожні рядки та рядки з '#' пропускаються.
+  *
+  * Команди:
+  *  LOGIN <логін> <пароль> | LOGOUT
+  *  ADD <артикул>,<автор>,<назва>,<ціна>,<полиця> | FIND <артикул>
+  *  FILTER AUTHOR <автор> | FILTER SHELF <номер> | FILTER PRICE <від> <до>
+  *  FILTER TITLE <від> <до> | FILTER AVAILABLE | FILTER ISSUED
+  *  UPDATE <артикул> <артикул>,<автор>,<назва>,<ціна>,<полиця> | DELETE <артикул>
+  *  SORT TITLE|AUTHOR|PRICE | ISSUE <артикул> [ПІБ] | RETURN <артикул>
+  *  IMPORT <файл> | EXPORT <файл>
+  *  BEGIN | COMMIT | ABORT - між BEGIN і COMMIT команди ADD, UPDATE, DELETE,
+  *  ISSUE і RETURN лише накопичуються ("OK QUEUED") і фіксуються разом або
+  *  не фіксуються зовсім ("ERR <код> <номер операції>"). Транзакцію, не
+  *  зафіксовану до кінця вводу, буде відкинуто.
+  *
+  * Команди каталогу вимагають входу та відповідного права ролі. Зміни
+  * записуються у файл даних один раз - після останньої команди.
+  */
+class BatchRunner
+{
+public:
+    /**
+     * @struct Summary
+     * @brief Підсумок прогону.
+     */
+    struct Summary
+    {
+        size_t commands = 0;
+        size_t failed = 0;
+        double elapsedMilliseconds = 0;
+    };
+
+private:
+    Library* library;
+    AuthManager* authManager;
+    string sessionToken;
+    string username;
+    UserAccount::PermissionMask permissions;
+    bool modified;
+    unique_ptr<LibraryTransaction> transaction;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param library Вказівник на екземпляр Library.
+     * @param authManager Вказівник на екземпляр AuthManager.
+     */
+    BatchRunner(Library* library, AuthManager* authManager);
+
+    /**
+     * @brief Виконує всі команди з input і друкує результати в output.
+     * @return Кількість команд, помилок і час виконання.
+     */
+    Summary Run(istream& input, ostream& output);
+
+private:
+    /**
+     * @brief Виконує одну команду і дописує відповідь у кінець output.
+     * @return false, якщо відповідь - "ERR".
+     */
+    bool execute(const string& line, string& output);
+
+    string executeLogin(string& arguments);
+    string executeCatalogCommand(const string& name, string& arguments);
+    string executeTransactionCommand(const string& name);
+
+    /**
+     * @brief Перевіряє право поточної сесії (бітова перевірка маски).
+     */
+    bool can(UserAccount::Permission permission) const;
+
+    static string formatBookList(const vector<Book>& books);
+};
\ No newline at end of file
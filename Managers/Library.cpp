@@ -4,33 +4,142 @@
 #include <sstream>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
 
 using namespace std;
 
-Library::Library(const string& dataFilePath)
-    : dataFilePath(dataFilePath)
+namespace
 {
+    const size_t LOAD_CHUNK_ROWS = 4096;
+    const string INDEX_FILE_SUFFIX = ".idx";
+    const string INDEX_FILE_MAGIC = "LIBRARY-IDX-1";
+
+    // Пакет, більший за 1/8 каталогу, вигідніше проіндексувати перебудовою.
+    const size_t ORDERED_REBUILD_RATIO = 8;
+
+    const string BULK_ERR_EMPTY_ARTICLE = "порожній артикул";
+    const string BULK_ERR_EXISTS = "артикул вже існує";
+    const string BULK_ERR_NOT_FOUND = "книгу не знайдено";
+    const string BULK_ERR_DUPLICATE = "артикул повторюється в пакеті";
+    const string BULK_ERR_NEGATIVE_PRICE = "від'ємна ціна";
+    const string BULK_ERR_BAD_ROW = "пошкоджений рядок";
+
+    const string STATS_KEY_AVAILABLE = "Доступні";
+    const string STATS_KEY_ISSUED = "Видані";
+
+    /**
+     * @brief Дописує записи рядками CSV і запам'ятовує зсув кожного рядка.
+     */
+    template<Storable Record>
+    void appendCsvRows(const vector<Record>& records, string& content, vector<pair<string, uint64_t>>& offsets)
+    {
+        offsets.reserve(offsets.size() + records.size());
+        for (const Record& record : records)
+        {
+            offsets.emplace_back(record.GetId(), content.size());
+            content += record.ToCsvString();
+            content += '\n';
+        }
+    }
+
+    /**
+     * @brief Перетинає списки позицій, починаючи з найкоротшого.
+     */
+    RoaringBitmap intersectPostings(vector<const RoaringBitmap*>& postings)
+    {
+        sort(postings.begin(), postings.end(),
+            [](const RoaringBitmap* a, const RoaringBitmap* b)
+            {
+                return a->Cardinality() < b->Cardinality();
+            }
+        );
+
+        RoaringBitmap result = RoaringBitmap::And(*postings[0], *postings[1]);
+        for (size_t i = 2; i < postings.size() && !result.IsEmpty(); i++)
+        {
+            result &= *postings[i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Розбирає один рядок CSV у запис.
+     * @return false, якщо рядок порожній або пошкоджений (з попередженням).
+     */
+    template<Storable Record>
+    bool parseCsvRow(const string& line, Record& record)
+    {
+        if (line.empty()) return false;
+
+        try
+        {
+            record = Record::FromCsvString(line);
+            return true;
+        }
+        catch (const invalid_argument&)
+        {
+            cerr << "Попередження: Пропущено пошкоджені дані (невірний формат числа): "
+                 << line << "\n";
+        }
+        catch (const out_of_range&)
+        {
+             cerr << "Попередження: Пропущено пошкоджені дані (число за межами діапазону): "
+                 << line << "\n";
+        }
+        catch (const length_error&)
+        {
+            cerr << "Попередження: Пропущено пошкоджені дані (поле довше за "
+                 << Book::MAX_FIELD_LENGTH << " символів), рядок довжиною "
+                 << line.size() << "\n";
+        }
+        return false;
+    }
+}
+
+Library::Library(const string& dataFilePath, bool loadNow)
+    : dataFilePath(dataFilePath),
+    version(0),
+    changeCount(0),
+    savedChangeCount(0)
+{
+    if (!loadNow) return;
+
     try
     {
         this->LoadFromFile();
     }
     catch (const exception& e)
     {
-        cerr << ":     . " << e.what() << "\n";
+        cerr << "Помилка: Не вдалося завантажити файл даних. " << e.what() << "\n";
+        this->loadStatus.Fail();
     }
 }
 
 Library::~Library()
 {
+    this->WaitForLoad();
+    if (this->loadStatus.Get() == LoadStatus::State::Failed)
+    {
+        cerr << "Каталог завантажено з помилкою: файл " << this->dataFilePath
+             << " не перезаписано.\n";
+    }
+    if (this->loadStatus.Get() != LoadStatus::State::Loaded
+        || this->changeCount == this->savedChangeCount)
+    {
+        return;
+    }
+
     try
     {
         this->SaveToFile();
-        cout << "      " 
+        cout << "Дані бібліотеки успішно збережено у файл " 
              << this->dataFilePath << "\n";
     }
     catch (const exception& e)
     {
-        cerr << ":     . " << e.what() << "\n";
+        cerr << "Помилка: Не вдалося зберегти файл даних. " << e.what() << "\n";
     }
 }
 
@@ -38,109 +147,506 @@ bool Library::AddBook(const Book& book)
 {
     if (this->FindBookByArticle(book.GetId()) != nullptr)
     {
-        cerr << ":    " 
-             << book.GetId() << "  .\n";
+        cerr << "Помилка: Книга з артикулом " 
+             << book.GetId() << " вже існує.\n";
         return false;
     }
     
+    this->articleIndex[book.GetId()] = this->books.size();
     this->books.push_back(book);
+    this->indexBook(book);
+    this->postBook(this->books.size() - 1);
+    this->MarkModified();
     return true;
 }
 
 bool Library::DeleteBook(const string& article)
 {
-    auto it = find_if(
-        this->books.begin(),
-        this->books.end(),
-        [&article](const Book& b) { return b.GetId() == article; }
-    );
-
-    if (it != this->books.end())
+    auto it = this->articleIndex.find(article);
+    if (it == this->articleIndex.end())
     {
-        this->books.erase(it);
-        return true;
+        return false;
     }
 
-    return false;
+    this->unindexBook(this->books[it->second]);
+    this->books.erase(this->books.begin() + it->second);
+    this->rebuildIndex();
+    this->MarkModified();
+    return true;
 }
 
 bool Library::UpdateBook(const string& article, const Book& newBookData)
 {
-    Book* bookToUpdate = this->FindBookByArticle(article);
-    if (bookToUpdate != nullptr)
+    auto it = this->articleIndex.find(article);
+    if (it == this->articleIndex.end())
+    {
+        return false;
+    }
+
+    size_t position = it->second;
+    const string& newArticle = newBookData.GetId();
+    if (newArticle != article)
+    {
+        if (this->articleIndex.count(newArticle) > 0)
+        {
+            cerr << "Помилка: Книга з артикулом "
+                 << newArticle << " вже існує.\n";
+            return false;
+        }
+        this->articleIndex.erase(it);
+        this->articleIndex[newArticle] = position;
+    }
+
+    this->unindexBook(this->books[position]);
+    this->unpostBook(position);
+    this->books[position] = newBookData;
+    this->indexBook(newBookData);
+    this->postBook(position);
+    this->MarkModified();
+    return true;
+}
+
+Library::BulkResult Library::BulkAdd(const vector<Book>& batch, bool allOrNothing)
+{
+    BulkResult result;
+    vector<bool> valid = this->validateBulkAdd(batch, result);
+
+    if (allOrNothing && !result.Succeeded())
     {
-        *bookToUpdate = newBookData;
-        return true;
+        return result;
     }
-    return false;
+
+    result.applied = this->applyBulkAdd(batch, valid);
+    return result;
 }
 
-Book* Library::FindBookByArticle(const string& article)
+Library::BulkResult Library::BulkUpdate(const vector<Book>& batch, bool allOrNothing)
 {
-    auto it = find_if(
-        this->books.begin(),
-        this->books.end(),
-        [&article](const Book& b) { return b.GetId() == article; }
-    );
+    BulkResult result;
+    vector<bool> valid(batch.size(), false);
+    unordered_set<string> seen;
+    seen.reserve(batch.size());
+
+    for (size_t row = 0; row < batch.size(); row++)
+    {
+        const Book& book = batch[row];
+        const string& article = book.GetId();
+
+        if (book.GetExactPrice() < Money())
+            result.errors.push_back({ row, article, BULK_ERR_NEGATIVE_PRICE });
+        else if (this->articleIndex.count(article) == 0)
+            result.errors.push_back({ row, article, BULK_ERR_NOT_FOUND });
+        else if (!seen.insert(article).second)
+            result.errors.push_back({ row, article, BULK_ERR_DUPLICATE });
+        else
+            valid[row] = true;
+    }
+
+    if (allOrNothing && !result.Succeeded())
+    {
+        return result;
+    }
+
+    size_t updateCount = batch.size() - result.errors.size();
+    bool rebuildSecondary = this->shouldRebuildSecondaryIndexes(updateCount);
+
+    for (size_t row = 0; row < batch.size(); row++)
+    {
+        if (!valid[row]) continue;
+
+        size_t position = this->articleIndex.at(batch[row].GetId());
+        Book& target = this->books[position];
+        if (!rebuildSecondary) this->unindexBook(target);
+        this->unpostBook(position);
+        target = batch[row];
+        if (!rebuildSecondary) this->indexBook(target);
+        this->postBook(position);
+    }
+
+    if (rebuildSecondary) this->rebuildSecondaryIndexes();
+    if (updateCount > 0) this->MarkModified();
+    result.applied = updateCount;
+    return result;
+}
+
+Library::BulkResult Library::BulkDelete(const vector<string>& articles, bool allOrNothing)
+{
+    BulkResult result;
+    vector<bool> doomed(this->books.size(), false);
+    unordered_set<string> seen;
+    seen.reserve(articles.size());
+
+    for (size_t row = 0; row < articles.size(); row++)
+    {
+        const string& article = articles[row];
+        auto it = this->articleIndex.find(article);
+
+        if (it == this->articleIndex.end())
+            result.errors.push_back({ row, article, BULK_ERR_NOT_FOUND });
+        else if (!seen.insert(article).second)
+            result.errors.push_back({ row, article, BULK_ERR_DUPLICATE });
+        else
+            doomed[it->second] = true;
+    }
+
+    if (allOrNothing && !result.Succeeded())
+    {
+        return result;
+    }
+
+    size_t deleteCount = articles.size() - result.errors.size();
+    bool rebuildSecondary = this->shouldRebuildSecondaryIndexes(deleteCount);
+
+    // Один прохід ущільнення замість erase() для кожної книги.
+    size_t kept = 0;
+    for (size_t i = 0; i < this->books.size(); i++)
+    {
+        if (doomed[i])
+        {
+            if (!rebuildSecondary) this->unindexBook(this->books[i]);
+            continue;
+        }
+        if (kept != i) this->books[kept] = std::move(this->books[i]);
+        kept++;
+    }
+    this->books.resize(kept);
+
+    this->rebuildIndex();
+    if (rebuildSecondary) this->rebuildSecondaryIndexes();
+    if (deleteCount > 0) this->MarkModified();
+    result.applied = deleteCount;
+    return result;
+}
+
+Library::BulkResult Library::ImportCsv(const string& filePath, bool allOrNothing)
+{
+    BulkResult result;
+
+    ifstream file(filePath, ios::binary);
+    if (!file.is_open())
+    {
+        throw runtime_error("Не вдалося відкрити файл " + filePath);
+    }
+
+    vector<Book> batch;
+    vector<size_t> lineNumbers;
+    string line;
+    size_t lineNumber = 0;
+    while (getline(file, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        try
+        {
+            batch.push_back(Book::FromCsvString(line));
+            lineNumbers.push_back(lineNumber);
+        }
+        catch (const exception&)
+        {
+            result.errors.push_back({ lineNumber, line.substr(0, line.find(',')), BULK_ERR_BAD_ROW });
+        }
+    }
+
+    // Перевіряємо весь файл, навіть якщо вже є пошкоджені рядки,
+    // щоб звіт містив усі помилки одразу.
+    size_t parseErrorCount = result.errors.size();
+    vector<bool> valid = this->validateBulkAdd(batch, result);
+    for (size_t i = parseErrorCount; i < result.errors.size(); i++)
+    {
+        result.errors[i].row = lineNumbers[result.errors[i].row];
+    }
+    sort(result.errors.begin(), result.errors.end(),
+        [](const BulkError& a, const BulkError& b) { return a.row < b.row; });
+
+    if (allOrNothing && !result.Succeeded())
+    {
+        return result;
+    }
+
+    result.applied = this->applyBulkAdd(batch, valid);
+    return result;
+}
+
+bool Library::ExportCsv(const string& filePath) const
+{
+    shared_ptr<const LibrarySnapshot> snapshot = this->OpenSnapshot();
+    if (!this->IsLoaded())
+    {
+        throw runtime_error("Каталог ще не завантажено повністю: "
+                            + this->dataFilePath);
+    }
+
+    ofstream file(filePath, ios::binary | ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    for (const Book& book : snapshot->books)
+    {
+        file << book.ToCsvString() << '\n';
+    }
+    return static_cast<bool>(file);
+}
 
-    if (it != this->books.end())
+Book* Library::FindBookByArticle(const string& article)
+{
+    auto it = this->articleIndex.find(article);
+    if (it != this->articleIndex.end())
     {
-        return &(*it);
+        return &this->books[it->second];
     }
 
-    return nullptr;
+    unique_lock<mutex> lazyLock;
+    return this->pageInBook(article, lazyLock);
 }
 
 const Book* Library::FindBookByArticle(const string& article) const
 {
-    auto it = find_if(
-        this->books.cbegin(),
-        this->books.cend(),
-        [&article](const Book& b) { return b.GetId() == article; }
-    );
+    auto it = this->articleIndex.find(article);
+    if (it != this->articleIndex.end())
+    {
+        return &this->books[it->second];
+    }
+
+    return this->pageInBook(article);
+}
+
+vector<const Book*> Library::FindBooksByArticles(const vector<string>& articles) const
+{
+    vector<const Book*> results;
+    results.reserve(articles.size());
+    for (const string& article : articles)
+    {
+        results.push_back(this->FindBookByArticle(article));
+    }
+    return results;
+}
 
-    if (it != this->books.cend())
+Library::LoanStatus Library::IssueBook(const string& article, const string& readerName)
+{
+    // Перевірка - до будь-яких змін: задовге ПІБ не вмістилося б у Book
+    // уже після того, як книгу прибрано з індексу видач.
+    if (readerName.size() > Book::MAX_FIELD_LENGTH) return LoanStatus::ReaderNameTooLong;
+
+    auto it = this->articleIndex.find(article);
+    if (it == this->articleIndex.end())
     {
-        return &(*it);
+        // Під час прогресивного завантаження книга може бути лише
+        // підвантаженою копією: змінюється вона, а в каталог (з усіма
+        // індексами) потрапить разом зі своїм блоком.
+        unique_lock<mutex> lazyLock;
+        Book* lazy = this->pageInBook(article, lazyLock);
+        if (lazy == nullptr) return LoanStatus::NotFound;
+        if (!lazy->IsAvailable()) return LoanStatus::AlreadyIssued;
+
+        lazy->IssueToReader(readerName);
+        this->MarkModified();
+        return LoanStatus::Done;
     }
 
-    return nullptr;
+    Book& book = this->books[it->second];
+    if (!book.IsAvailable()) return LoanStatus::AlreadyIssued;
+
+    uint32_t row = static_cast<uint32_t>(it->second);
+    this->unindexLoan(book);
+    book.IssueToReader(readerName);
+    this->indexLoan(book);
+    removeFromGroup(this->availableGroup, row, book.GetExactPrice());
+    addToGroup(this->issuedGroup, row, book.GetExactPrice());
+    this->MarkModified();
+    return LoanStatus::Done;
 }
 
-vector<Book> Library::FilterByAuthor(const string& authorName) const
+Library::LoanStatus Library::ReturnBook(const string& article)
 {
-    vector<Book> results;
-    for (const Book& book : this->books)
+    auto it = this->articleIndex.find(article);
+    if (it == this->articleIndex.end())
+    {
+        unique_lock<mutex> lazyLock;
+        Book* lazy = this->pageInBook(article, lazyLock);
+        if (lazy == nullptr) return LoanStatus::NotFound;
+        if (lazy->IsAvailable()) return LoanStatus::NotIssued;
+
+        lazy->ReturnToLibrary();
+        this->MarkModified();
+        return LoanStatus::Done;
+    }
+
+    Book& book = this->books[it->second];
+    if (book.IsAvailable()) return LoanStatus::NotIssued;
+
+    uint32_t row = static_cast<uint32_t>(it->second);
+    this->unindexLoan(book);
+    book.ReturnToLibrary();
+    this->indexLoan(book);
+    removeFromGroup(this->issuedGroup, row, book.GetExactPrice());
+    addToGroup(this->availableGroup, row, book.GetExactPrice());
+    this->MarkModified();
+    return LoanStatus::Done;
+}
+
+vector<Book> Library::GetLoansByReader(const string& readerName) const
+{
+    auto it = this->loansByReader.find(readerName);
+    if (it == this->loansByReader.end())
+    {
+        return {};
+    }
+    return this->collectInCatalogOrder(it->second);
+}
+
+vector<Book> Library::GetAvailableBooks() const
+{
+    return this->collectRows(this->availableGroup.rows);
+}
+
+vector<Book> Library::GetIssuedBooks() const
+{
+    return this->collectRows(this->issuedGroup.rows);
+}
+
+vector<Book> Library::FilterBooks(const BookQuery& query) const
+{
+    vector<const RoaringBitmap*> postings;
+    if (!this->selectPostings(query, postings)) return {};
+    if (postings.empty()) return this->books;
+    if (postings.size() == 1) return this->collectRows(*postings.front());
+
+    return this->collectRows(intersectPostings(postings));
+}
+
+size_t Library::CountBooks(const BookQuery& query) const
+{
+    vector<const RoaringBitmap*> postings;
+    if (!this->selectPostings(query, postings)) return 0;
+    if (postings.empty()) return this->books.size();
+    if (postings.size() == 1) return postings.front()->Cardinality();
+
+    return intersectPostings(postings).Cardinality();
+}
+
+vector<Library::GroupStats> Library::GetStatistics(GroupBy groupBy) const
+{
+    vector<GroupStats> results;
+
+    if (groupBy == GroupBy::Availability)
+    {
+        results.push_back({ STATS_KEY_AVAILABLE, this->readGroupStats(this->availableGroup) });
+        results.push_back({ STATS_KEY_ISSUED, this->readGroupStats(this->issuedGroup) });
+        return results;
+    }
+
+    if (groupBy == GroupBy::Shelf)
     {
-        if (book.GetAuthorName() == authorName)
+        vector<int> shelves;
+        shelves.reserve(this->shelfGroups.size());
+        for (const auto& group : this->shelfGroups) shelves.push_back(group.first);
+        sort(shelves.begin(), shelves.end());
+
+        results.reserve(shelves.size());
+        for (int shelf : shelves)
         {
-            results.push_back(book);
+            results.push_back({ to_string(shelf), this->readGroupStats(this->shelfGroups.at(shelf)) });
         }
+        return results;
+    }
+
+    results.reserve(this->authorGroups.size());
+    for (const auto& group : this->authorGroups)
+    {
+        results.push_back({ group.first, this->readGroupStats(group.second) });
     }
+    sort(results.begin(), results.end(),
+        [](const GroupStats& a, const GroupStats& b) { return a.key < b.key; });
     return results;
 }
 
+Library::PriceStats Library::GetTotals() const
+{
+    PriceStats available = this->readGroupStats(this->availableGroup);
+    PriceStats issued = this->readGroupStats(this->issuedGroup);
+    if (available.count == 0) return issued;
+    if (issued.count == 0) return available;
+
+    PriceStats totals;
+    totals.count = available.count + issued.count;
+    totals.sum = available.sum + issued.sum;
+    totals.min = min(available.min, issued.min);
+    totals.max = max(available.max, issued.max);
+    return totals;
+}
+
+vector<pair<string, size_t>> Library::GetTopReaders(size_t limit) const
+{
+    vector<pair<string, size_t>> readers;
+    readers.reserve(this->loansByReader.size());
+    for (const auto& reader : this->loansByReader)
+    {
+        readers.emplace_back(reader.first, reader.second.size());
+    }
+
+    auto byLoans = [](const pair<string, size_t>& a, const pair<string, size_t>& b)
+    {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    limit = min(limit, readers.size());
+    partial_sort(readers.begin(), readers.begin() + limit, readers.end(), byLoans);
+    readers.resize(limit);
+    return readers;
+}
+
+vector<Book> Library::FilterByAuthor(const string& authorName) const
+{
+    BookQuery query;
+    query.authorName = authorName;
+    return this->FilterBooks(query);
+}
+
 vector<Book> Library::FilterByShelf(int shelfNumber) const
+{
+    BookQuery query;
+    query.shelfNumber = shelfNumber;
+    return this->FilterBooks(query);
+}
+
+vector<Book> Library::FilterByPriceRange(Money minPrice, Money maxPrice) const
 {
     vector<Book> results;
-    for (const Book& book : this->books)
+    if (maxPrice < minPrice) return results;
+
+    // Порожній артикул - найменший, тож нижня межа захоплює всі книги з ціною minPrice.
+    pair<Money, string> from(minPrice, "");
+    for (auto it = this->priceIndex.LowerBound(from); it != this->priceIndex.end(); ++it)
     {
-        if (book.GetShelfNumber() == shelfNumber)
-        {
-            results.push_back(book);
-        }
+        if (it->first > maxPrice) break;
+        results.push_back(this->books[this->articleIndex.at(it->second)]);
+    }
+    return results;
+}
+
+vector<Book> Library::FilterByTitleRange(const string& fromTitle, const string& toTitle) const
+{
+    vector<Book> results;
+
+    // Порожній рядок - префікс будь-якої назви: така верхня межа
+    // пропустила б усе після fromTitle, тож діапазон вважається порожнім.
+    if (toTitle.empty()) return results;
+
+    pair<string, string> from(fromTitle, "");
+    for (auto it = this->titleIndex.LowerBound(from); it != this->titleIndex.end(); ++it)
+    {
+        const string& title = it->first;
+        if (title > toTitle && title.compare(0, toTitle.size(), toTitle) != 0) break;
+        results.push_back(this->books[this->articleIndex.at(it->second)]);
     }
     return results;
 }
 
 void Library::SortByTitle()
 {
-    sort(this->books.begin(), this->books.end(),
-        [](const Book& a, const Book& b)
-        {
-            return a.GetBookTitle() < b.GetBookTitle();
-        }
-    );
+    this->reorderByIndex(this->titleIndex);
 }
 
 void Library::SortByAuthor()
@@ -151,16 +657,13 @@ void Library::SortByAuthor()
             return a.GetAuthorName() < b.GetAuthorName();
         }
     );
+    this->rebuildIndex();
+    this->MarkModified();
 }
 
 void Library::SortByPrice()
 {
-    sort(this->books.begin(), this->books.end(),
-        [](const Book& a, const Book& b)
-        {
-            return a.GetPrice() < b.GetPrice();
-        }
-    );
+    this->reorderByIndex(this->priceIndex);
 }
 
 const vector<Book>& Library::GetAllBooks() const
@@ -168,6 +671,42 @@ const vector<Book>& Library::GetAllBooks() const
     return this->books;
 }
 
+size_t Library::GetBookCount() const
+{
+    return this->books.size();
+}
+
+vector<Book> Library::GetPage(size_t offset, size_t count, PageOrder order) const
+{
+    vector<Book> page;
+    if (offset >= this->books.size()) return page;
+
+    count = min(count, this->books.size() - offset);
+    page.reserve(count);
+
+    if (order == PageOrder::Title)
+    {
+        auto it = this->titleIndex.At(offset);
+        for (; page.size() < count && it != this->titleIndex.end(); ++it)
+        {
+            page.push_back(this->books[this->articleIndex.at(it->second)]);
+        }
+    }
+    else if (order == PageOrder::Price)
+    {
+        auto it = this->priceIndex.At(offset);
+        for (; page.size() < count && it != this->priceIndex.end(); ++it)
+        {
+            page.push_back(this->books[this->articleIndex.at(it->second)]);
+        }
+    }
+    else
+    {
+        page.assign(this->books.begin() + offset, this->books.begin() + offset + count);
+    }
+    return page;
+}
+
 bool Library::IsEmpty() const
 {
     return this->books.empty();
@@ -175,72 +714,709 @@ bool Library::IsEmpty() const
 
 void Library::LoadFromFile()
 {
+    this->loadStatus.Begin();
+
     ifstream file(this->dataFilePath);
     if (!file.is_open())
     {
-        cout << "   .      .\n";
+        cout << "Файл даних не знайдено. Новий файл буде створено при першій зміні.\n";
+        this->loadStatus.Finish();
         return;
     }
 
     string line;
+    Book book;
     while (getline(file, line))
     {
-        if (line.empty()) continue;
-
-        stringstream ss(line);
-        string field;
-        
-        string article, authorName, bookTitle, readerFullName;
-        double price;
-        int shelfNumber;
-
-        try
+        if (parseCsvRow(line, book))
         {
-            getline(ss, article, ',');
-            getline(ss, authorName, ',');
-            getline(ss, bookTitle, ',');
-            
-            getline(ss, field, ',');
-            price = stod(field);
-            
-            getline(ss, field, ',');
-            shelfNumber = stoi(field);
+            this->appendLoadedBook(std::move(book));
+        }
+    }
+    file.close();
+    this->loadStatus.Finish();
+    cout << "Успішно завантажено " << this->books.size() << " книг.\n";
+}
 
-            getline(ss, readerFullName, ',');
+void Library::SaveToFile() const
+{
+    this->writeDataFile(this->buildCsv());
+}
 
-            this->books.push_back(Book(
-                article, authorName, bookTitle,
-                price, shelfNumber, readerFullName
-            ));
-        }
-        catch (const invalid_argument& e)
+uint64_t Library::GetVersion() const
+{
+    return this->version.load();
+}
+
+void Library::MarkModified()
+{
+    this->version++;
+    this->changeCount++;
+}
+
+shared_ptr<const LibrarySnapshot> Library::OpenSnapshot() const
+{
+    this->WaitForLoad();
+
+    // Один будівник за раз: одночасні звіти отримають той самий знімок.
+    lock_guard<mutex> snapshotLock(this->snapshotMutex);
+    shared_lock<shared_mutex> lock(this->catalogMutex);
+
+    uint64_t current = this->version.load();
+    auto it = this->snapshots.find(current);
+    if (it != this->snapshots.end())
+    {
+        shared_ptr<const LibrarySnapshot> existing = it->second.lock();
+        if (existing) return existing;
+    }
+
+    auto snapshot = make_shared<LibrarySnapshot>();
+    snapshot->version = current;
+    snapshot->books = this->books;
+    lock.unlock();
+
+    for (auto entry = this->snapshots.begin(); entry != this->snapshots.end();)
+    {
+        if (entry->second.expired()) entry = this->snapshots.erase(entry);
+        else ++entry;
+    }
+    this->snapshots[current] = snapshot;
+    return snapshot;
+}
+
+shared_mutex& Library::GetMutex() const
+{
+    return this->catalogMutex;
+}
+
+Task<size_t> Library::LoadAsync(Executor& executor)
+{
+    // Стан змінюється ще до старту корутини, щоб WaitForLoad()
+    // одразу бачив, що завантаження почалося.
+    this->loadStatus.Begin();
+    this->indexStatus.Begin();
+    return this->loadChunksAsync(executor);
+}
+
+Task<size_t> Library::loadChunksAsync(Executor& executor)
+{
+    co_await executor.Schedule();
+
+    unordered_map<string, uint64_t> offsets;
+    if (this->readIndexFile(offsets))
+    {
+        lock_guard<mutex> lock(this->lazyMutex);
+        this->pendingOffsets = move(offsets);
+    }
+    this->indexStatus.Finish();
+
+    size_t loadedCount = 0;
+    bool failed = false;
+    try
+    {
+        ifstream file(this->dataFilePath);
+        if (file.is_open())
         {
-            cerr << ":    (  ): " 
-                 << line << "\n";
+            vector<Book> chunk;
+            chunk.reserve(LOAD_CHUNK_ROWS);
+
+            string line;
+            Book book;
+            bool hasMore = true;
+            while (hasMore)
+            {
+                hasMore = static_cast<bool>(getline(file, line));
+                if (hasMore && parseCsvRow(line, book))
+                {
+                    chunk.push_back(std::move(book));
+                }
+
+                if (chunk.size() == LOAD_CHUNK_ROWS || (!hasMore && !chunk.empty()))
+                {
+                    unique_lock<shared_mutex> lock(this->catalogMutex);
+                    lock_guard<mutex> lazyLock(this->lazyMutex);
+                    for (Book& loaded : chunk)
+                    {
+                        // Книга, підвантажена раніше на вимогу, могла вже
+                        // змінитися (напр., її видали) - беремо її версію.
+                        this->pendingOffsets.erase(loaded.GetId());
+                        auto lazy = this->lazyBooks.find(loaded.GetId());
+                        if (lazy != this->lazyBooks.end())
+                        {
+                            loaded = std::move(lazy->second);
+                            this->lazyBooks.erase(lazy);
+                        }
+
+                        if (this->appendLoadedBook(std::move(loaded))) loadedCount++;
+                    }
+                    chunk.clear();
+                }
+            }
         }
-        catch (const out_of_range& e)
+    }
+    catch (const exception& e)
+    {
+        cerr << "Помилка: Не вдалося завантажити файл даних. " << e.what() << "\n";
+        failed = true;
+    }
+
+    {
+        unique_lock<shared_mutex> lock(this->catalogMutex);
+        lock_guard<mutex> lazyLock(this->lazyMutex);
+        for (auto& lazy : this->lazyBooks)
         {
-             cerr << ":    (   ): " 
-                 << line << "\n";
+            this->appendLoadedBook(std::move(lazy.second));
         }
+        this->lazyBooks.clear();
+        this->pendingOffsets.clear();
     }
-    file.close();
-    cout << "  " << this->books.size() << " .\n";
+
+    // Частковий каталог лишається доступним для читання, але не
+    // зберігається: інакше він перезаписав би повний файл даних.
+    if (failed) this->loadStatus.Fail();
+    else this->loadStatus.Finish();
+    co_return loadedCount;
 }
 
-void Library::SaveToFile()
+Task<void> Library::SaveAsync(Executor& executor) const
 {
-    ofstream file(this->dataFilePath);
-    if (!file.is_open())
+    co_await executor.Schedule();
+
+    this->WaitForLoad();
+
+    CsvSnapshot snapshot;
     {
-        throw runtime_error("     : " 
-                            + this->dataFilePath);
+        shared_lock<shared_mutex> lock(this->catalogMutex);
+        snapshot = this->buildCsv();
+    }
+    this->writeDataFile(snapshot);
+}
+
+Task<optional<Book>> Library::FindBookAsync(Executor& executor, string article) const
+{
+    co_await executor.Schedule();
+
+    shared_lock<shared_mutex> lock(this->catalogMutex);
+    const Book* book = this->FindBookByArticle(article);
+    if (book == nullptr)
+    {
+        co_return nullopt;
+    }
+    co_return *book;
+}
+
+Task<vector<Book>> Library::FilterByAuthorAsync(Executor& executor, string authorName) const
+{
+    co_await executor.Schedule();
+
+    shared_lock<shared_mutex> lock(this->catalogMutex);
+    co_return this->FilterByAuthor(authorName);
+}
+
+Task<vector<Book>> Library::FilterByShelfAsync(Executor& executor, int shelfNumber) const
+{
+    co_await executor.Schedule();
+
+    shared_lock<shared_mutex> lock(this->catalogMutex);
+    co_return this->FilterByShelf(shelfNumber);
+}
+
+void Library::WaitForLoad() const
+{
+    this->loadStatus.Wait();
+}
+
+bool Library::IsLoading() const
+{
+    return this->loadStatus.Get() == LoadStatus::State::Loading;
+}
+
+bool Library::IsLoaded() const
+{
+    return this->loadStatus.Get() == LoadStatus::State::Loaded;
+}
+
+bool Library::appendLoadedBook(Book&& book)
+{
+    if (this->articleIndex.count(book.GetId()) > 0)
+    {
+        cerr << "Попередження: Пропущено дублікат артикулу: "
+             << book.GetId() << "\n";
+        return false;
+    }
+
+    this->articleIndex[book.GetId()] = this->books.size();
+    this->indexBook(book);
+    this->books.push_back(std::move(book));
+    this->postBook(this->books.size() - 1);
+
+    // Прочитаний рядок змінює вміст для знімків, але не потребує запису у файл.
+    this->version++;
+    return true;
+}
+
+void Library::indexBook(const Book& book)
+{
+    this->priceIndex.Insert({ book.GetExactPrice(), book.GetId() });
+    this->titleIndex.Insert({ book.GetBookTitle(), book.GetId() });
+    this->indexLoan(book);
+}
+
+void Library::unindexBook(const Book& book)
+{
+    this->priceIndex.Erase({ book.GetExactPrice(), book.GetId() });
+    this->titleIndex.Erase({ book.GetBookTitle(), book.GetId() });
+    this->unindexLoan(book);
+}
+
+void Library::indexLoan(const Book& book)
+{
+    if (book.IsAvailable()) return;
+
+    this->loansByReader[book.GetReaderFullName()].insert(book.GetId());
+}
+
+void Library::unindexLoan(const Book& book)
+{
+    if (book.IsAvailable()) return;
+
+    auto reader = this->loansByReader.find(book.GetReaderFullName());
+    if (reader != this->loansByReader.end())
+    {
+        reader->second.erase(book.GetId());
+        if (reader->second.empty()) this->loansByReader.erase(reader);
+    }
+}
+
+void Library::postBook(size_t position)
+{
+    const Book& book = this->books[position];
+    uint32_t row = static_cast<uint32_t>(position);
+    Money price = book.GetExactPrice();
+
+    addToGroup(this->shelfGroups[book.GetShelfNumber()], row, price);
+    addToGroup(this->authorGroups[book.GetAuthorName()], row, price);
+    addToGroup(book.IsAvailable() ? this->availableGroup : this->issuedGroup, row, price);
+}
+
+void Library::unpostBook(size_t position)
+{
+    const Book& book = this->books[position];
+    uint32_t row = static_cast<uint32_t>(position);
+    Money price = book.GetExactPrice();
+
+    this->removeFromGroups(this->shelfGroups, book.GetShelfNumber(), row, price);
+    this->removeFromGroups(this->authorGroups, book.GetAuthorName(), row, price);
+    removeFromGroup(book.IsAvailable() ? this->availableGroup : this->issuedGroup, row, price);
+}
+
+void Library::rebuildPostings()
+{
+    this->availableGroup = BookGroup();
+    this->issuedGroup = BookGroup();
+    this->shelfGroups.clear();
+    this->authorGroups.clear();
+
+    for (size_t i = 0; i < this->books.size(); i++)
+    {
+        this->postBook(i);
+    }
+}
+
+void Library::addToGroup(BookGroup& group, uint32_t row, Money price)
+{
+    group.rows.Add(row);
+
+    PriceStats& stats = group.stats;
+    bool first = stats.count == 0;
+    stats.count++;
+    stats.sum += price;
+    if (group.extremesStale) return;
+
+    if (first || price < stats.min)
+    {
+        stats.min = price;
+        group.minCount = 1;
+    }
+    else if (price == stats.min)
+    {
+        group.minCount++;
+    }
+
+    if (first || price > stats.max)
+    {
+        stats.max = price;
+        group.maxCount = 1;
+    }
+    else if (price == stats.max)
+    {
+        group.maxCount++;
+    }
+}
+
+void Library::removeFromGroup(BookGroup& group, uint32_t row, Money price)
+{
+    if (!group.rows.Remove(row)) return;
+
+    PriceStats& stats = group.stats;
+    stats.count--;
+    stats.sum -= price;
+    if (stats.count == 0)
+    {
+        stats = PriceStats();
+        group.minCount = 0;
+        group.maxCount = 0;
+        group.extremesStale = false;
+        return;
+    }
+    if (group.extremesStale) return;
+
+    // Нове крайнє значення знайде лише перебір групи - його відкладено
+    // до читання статистики, щоб видача не перебирала весь каталог.
+    if (price == stats.min && --group.minCount == 0) group.extremesStale = true;
+    if (price == stats.max && --group.maxCount == 0) group.extremesStale = true;
+}
+
+Library::PriceStats Library::readGroupStats(const BookGroup& group) const
+{
+    lock_guard<mutex> lock(this->statsMutex);
+    if (group.extremesStale)
+    {
+        PriceStats& stats = group.stats;
+        bool first = true;
+        group.rows.ForEach([this, &group, &stats, &first](uint32_t row)
+            {
+                Money price = this->books[row].GetExactPrice();
+                if (first || price < stats.min)
+                {
+                    stats.min = price;
+                    group.minCount = 0;
+                }
+                if (first || price > stats.max)
+                {
+                    stats.max = price;
+                    group.maxCount = 0;
+                }
+                if (price == stats.min) group.minCount++;
+                if (price == stats.max) group.maxCount++;
+                first = false;
+            });
+        group.extremesStale = false;
+    }
+    return group.stats;
+}
+
+template<typename Key>
+void Library::removeFromGroups(unordered_map<Key, BookGroup>& groups, const Key& key, uint32_t row, Money price)
+{
+    auto group = groups.find(key);
+    if (group == groups.end()) return;
+
+    removeFromGroup(group->second, row, price);
+    if (group->second.rows.IsEmpty()) groups.erase(group);
+}
+
+bool Library::selectPostings(const BookQuery& query, vector<const RoaringBitmap*>& postings) const
+{
+    if (query.shelfNumber)
+    {
+        auto it = this->shelfGroups.find(*query.shelfNumber);
+        if (it == this->shelfGroups.end()) return false;
+        postings.push_back(&it->second.rows);
+    }
+    if (query.authorName)
+    {
+        auto it = this->authorGroups.find(*query.authorName);
+        if (it == this->authorGroups.end()) return false;
+        postings.push_back(&it->second.rows);
+    }
+    if (query.available)
+    {
+        postings.push_back(*query.available ? &this->availableGroup.rows : &this->issuedGroup.rows);
+    }
+    return true;
+}
+
+vector<Book> Library::collectRows(const RoaringBitmap& rows) const
+{
+    vector<Book> results;
+    results.reserve(rows.Cardinality());
+    rows.ForEach([this, &results](uint32_t row) { results.push_back(this->books[row]); });
+    return results;
+}
+
+template<typename Articles>
+vector<Book> Library::collectInCatalogOrder(const Articles& articles) const
+{
+    vector<size_t> positions;
+    positions.reserve(articles.size());
+    for (const string& article : articles)
+    {
+        auto it = this->articleIndex.find(article);
+        if (it != this->articleIndex.end()) positions.push_back(it->second);
+    }
+    sort(positions.begin(), positions.end());
+
+    vector<Book> results;
+    results.reserve(positions.size());
+    for (size_t position : positions)
+    {
+        results.push_back(this->books[position]);
+    }
+    return results;
+}
+
+void Library::restoreBookAt(size_t position, const Book& book)
+{
+    position = min(position, this->books.size());
+    this->books.insert(this->books.begin() + position, book);
+    this->rebuildIndex();
+    this->indexBook(book);
+    this->MarkModified();
+}
+
+vector<bool> Library::validateBulkAdd(const vector<Book>& batch, BulkResult& result) const
+{
+    vector<bool> valid(batch.size(), false);
+    unordered_set<string> seen;
+    seen.reserve(batch.size());
+
+    for (size_t row = 0; row < batch.size(); row++)
+    {
+        const Book& book = batch[row];
+        const string& article = book.GetId();
+
+        if (article.empty())
+            result.errors.push_back({ row, article, BULK_ERR_EMPTY_ARTICLE });
+        else if (book.GetExactPrice() < Money())
+            result.errors.push_back({ row, article, BULK_ERR_NEGATIVE_PRICE });
+        else if (this->articleIndex.count(article) > 0)
+            result.errors.push_back({ row, article, BULK_ERR_EXISTS });
+        else if (!seen.insert(article).second)
+            result.errors.push_back({ row, article, BULK_ERR_DUPLICATE });
+        else
+            valid[row] = true;
+    }
+    return valid;
+}
+
+size_t Library::applyBulkAdd(const vector<Book>& batch, const vector<bool>& valid)
+{
+    size_t addCount = count(valid.begin(), valid.end(), true);
+    bool rebuildSecondary = this->shouldRebuildSecondaryIndexes(addCount);
+    this->books.reserve(this->books.size() + addCount);
+    this->articleIndex.reserve(this->books.size() + addCount);
+
+    for (size_t row = 0; row < batch.size(); row++)
+    {
+        if (!valid[row]) continue;
+
+        this->articleIndex[batch[row].GetId()] = this->books.size();
+        this->books.push_back(batch[row]);
+        if (!rebuildSecondary) this->indexBook(batch[row]);
+        this->postBook(this->books.size() - 1);
+    }
+
+    if (rebuildSecondary) this->rebuildSecondaryIndexes();
+    if (addCount > 0) this->MarkModified();
+    return addCount;
+}
+
+void Library::rebuildSecondaryIndexes()
+{
+    vector<pair<Money, string>> priceKeys;
+    vector<pair<string, string>> titleKeys;
+    priceKeys.reserve(this->books.size());
+    titleKeys.reserve(this->books.size());
+
+    for (const Book& book : this->books)
+    {
+        priceKeys.emplace_back(book.GetExactPrice(), book.GetId());
+        titleKeys.emplace_back(book.GetBookTitle(), book.GetId());
     }
+    sort(priceKeys.begin(), priceKeys.end());
+    sort(titleKeys.begin(), titleKeys.end());
 
+    this->priceIndex.Assign(priceKeys);
+    this->titleIndex.Assign(titleKeys);
+
+    this->loansByReader.clear();
     for (const Book& book : this->books)
     {
-        file << book.ToCsvString() << "\n";
+        this->indexLoan(book);
+    }
+}
+
+bool Library::shouldRebuildSecondaryIndexes(size_t batchSize) const
+{
+    return batchSize * ORDERED_REBUILD_RATIO >= this->books.size();
+}
+
+template<typename Tree>
+void Library::reorderByIndex(const Tree& index)
+{
+    vector<Book> ordered;
+    ordered.reserve(this->books.size());
+    for (const auto& key : index)
+    {
+        ordered.push_back(std::move(this->books[this->articleIndex.at(key.second)]));
+    }
+    this->books = std::move(ordered);
+    this->rebuildIndex();
+    this->MarkModified();
+}
+
+Library::CsvSnapshot Library::buildCsv() const
+{
+    if (this->loadStatus.Get() != LoadStatus::State::Loaded)
+    {
+        throw runtime_error("Каталог ще не завантажено повністю: "
+                            + this->dataFilePath);
+    }
+
+    CsvSnapshot snapshot;
+    appendCsvRows(this->books, snapshot.content, snapshot.offsets);
+    snapshot.changeCount = this->changeCount;
+    return snapshot;
+}
+
+void Library::writeDataFile(const CsvSnapshot& snapshot) const
+{
+    lock_guard<mutex> lock(this->fileMutex);
+
+    // Двійковий режим: зсуви в індексі мають збігатися з байтами файлу.
+    ofstream file(this->dataFilePath, ios::binary);
+    if (!file.is_open())
+    {
+        throw runtime_error("Не вдалося відкрити файл для запису: " 
+                            + this->dataFilePath);
     }
 
+    file << snapshot.content;
     file.close();
+    if (!file)
+    {
+        throw runtime_error("Не вдалося записати файл: " + this->dataFilePath);
+    }
+    this->savedChangeCount = snapshot.changeCount;
+
+    ofstream index(this->getIndexFilePath(), ios::binary);
+    if (!index.is_open())
+    {
+        cerr << "Попередження: Не вдалося записати індекс " << this->getIndexFilePath() << "\n";
+        return;
+    }
+
+    index << INDEX_FILE_MAGIC << " " << snapshot.content.size() << "\n";
+    for (const auto& entry : snapshot.offsets)
+    {
+        index << entry.first << "\t" << entry.second << "\n";
+    }
+}
+
+string Library::getIndexFilePath() const
+{
+    return this->dataFilePath + INDEX_FILE_SUFFIX;
+}
+
+bool Library::readIndexFile(unordered_map<string, uint64_t>& offsets) const
+{
+    ifstream index(this->getIndexFilePath(), ios::binary);
+    ifstream data(this->dataFilePath, ios::binary | ios::ate);
+    if (!index.is_open() || !data.is_open())
+    {
+        return false;
+    }
+
+    // Індекс дійсний, лише якщо розмір файлу даних не змінився з часу запису.
+    string magic;
+    uint64_t dataSize = 0;
+    if (!(index >> magic >> dataSize) || magic != INDEX_FILE_MAGIC ||
+        dataSize != static_cast<uint64_t>(data.tellg()))
+    {
+        return false;
+    }
+    index.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    string line;
+    while (getline(index, line))
+    {
+        size_t tab = line.find('\t');
+        if (tab == string::npos) continue;
+
+        try
+        {
+            offsets[line.substr(0, tab)] = stoull(line.substr(tab + 1));
+        }
+        catch (const exception&)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const Book* Library::pageInBook(const string& article) const
+{
+    if (this->loadStatus.Get() != LoadStatus::State::Loading)
+    {
+        return nullptr;
+    }
+    this->indexStatus.Wait();
+
+    lock_guard<mutex> lock(this->lazyMutex);
+    return this->findLazyBook(article);
+}
+
+Book* Library::pageInBook(const string& article, unique_lock<mutex>& lock)
+{
+    if (this->loadStatus.Get() != LoadStatus::State::Loading)
+    {
+        return nullptr;
+    }
+    this->indexStatus.Wait();
+
+    lock = unique_lock<mutex>(this->lazyMutex);
+    return this->findLazyBook(article);
+}
+
+Book* Library::findLazyBook(const string& article) const
+{
+    auto lazy = this->lazyBooks.find(article);
+    if (lazy != this->lazyBooks.end())
+    {
+        return &lazy->second;
+    }
+
+    auto pending = this->pendingOffsets.find(article);
+    if (pending == this->pendingOffsets.end())
+    {
+        return nullptr;
+    }
+
+    ifstream file(this->dataFilePath, ios::binary);
+    file.seekg(static_cast<streamoff>(pending->second));
+
+    string line;
+    if (!getline(file, line)) return nullptr;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    Book book;
+    if (!parseCsvRow(line, book) || book.GetId() != article)
+    {
+        return nullptr;
+    }
+
+    return &this->lazyBooks.emplace(article, std::move(book)).first->second;
+}
+
+void Library::rebuildIndex()
+{
+    this->articleIndex.clear();
+    this->articleIndex.reserve(this->books.size());
+    for (size_t i = 0; i < this->books.size(); i++)
+    {
+        this->articleIndex[this->books[i].GetId()] = i;
+    }
+    this->rebuildPostings();
 }
\ No newline at end of file
@@ -1,112 +1,723 @@
 #pragma once
 #include "../Entities/Book.h"
+#include "../Core/Task.h"
+#include "../Core/Executor.h"
+#include "../Core/LoadStatus.h"
+#include "../Core/BPlusTree.h"
+#include "../Core/RoaringBitmap.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <set>
+#include <optional>
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <map>
+#include <atomic>
 
 using namespace std;
 
+ /**
+  * @struct LibrarySnapshot
+  * @brief Незмінний знімок каталогу на момент певної версії.
+  */
+struct LibrarySnapshot
+{
+    uint64_t version;
+    vector<Book> books;
+};
+
  /**
   * @class Library
-  * @brief -     .
+  * @brief Менеджер-клас для управління базою даних книг.
   *
-  * ³  , , , ,
-  *        .
+  * Відповідає за зберігання, пошук, фільтрацію, сортування,
+  * а також завантаження та збереження даних у файл.
+  *
+  * Синхронні методи самі нічого не блокують: якщо з бібліотекою
+  * працюють кілька потоків, викликач тримає GetMutex() (спільно для
+  * читання, ексклюзивно для змін). Async-методи блокують самі.
+  * Кілька змін, що мають застосуватися разом, групує LibraryTransaction.
+  * Довгі звіти (зокрема ExportCsv()) читають незмінний знімок
+  * (OpenSnapshot()), не тримаючи блокування, тож зміни під час звіту
+  * не чекають на нього.
   */
 class Library
 {
+    // Транзакції відкочують видалення на те саме місце в каталозі.
+    friend class LibraryTransaction;
+
+public:
+    /**
+     * @struct PriceStats
+     * @brief Підсумки цін групи книг.
+     */
+    struct PriceStats
+    {
+        size_t count = 0;
+        Money sum;
+        Money min;
+        Money max;
+
+        double Average() const { return this->count == 0 ? 0 : this->sum.ToDouble() / this->count; }
+    };
+
+    /**
+     * @brief Ознака, за якою групується статистика.
+     */
+    enum class GroupBy
+    {
+        Shelf,
+        Author,
+        Availability
+    };
+
+    /**
+     * @struct GroupStats
+     * @brief Статистика однієї групи: значення ознаки та підсумки.
+     */
+    struct GroupStats
+    {
+        string key;
+        PriceStats stats;
+    };
+
 private:
+    /**
+     * @brief Група книг: позиції в books та підсумки їх цін.
+     *
+     * Кількість і сума оновлюються за O(1). Для мінімуму й максимуму
+     * рахується, скільки книг мають таку ціну; коли йде остання з них,
+     * крайнє значення позначається застарілим і перераховується при
+     * наступному читанні статистики, а не під час зміни каталогу.
+     */
+    struct BookGroup
+    {
+        RoaringBitmap rows;
+        mutable PriceStats stats;
+        mutable size_t minCount = 0;
+        mutable size_t maxCount = 0;
+        mutable bool extremesStale = false;
+    };
+
     vector<Book> books;
+    unordered_map<string, size_t> articleIndex;
     string dataFilePath;
+    mutable shared_mutex catalogMutex;
+    mutable mutex fileMutex;
+    LoadStatus loadStatus;
+
+    // Впорядковані індекси для діапазонних запитів. Артикул у ключі
+    // робить ключі унікальними при однакових ціні чи назві.
+    BPlusTree<pair<Money, string>> priceIndex;
+    BPlusTree<pair<string, string>> titleIndex;
+
+    // Індекс видач: хто що тримає, щоб перелік книг читача коштував O(k), а не O(n).
+    unordered_map<string, set<string>> loansByReader;
+
+    // Групи книг за станом видачі, полицею та автором: список позицій
+    // (у books) і підсумки цін. Складений запит - це перетин стиснених
+    // бітових множин, а не перебір каталогу; статистика групи читається
+    // за O(1) (крайні ціни - див. BookGroup). Позиції зсуваються при видаленні та сортуванні, тож групи
+    // перебудовуються разом з індексом артикулів (rebuildIndex()).
+    BookGroup availableGroup;
+    BookGroup issuedGroup;
+    unordered_map<int, BookGroup> shelfGroups;
+    unordered_map<string, BookGroup> authorGroups;
+    mutable mutex statsMutex;
+
+    // Версія каталогу зростає з кожною зміною (під ексклюзивним блокуванням).
+    // Знімки спільні для всіх читачів однієї версії; знімок звільняється,
+    // щойно його відпускає останній читач, а протухлі записи
+    // прибираються з таблиці при відкритті наступного.
+    atomic<uint64_t> version;
+    mutable mutex snapshotMutex;
+    mutable map<uint64_t, weak_ptr<const LibrarySnapshot>> snapshots;
+
+    // Лічильник змін користувача (без рядків, прочитаних при завантаженні)
+    // і його значення на момент останнього запису файлу: деструктор не
+    // перезаписує файл, якщо відтоді нічого не змінилося.
+    atomic<uint64_t> changeCount;
+    mutable atomic<uint64_t> savedChangeCount;
+
+    // Прогресивне завантаження: індекс "артикул -> зсув у CSV" читається
+    // з допоміжного файлу першим, а записи, яких ще немає в пам'яті,
+    // підвантажуються поштучно при першому зверненні.
+    mutable mutex lazyMutex;
+    unordered_map<string, uint64_t> pendingOffsets;
+    mutable unordered_map<string, Book> lazyBooks;
+    LoadStatus indexStatus;
+
+    /**
+     * @brief Знімок каталогу у форматі CSV разом із зсувами рядків.
+     */
+    struct CsvSnapshot
+    {
+        string content;
+        vector<pair<string, uint64_t>> offsets;
+        uint64_t changeCount = 0;
+    };
 public:
     /**
-     * @brief .
-     * @param dataFilePath     (., "db.csv").
+     * @brief Результат видачі або повернення книги.
+     */
+    enum class LoanStatus
+    {
+        Done,
+        NotFound,
+        AlreadyIssued,
+        NotIssued,
+        ReaderNameTooLong
+    };
+
+    /**
+     * @brief Порядок книг для посторінкового перегляду.
      */
-    Library(const string& dataFilePath);
+    enum class PageOrder
+    {
+        Catalog,
+        Title,
+        Price
+    };
 
     /**
-     * @brief .
-     *   SaveToFile()    .
+     * @struct BookQuery
+     * @brief Складений фільтр: задані критерії об'єднуються через "І".
+     */
+    struct BookQuery
+    {
+        optional<int> shelfNumber;
+        optional<string> authorName;
+        optional<bool> available;
+    };
+
+    /**
+     * @struct BulkError
+     * @brief Помилка в одному рядку пакетної операції.
+     */
+    struct BulkError
+    {
+        size_t row;
+        string article;
+        string message;
+    };
+
+    /**
+     * @struct BulkResult
+     * @brief Результат пакетної операції.
+     */
+    struct BulkResult
+    {
+        size_t applied = 0;
+        vector<BulkError> errors;
+
+        bool Succeeded() const { return this->errors.empty(); }
+    };
+
+    /**
+     * @brief Конструктор.
+     * @param dataFilePath Шлях до файлу даних (напр., "db.csv").
+     * @param loadNow Якщо false, дані завантажуються пізніше через LoadAsync().
+     */
+    Library(const string& dataFilePath, bool loadNow = true);
+
+    /**
+     * @brief Деструктор.
+     * Викликає SaveToFile() при виході з програми, якщо після останнього
+     * збереження каталог змінювався.
      */
     ~Library();
 
     /**
-     * @brief     .
-     * @param book ' Book,   .
-     * @return true,   , false -    .
+     * @brief Додає нову книгу до бібліотеки.
+     * @param book Об'єкт Book, який потрібно додати.
+     * @return true, якщо додавання успішне, false - якщо артикул вже існує.
      */
     bool AddBook(const Book& book);
 
     /**
-     * @brief     .
-     * @param article    .
-     * @return true,   , false -    .
+     * @brief Видаляє книгу за її артикулом.
+     * @param article Артикул книги для видалення.
+     * @return true, якщо видалення успішне, false - якщо книга не знайдена.
      */
     bool DeleteBook(const string& article);
 
     /**
-     * @brief    .
-     * @param article  ,   .
-     * @param newBookData ' Book   .
-     * @return true,   , false -    .
+     * @brief Оновлює дані існуючої книги.
+     * @param article Артикул книги, яку треба оновити.
+     * @param newBookData Об'єкт Book з новими даними.
+     * @return true, якщо оновлення успішне, false - якщо книга не знайдена.
      */
     bool UpdateBook(const string& article, const Book& newBookData);
 
     /**
-     * @brief    .
-     * @param article   .
-     * @return    ,  nullptr,   .
+     * @brief Додає пакет книг за один прохід.
+     * Пакет перевіряється цілком (дублікати - одним хеш-проходом), місце
+     * резервується один раз, а допоміжні індекси за великого пакета
+     * перебудовуються, а не оновлюються поштучно.
+     * Потребує повністю завантаженого каталогу (як і AddBook).
+     * @param batch Книги для додавання.
+     * @param allOrNothing Якщо true, за будь-якої помилки нічого не змінюється;
+     * інакше додаються лише коректні рядки.
+     * @return Кількість доданих книг і помилки за номерами рядків пакета.
+     */
+    BulkResult BulkAdd(const vector<Book>& batch, bool allOrNothing = true);
+
+    /**
+     * @brief Оновлює пакет книг (пошук за артикулом кожної книги).
+     * @param batch Нові дані книг; артикули мають існувати.
+     * @param allOrNothing Див. BulkAdd().
+     */
+    BulkResult BulkUpdate(const vector<Book>& batch, bool allOrNothing = true);
+
+    /**
+     * @brief Видаляє пакет книг за один прохід по каталогу.
+     * @param articles Артикули для видалення.
+     * @param allOrNothing Див. BulkAdd().
+     */
+    BulkResult BulkDelete(const vector<string>& articles, bool allOrNothing = true);
+
+    /**
+     * @brief Імпортує книги з CSV-файлу (формат файлу даних) через BulkAdd().
+     * Номери рядків у помилках - номери рядків файлу (з 1).
+     * @param filePath Шлях до файлу.
+     * @param allOrNothing Див. BulkAdd(); пошкоджені рядки теж вважаються помилками.
+     */
+    BulkResult ImportCsv(const string& filePath, bool allOrNothing = true);
+
+    /**
+     * @brief Експортує весь каталог у CSV-файл.
+     * Пише зі знімка (OpenSnapshot()), тож блокує сам і лише на час
+     * копіювання каталогу. Не викликати, тримаючи GetMutex().
+     * @param filePath Шлях до файлу.
+     * @return false, якщо файл не вдалося записати.
+     * @throws runtime_error, якщо каталог завантажено не повністю.
+     */
+    bool ExportCsv(const string& filePath) const;
+
+    /**
+     * @brief Знаходить книгу за артикулом.
+     * @param article Артикул для пошуку.
+     * @return Вказівник на знайдену книгу, або nullptr, якщо не знайдено.
      */
     Book* FindBookByArticle(const string& article);
 
     /**
-     * @brief    .
-     * @param article   .
-     * @return    ,  nullptr.
+     * @brief Знаходить книгу за артикулом.
+     * @param article Артикул для пошуку.
+     * @return Вказівник на константну книгу, або nullptr.
      */
     const Book* FindBookByArticle(const string& article) const;
 
     /**
-     * @brief     ' .
-     * @param authorName '   .
-     * @return vector<Book>,     .
+     * @brief Знаходить одразу кілька книг за артикулами (пакетний пошук).
+     * @param articles Список артикулів.
+     * @return Вказівники у тому ж порядку, що й артикули (nullptr - не знайдено).
+     */
+    vector<const Book*> FindBooksByArticles(const vector<string>& articles) const;
+
+    /**
+     * @brief Видає книгу читачу та оновлює індекс видач.
+     * @param article Артикул книги.
+     * @param readerName ПІБ читача.
+     * @return Done, NotFound, AlreadyIssued або ReaderNameTooLong (ПІБ довше
+     * за Book::MAX_FIELD_LENGTH; каталог тоді не змінюється).
+     */
+    LoanStatus IssueBook(const string& article, const string& readerName);
+
+    /**
+     * @brief Повертає книгу до бібліотеки та оновлює індекс видач.
+     * @param article Артикул книги.
+     * @return Done, NotFound або NotIssued.
+     */
+    LoanStatus ReturnBook(const string& article);
+
+    /**
+     * @brief Книги, видані читачу (за індексом видач, O(k)).
+     * @param readerName ПІБ читача.
+     * @return Книги в порядку каталогу.
+     */
+    vector<Book> GetLoansByReader(const string& readerName) const;
+
+    /**
+     * @brief Лише доступні книги (O(k)).
+     * @return Книги в порядку каталогу.
+     */
+    vector<Book> GetAvailableBooks() const;
+
+    /**
+     * @brief Лише видані книги (O(k)).
+     * @return Книги в порядку каталогу.
+     */
+    vector<Book> GetIssuedBooks() const;
+
+    /**
+     * @brief Знаходить книги, що відповідають усім заданим критеріям
+     * (напр., доступні книги автора X на полиці 4).
+     * @param query Критерії; порожній запит повертає весь каталог.
+     * @return Книги в порядку каталогу.
+     */
+    vector<Book> FilterBooks(const BookQuery& query) const;
+
+    /**
+     * @brief Рахує книги, що відповідають усім заданим критеріям,
+     * не копіюючи їх.
+     */
+    size_t CountBooks(const BookQuery& query) const;
+
+    /**
+     * @brief Кількість, сума, середнє, мінімум і максимум цін для кожної
+     * групи. Підсумки підтримуються при кожній зміні, тож звіт не
+     * перебирає каталог (хіба що групу, з якої пішла крайня ціна).
+     * @param groupBy Ознака групування.
+     * @return Групи, впорядковані за значенням ознаки.
+     */
+    vector<GroupStats> GetStatistics(GroupBy groupBy) const;
+
+    /**
+     * @brief Підсумки цін для всього каталогу.
+     */
+    PriceStats GetTotals() const;
+
+    /**
+     * @brief Читачі з найбільшою кількістю книг на руках.
+     * @param limit Скільки читачів повернути.
+     * @return Пари "читач - кількість книг", від більшої кількості.
+     */
+    vector<pair<string, size_t>> GetTopReaders(size_t limit) const;
+
+    /**
+     * @brief Формує список книг за ім'ям автора.
+     * @param authorName Ім'я автора для фільтрації.
+     * @return vector<Book>, що містить лише відповідні книги.
      */
     vector<Book> FilterByAuthor(const string& authorName) const;
 
     /**
-     * @brief      .
-     * @param shelfNumber    .
-     * @return std::vector<Book>,     .
+     * @brief Формує список книг за номером етажерки.
+     * @param shelfNumber Номер етажерки для фільтрації.
+     * @return std::vector<Book>, що містить лише відповідні книги.
      */
     vector<Book> FilterByShelf(int shelfNumber) const;
 
+    /**
+     * @brief Знаходить книги з ціною в діапазоні [minPrice, maxPrice].
+     * Використовує B+-дерево за ціною: O(log n + k).
+     * @return Книги в порядку зростання ціни.
+     */
+    vector<Book> FilterByPriceRange(Money minPrice, Money maxPrice) const;
+
+    /**
+     * @brief Знаходить книги, назви яких лежать між fromTitle і toTitle.
+     * Верхня межа включає всі назви, що з неї починаються
+     * (діапазон "А".."Г" містить і назви на "Г").
+     * @return Книги в порядку зростання назви; за порожньої верхньої
+     * межі - порожній список.
+     */
+    vector<Book> FilterByTitleRange(const string& fromTitle, const string& toTitle) const;
+
+    /**
+     * @brief Сортування за назвою та ціною впорядковує книги обходом
+     * відповідного B+-дерева (O(n) замість сортування).
+     */
     void SortByTitle();
     void SortByAuthor();
     void SortByPrice();
 
     /**
-     * @brief      .
-     * @return    vector<Book>.
+     * @brief Отримує посилання на повний список книг.
+     * @return Константне посилання на vector<Book>.
      */
     const vector<Book>& GetAllBooks() const;
 
     /**
-     * @brief ,   .
-     * @return true,   .
+     * @brief Кількість книг у каталозі.
+     */
+    size_t GetBookCount() const;
+
+    /**
+     * @brief Повертає одну сторінку каталогу, копіюючи лише її книги.
+     * За назвою та ціною сторінка береться з упорядкованих індексів, тож
+     * каталог не сортується і не змінюється.
+     * @param offset Порядковий номер першої книги сторінки.
+     * @param count Розмір сторінки.
+     * @param order Порядок книг.
+     * @return Книги сторінки (порожньо, якщо offset за межами каталогу).
+     */
+    vector<Book> GetPage(size_t offset, size_t count, PageOrder order) const;
+
+    /**
+     * @brief Перевіряє, чи порожня бібліотека.
+     * @return true, якщо книг немає.
      */
     bool IsEmpty() const;
 
+    /**
+     * @brief Зберігає дані у файл.
+     * Викликається деструктором, а також сервером після змін.
+     * Відмовляється працювати, поки каталог не завантажено повністю,
+     * щоб не перезаписати файл неповними даними.
+     */
+    void SaveToFile() const;
+
+    /**
+     * @brief Поточна версія каталогу (зростає з кожною зміною).
+     */
+    uint64_t GetVersion() const;
+
+    /**
+     * @brief Позначає зміну книги, зроблену напряму через вказівник
+     * FindBookByArticle(). Методи змін Library (зокрема IssueBook і
+     * ReturnBook) роблять це самі. Викликається під ексклюзивним блокуванням.
+     */
+    void MarkModified();
+
+    /**
+     * @brief Відкриває знімок поточної версії каталогу для довгого читання.
+     * Блокує сам (спільно) лише на час копіювання, і то тільки якщо знімка
+     * цієї версії ще немає; читачі однієї версії ділять один знімок.
+     * Не викликати, тримаючи GetMutex().
+     * @return Незмінний знімок; чекає кінця фонового завантаження.
+     */
+    shared_ptr<const LibrarySnapshot> OpenSnapshot() const;
+
+    /**
+     * @brief Отримує м'ютекс каталогу для зовнішньої синхронізації.
+     * @return Посилання на shared_mutex.
+     */
+    shared_mutex& GetMutex() const;
+
+    /**
+     * @brief Асинхронно (прогресивно) завантажує каталог.
+     * Спершу читається допоміжний індекс артикулів (файл даних + ".idx"),
+     * після чого FindBookByArticle знаходить будь-яку книгу, підвантажуючи
+     * її запис із CSV за зсувом. Далі файл читається порціями; кожна порція
+     * додається під ексклюзивним блокуванням.
+     * @param executor Виконавець, у потоках якого читається файл.
+     * @return Задача з кількістю завантажених книг.
+     */
+    Task<size_t> LoadAsync(Executor& executor);
+
+    /**
+     * @brief Асинхронно зберігає каталог у файл.
+     * Знімок CSV робиться під спільним блокуванням, запис - без нього.
+     * @param executor Виконавець для фонового запису.
+     */
+    Task<void> SaveAsync(Executor& executor) const;
+
+    /**
+     * @brief Асинхронний пошук за артикулом.
+     * @return Копія книги або порожнє значення.
+     */
+    Task<optional<Book>> FindBookAsync(Executor& executor, string article) const;
+
+    /**
+     * @brief Асинхронна фільтрація за автором.
+     */
+    Task<vector<Book>> FilterByAuthorAsync(Executor& executor, string authorName) const;
+
+    /**
+     * @brief Асинхронна фільтрація за номером етажерки.
+     */
+    Task<vector<Book>> FilterByShelfAsync(Executor& executor, int shelfNumber) const;
+
+    /**
+     * @brief Чекає завершення фонового завантаження (якщо воно триває).
+     */
+    void WaitForLoad() const;
+
+    /**
+     * @brief Перевіряє, чи триває фонове завантаження.
+     * @return true, якщо LoadAsync ще не завершився.
+     */
+    bool IsLoading() const;
+
+    /**
+     * @brief Перевіряє, чи каталог завантажено повністю й без помилок.
+     * @return false, якщо завантаження триває або його перервала помилка:
+     * тоді зберігати каталог у файл даних не можна.
+     */
+    bool IsLoaded() const;
+
 private:
     /**
-     * @brief    .
-     *  .
+     * @brief Завантажує дані з файлу.
+     * Викликається конструктором.
      */
     void LoadFromFile();
 
     /**
-     * @brief    .
-     *  .
+     * @brief Перебудовує індекс артикулів і списки позицій після зміни порядку книг.
+     */
+    void rebuildIndex();
+
+    /**
+     * @brief Додає книгу до допоміжних індексів (ціна, назва, видачі).
+     */
+    void indexBook(const Book& book);
+
+    /**
+     * @brief Прибирає книгу з допоміжних індексів.
+     */
+    void unindexBook(const Book& book);
+
+    /**
+     * @brief Повертає видалену книгу на її колишню позицію (відкат транзакції).
+     */
+    void restoreBookAt(size_t position, const Book& book);
+
+    /**
+     * @brief Перевіряє пакет для BulkAdd() одним хеш-проходом.
+     * @param result Сюди додаються помилки (номер рядка - індекс у пакеті).
+     * @return Для кожного рядка - чи можна його додати.
+     */
+    vector<bool> validateBulkAdd(const vector<Book>& batch, BulkResult& result) const;
+
+    /**
+     * @brief Додає перевірені рядки пакета та оновлює індекси.
+     * @return Кількість доданих книг.
+     */
+    size_t applyBulkAdd(const vector<Book>& batch, const vector<bool>& valid);
+
+    /**
+     * @brief Додає книгу до індексу видач.
+     */
+    void indexLoan(const Book& book);
+
+    /**
+     * @brief Прибирає книгу з індексу видач.
+     */
+    void unindexLoan(const Book& book);
+
+    /**
+     * @brief Додає книгу на позиції до груп стану, полиці та автора.
+     */
+    void postBook(size_t position);
+
+    /**
+     * @brief Прибирає книгу на позиції з груп (до зміни книги на цій позиції).
+     */
+    void unpostBook(size_t position);
+
+    /**
+     * @brief Будує групи заново для всього каталогу.
+     */
+    void rebuildPostings();
+
+    /**
+     * @brief Додає позицію та ціну до групи.
+     */
+    static void addToGroup(BookGroup& group, uint32_t row, Money price);
+
+    /**
+     * @brief Прибирає позицію та ціну з групи за O(1). Якщо пішла остання
+     * книга з мінімальною чи максимальною ціною, крайні значення лише
+     * позначаються застарілими.
+     */
+    static void removeFromGroup(BookGroup& group, uint32_t row, Money price);
+
+    /**
+     * @brief Підсумки групи; застарілі крайні значення спершу
+     * перераховуються за позиціями групи (під statsMutex).
+     */
+    PriceStats readGroupStats(const BookGroup& group) const;
+
+    /**
+     * @brief Прибирає книгу з групи в таблиці; порожня група видаляється.
+     */
+    template<typename Key>
+    void removeFromGroups(unordered_map<Key, BookGroup>& groups, const Key& key, uint32_t row, Money price);
+
+    /**
+     * @brief Обирає списки позицій для критеріїв запиту.
+     * @param postings Сюди додаються списки; порожньо, якщо критеріїв немає.
+     * @return false, якщо якомусь критерію не відповідає жодна книга.
+     */
+    bool selectPostings(const BookQuery& query, vector<const RoaringBitmap*>& postings) const;
+
+    /**
+     * @brief Копіює книги на позиціях з множини (у порядку каталогу).
+     */
+    vector<Book> collectRows(const RoaringBitmap& rows) const;
+
+    /**
+     * @brief Копіює книги за набором артикулів у порядку каталогу.
+     */
+    template<typename Articles>
+    vector<Book> collectInCatalogOrder(const Articles& articles) const;
+
+    /**
+     * @brief Будує допоміжні індекси заново для всього каталогу.
+     */
+    void rebuildSecondaryIndexes();
+
+    /**
+     * @brief Чи вигідніше перебудувати допоміжні індекси, ніж
+     * оновлювати їх для кожної книги пакета.
+     */
+    bool shouldRebuildSecondaryIndexes(size_t batchSize) const;
+
+    /**
+     * @brief Переставляє книги в порядку обходу впорядкованого індексу.
+     */
+    template<typename Tree>
+    void reorderByIndex(const Tree& index);
+
+    /**
+     * @brief Додає прочитану з файлу книгу, пропускаючи дублікати артикулу.
+     * @return true, якщо книгу додано.
+     */
+    bool appendLoadedBook(Book&& book);
+
+    /**
+     * @brief Корутина порційного завантаження (тіло LoadAsync).
+     */
+    Task<size_t> loadChunksAsync(Executor& executor);
+
+    /**
+     * @brief Формує вміст CSV-файлу для всього каталогу та зсуви рядків.
+     */
+    CsvSnapshot buildCsv() const;
+
+    /**
+     * @brief Записує готовий вміст у файл даних і допоміжний індекс.
+     */
+    void writeDataFile(const CsvSnapshot& snapshot) const;
+
+    /**
+     * @brief Отримує шлях до допоміжного індексу артикулів.
+     */
+    string getIndexFilePath() const;
+
+    /**
+     * @brief Читає допоміжний індекс, якщо він відповідає файлу даних.
+     * @param offsets Сюди записуються зсуви рядків за артикулами.
+     * @return true, якщо індекс прочитано.
+     */
+    bool readIndexFile(unordered_map<string, uint64_t>& offsets) const;
+
+    /**
+     * @brief Підвантажує одну книгу з CSV за індексом (лише під час завантаження).
+     * @param article Артикул книги.
+     * @return Вказівник на підвантажену книгу або nullptr.
+     */
+    const Book* pageInBook(const string& article) const;
+
+    /**
+     * @brief Те саме для зміни підвантаженої книги.
+     * Книга лишається під lazyMutex, доки викликач тримає lock: інакше
+     * завантажувач міг би саме тоді перенести її в каталог.
+     * @param article Артикул книги.
+     * @param lock Сюди передається захоплений lazyMutex.
+     * @return Вказівник на підвантажену книгу або nullptr.
+     */
+    Book* pageInBook(const string& article, unique_lock<mutex>& lock);
+
+    /**
+     * @brief Знаходить або читає з CSV підвантажену книгу.
+     * Викликається під lazyMutex.
      */
-    void SaveToFile();
+    Book* findLazyBook(const string& article) const;
 };
 
@@ -0,0 +1,170 @@
+#include "LibraryTransaction.h"
+#include "Library.h"
+
+using namespace std;
+
+LibraryTransaction::LibraryTransaction(Library& library)
+    : library(&library)
+{
+}
+
+void LibraryTransaction::StageAdd(const Book& book)
+{
+    this->operations.push_back({ OperationKind::Add, book.GetId(), book, "" });
+}
+
+void LibraryTransaction::StageUpdate(const string& article, const Book& newBookData)
+{
+    this->operations.push_back({ OperationKind::Update, article, newBookData, "" });
+}
+
+void LibraryTransaction::StageDelete(const string& article)
+{
+    this->operations.push_back({ OperationKind::Delete, article, Book(), "" });
+}
+
+void LibraryTransaction::StageIssue(const string& article, const string& readerName)
+{
+    this->operations.push_back({ OperationKind::Issue, article, Book(), readerName });
+}
+
+void LibraryTransaction::StageReturn(const string& article)
+{
+    this->operations.push_back({ OperationKind::Return, article, Book(), "" });
+}
+
+size_t LibraryTransaction::GetOperationCount() const
+{
+    return this->operations.size();
+}
+
+LibraryTransaction::CommitResult LibraryTransaction::Commit()
+{
+    CommitResult result;
+    vector<Operation> pending = move(this->operations);
+    this->operations.clear();
+
+    // Видалення та відкат змінюють порядок книг, тож часткового
+    // (прогресивно завантаженого) каталогу транзакції не торкаються.
+    if (this->library->loadStatus.Get() != LoadStatus::State::Loaded)
+    {
+        result.status = Status::NotLoaded;
+        return result;
+    }
+
+    vector<UndoEntry> undoLog;
+    undoLog.reserve(pending.size());
+    uint64_t changesBefore = this->library->changeCount;
+
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        Status status = this->apply(pending[i], undoLog);
+        if (status != Status::Committed)
+        {
+            this->rollback(undoLog);
+
+            // Відкочена транзакція нічого не змінила: файл переписувати
+            // не треба (ні при виході, ні в group commit).
+            this->library->changeCount = changesBefore;
+            result.status = status;
+            result.failedOperation = i;
+            return result;
+        }
+    }
+    return result;
+}
+
+void LibraryTransaction::Abort()
+{
+    this->operations.clear();
+}
+
+LibraryTransaction::Status LibraryTransaction::apply(const Operation& operation, vector<UndoEntry>& undoLog)
+{
+    Library& catalog = *this->library;
+    auto it = catalog.articleIndex.find(operation.article);
+
+    if (operation.kind == OperationKind::Add)
+    {
+        if (it != catalog.articleIndex.end()) return Status::AlreadyExists;
+
+        catalog.AddBook(operation.book);
+        undoLog.push_back({ OperationKind::Add, operation.article, Book(), 0 });
+        return Status::Committed;
+    }
+
+    if (it == catalog.articleIndex.end()) return Status::NotFound;
+
+    size_t position = it->second;
+    Book before = catalog.books[position];
+
+    switch (operation.kind)
+    {
+    case OperationKind::Update:
+    {
+        const string& newArticle = operation.book.GetId();
+        if (newArticle != operation.article && catalog.articleIndex.count(newArticle) > 0)
+        {
+            return Status::AlreadyExists;
+        }
+        catalog.UpdateBook(operation.article, operation.book);
+        undoLog.push_back({ OperationKind::Update, newArticle, move(before), position });
+        return Status::Committed;
+    }
+    case OperationKind::Delete:
+        catalog.DeleteBook(operation.article);
+        undoLog.push_back({ OperationKind::Delete, operation.article, move(before), position });
+        return Status::Committed;
+
+    case OperationKind::Issue:
+        if (!before.IsAvailable()) return Status::BookBusy;
+        if (catalog.IssueBook(operation.article, operation.readerName) != Library::LoanStatus::Done)
+        {
+            return Status::InvalidRequest;
+        }
+        break;
+
+    case OperationKind::Return:
+        if (before.IsAvailable()) return Status::BookAvailable;
+        catalog.ReturnBook(operation.article);
+        break;
+
+    default:
+        break;
+    }
+
+    undoLog.push_back({ operation.kind, operation.article, move(before), position });
+    return Status::Committed;
+}
+
+void LibraryTransaction::rollback(vector<UndoEntry>& undoLog)
+{
+    Library& catalog = *this->library;
+
+    for (auto entry = undoLog.rbegin(); entry != undoLog.rend(); ++entry)
+    {
+        switch (entry->kind)
+        {
+        case OperationKind::Add:
+            catalog.DeleteBook(entry->article);
+            break;
+
+        case OperationKind::Update:
+            catalog.UpdateBook(entry->article, entry->before);
+            break;
+
+        case OperationKind::Delete:
+            catalog.restoreBookAt(entry->position, entry->before);
+            break;
+
+        case OperationKind::Issue:
+            catalog.ReturnBook(entry->article);
+            break;
+
+        case OperationKind::Return:
+            catalog.IssueBook(entry->article, entry->before.GetReaderFullName());
+            break;
+        }
+    }
+    undoLog.clear();
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+#include "../Entities/Book.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Library;
+
+ /**
+  * @class LibraryTransaction
+  * @brief Група змін каталогу, що застосовується атомарно.
+  *
+  * Операції спершу лише накопичуються (Stage...), а Commit() застосовує
+  * їх по черзі, записуючи журнал відкату. Якщо якась операція не
+  * вдається, уже застосовані відкочуються у зворотному порядку, і
+  * каталог лишається таким, яким був до Commit().
+  *
+  * Commit() виконується під ексклюзивним блокуванням Library::GetMutex(),
+  * яке тримає викликач (як і для інших змін Library), тож транзакції
+  * впорядковані за часом фіксації (serializable), а накопичення операцій
+  * нікого не блокує.
+  */
+class LibraryTransaction
+{
+public:
+    /**
+     * @brief Результат фіксації.
+     */
+    enum class Status
+    {
+        Committed,
+        NotFound,
+        AlreadyExists,
+        BookBusy,
+        BookAvailable,
+        NotLoaded,
+        InvalidRequest
+    };
+
+    /**
+     * @struct CommitResult
+     * @brief Результат Commit(): статус і номер операції, що не вдалася.
+     */
+    struct CommitResult
+    {
+        Status status = Status::Committed;
+        size_t failedOperation = 0;
+
+        bool Succeeded() const { return this->status == Status::Committed; }
+    };
+
+private:
+    enum class OperationKind
+    {
+        Add,
+        Update,
+        Delete,
+        Issue,
+        Return
+    };
+
+    struct Operation
+    {
+        OperationKind kind;
+        string article;
+        Book book;
+        string readerName;
+    };
+
+    /**
+     * @brief Запис журналу відкату: що було до операції.
+     */
+    struct UndoEntry
+    {
+        OperationKind kind;
+        string article;
+        Book before;
+        size_t position;
+    };
+
+    Library* library;
+    vector<Operation> operations;
+
+public:
+    /**
+     * @brief Починає транзакцію над каталогом.
+     * @param library Каталог.
+     */
+    explicit LibraryTransaction(Library& library);
+
+    void StageAdd(const Book& book);
+    void StageUpdate(const string& article, const Book& newBookData);
+    void StageDelete(const string& article);
+    void StageIssue(const string& article, const string& readerName);
+    void StageReturn(const string& article);
+
+    /**
+     * @brief Кількість накопичених операцій.
+     */
+    size_t GetOperationCount() const;
+
+    /**
+     * @brief Застосовує всі операції або жодної.
+     * Викликач тримає ексклюзивне блокування каталогу. Після Commit()
+     * список операцій очищується незалежно від результату. Відкочена
+     * транзакція не рахується зміною, що потребує запису у файл.
+     * @return Статус і номер першої операції, що не вдалася.
+     */
+    CommitResult Commit();
+
+    /**
+     * @brief Відкидає накопичені операції.
+     */
+    void Abort();
+
+private:
+    /**
+     * @brief Застосовує одну операцію та записує, як її відкотити.
+     * @return Status::Committed, якщо операцію застосовано.
+     */
+    Status apply(const Operation& operation, vector<UndoEntry>& undoLog);
+
+    /**
+     * @brief Відкочує застосовані операції у зворотному порядку.
+     */
+    void rollback(vector<UndoEntry>& undoLog);
+};
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "PagedCatalog.h"
+#include <iostream>
+#include <fstream>
+#include <unordered_set>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+    const size_t PAGE_SIZE = BufferPool::PAGE_SIZE;
+    const size_t HEADER_SIZE = PagedCatalog::RECORD_HEADER_SIZE;
+
+    /**
+     * @class PinnedPage
+     * @brief Закріплює сторінку кешу на час життя об'єкта.
+     */
+    class PinnedPage
+    {
+    private:
+        BufferPool& pool;
+        uint64_t pageId;
+        const char* data;
+
+    public:
+        PinnedPage(BufferPool& pool, uint64_t pageId)
+            : pool(pool), pageId(pageId), data(pool.Pin(pageId))
+        {
+        }
+
+        ~PinnedPage() { this->pool.Unpin(this->pageId); }
+
+        PinnedPage(const PinnedPage&) = delete;
+        PinnedPage& operator=(const PinnedPage&) = delete;
+
+        const char* Read() const { return this->data; }
+    };
+
+    /**
+     * @brief Довжина запису із заголовка (little-endian); 0 - до кінця сторінки записів немає.
+     */
+    uint32_t decodeLength(const char* header)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(header);
+        return static_cast<uint32_t>(bytes[0])
+            | (static_cast<uint32_t>(bytes[1]) << 8)
+            | (static_cast<uint32_t>(bytes[2]) << 16)
+            | (static_cast<uint32_t>(bytes[3]) << 24);
+    }
+
+    void encodeLength(uint32_t length, char* header)
+    {
+        for (size_t i = 0; i < HEADER_SIZE; ++i)
+        {
+            header[i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+        }
+    }
+
+    uint64_t nextPageStart(uint64_t offset)
+    {
+        return (offset / PAGE_SIZE + 1) * PAGE_SIZE;
+    }
+
+    /**
+     * @brief Чи треба почати запис із нової сторінки: заголовок не вміщується
+     * в залишок сторінки або запис, що вміщується в сторінку, розірвався б.
+     */
+    bool startsOnNextPage(uint64_t offset, size_t recordSize)
+    {
+        size_t remaining = PAGE_SIZE - offset % PAGE_SIZE;
+        return remaining < HEADER_SIZE || (recordSize > remaining && recordSize <= PAGE_SIZE);
+    }
+}
+
+PagedCatalog::PagedCatalog(const string& pageFilePath, size_t cachePages)
+    : pool(pageFilePath, cachePages)
+{
+    this->buildIndex(pageFilePath);
+}
+
+size_t PagedCatalog::BuildFromCsv(const string& csvPath, const string& pageFilePath)
+{
+    ifstream input(csvPath, ios::binary);
+    if (!input.is_open())
+    {
+        throw runtime_error("Не вдалося відкрити файл " + csvPath);
+    }
+
+    ofstream output(pageFilePath, ios::binary | ios::trunc);
+    if (!output.is_open())
+    {
+        throw runtime_error("Не вдалося створити файл " + pageFilePath);
+    }
+
+    uint64_t offset = 0;
+    size_t bookCount = 0;
+    unordered_set<string> seenArticles;
+    const vector<char> padding(PAGE_SIZE, 0);
+
+    string line;
+    while (getline(input, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        string article = line.substr(0, line.find(','));
+        if (!seenArticles.insert(article).second)
+        {
+            cerr << "Попередження: Дублікат артикулу " << article << " пропущено.\n";
+            continue;
+        }
+
+        size_t recordSize = HEADER_SIZE + line.size();
+        if (startsOnNextPage(offset, recordSize))
+        {
+            uint64_t pageStart = nextPageStart(offset);
+            output.write(padding.data(), static_cast<streamsize>(pageStart - offset));
+            offset = pageStart;
+        }
+
+        char header[HEADER_SIZE];
+        encodeLength(static_cast<uint32_t>(line.size()), header);
+        output.write(header, HEADER_SIZE);
+        output.write(line.data(), static_cast<streamsize>(line.size()));
+        offset += recordSize;
+        bookCount++;
+    }
+
+    // Файл сторінок складається з цілих сторінок.
+    if (offset % PAGE_SIZE != 0)
+    {
+        output.write(padding.data(), static_cast<streamsize>(nextPageStart(offset) - offset));
+    }
+    if (!output)
+    {
+        throw runtime_error("Не вдалося записати файл " + pageFilePath);
+    }
+    return bookCount;
+}
+
+optional<Book> PagedCatalog::FindBookByArticle(const string& article) const
+{
+    auto it = this->articleIndex.find(article);
+    if (it == this->articleIndex.end())
+    {
+        return nullopt;
+    }
+    return Book::FromCsvString(this->readRecord(it->second));
+}
+
+size_t PagedCatalog::GetBookCount() const
+{
+    return this->articleIndex.size();
+}
+
+BufferPool::Stats PagedCatalog::GetCacheStats() const
+{
+    return this->pool.GetStats();
+}
+
+void PagedCatalog::buildIndex(const string& pageFilePath)
+{
+    ifstream file(pageFilePath, ios::binary);
+    uint64_t fileSize = this->pool.GetPageCount() * PAGE_SIZE;
+
+    uint64_t offset = 0;
+    string row;
+    while (offset < fileSize)
+    {
+        if (PAGE_SIZE - offset % PAGE_SIZE < HEADER_SIZE)
+        {
+            offset = nextPageStart(offset);
+            continue;
+        }
+
+        char header[HEADER_SIZE];
+        file.seekg(static_cast<streamoff>(offset));
+        if (!file.read(header, HEADER_SIZE))
+        {
+            throw runtime_error("Файл сторінок пошкоджено: " + pageFilePath);
+        }
+
+        uint32_t length = decodeLength(header);
+        if (length == 0)
+        {
+            offset = nextPageStart(offset);
+            continue;
+        }
+        if (length > fileSize - offset - HEADER_SIZE)
+        {
+            throw runtime_error("Файл сторінок пошкоджено: " + pageFilePath);
+        }
+
+        row.resize(length);
+        file.read(row.data(), length);
+        string article = row.substr(0, row.find(','));
+        this->articleIndex.emplace(article, RecordLocation{
+            offset / PAGE_SIZE, static_cast<uint16_t>(offset % PAGE_SIZE) });
+        offset += HEADER_SIZE + length;
+    }
+}
+
+string PagedCatalog::readRecord(const RecordLocation& location) const
+{
+    uint64_t offset = location.pageId * PAGE_SIZE + location.offset;
+    char header[HEADER_SIZE];
+    this->readBytes(offset, header, HEADER_SIZE);
+
+    string row(decodeLength(header), '\0');
+    this->readBytes(offset + HEADER_SIZE, row.data(), row.size());
+    return row;
+}
+
+void PagedCatalog::readBytes(uint64_t offset, char* target, size_t size) const
+{
+    while (size > 0)
+    {
+        size_t pageOffset = static_cast<size_t>(offset % PAGE_SIZE);
+        size_t chunk = min(size, PAGE_SIZE - pageOffset);
+
+        PinnedPage page(this->pool, offset / PAGE_SIZE);
+        memcpy(target, page.Read() + pageOffset, chunk);
+
+        offset += chunk;
+        target += chunk;
+        size -= chunk;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+#include "../Entities/Book.h"
+#include "../Core/BufferPool.h"
+#include <string>
+#include <unordered_map>
+#include <optional>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class PagedCatalog
+  * @brief Каталог книг, що зберігається на диску сторінками (out-of-core),
+  * для пошуку за артикулом.
+  *
+  * Файл сторінок - послідовність записів змінної довжини: заголовок
+  * RECORD_HEADER_SIZE байтів із довжиною та рядок CSV однієї книги. Запис,
+  * що вміщується в сторінку, не розривається між двома (решта сторінки
+  * лишається порожньою), довший займає стільки сторінок, скільки потрібно.
+  *
+  * Рядки книг не тримаються в пам'яті: їх читає обмежений кеш сторінок
+  * (BufferPool). Індекс "артикул -> (сторінка, зсув у сторінці)" будується
+  * при відкритті й лишається в пам'яті, тож він зростає з каталогом
+  * (артикул і розташування на книгу), але це в рази менше, ніж самі книги.
+  *
+  * Межі: каталог лише для читання (файл сторінок створює BuildFromCsv()
+  * з CSV Library) і вміє тільки знаходити книгу за артикулом
+  * (LibraryApp --paged). Library не працює поверх нього: видача,
+  * повернення, фільтри й сортування, як і раніше, тримають усі книги
+  * в пам'яті. Методи безпечні для виклику з кількох потоків.
+  */
+class PagedCatalog
+{
+public:
+    static const size_t RECORD_HEADER_SIZE = 4;
+
+    /**
+     * @struct RecordLocation
+     * @brief Місце запису на диску: сторінка, де він починається, і зсув у ній.
+     */
+    struct RecordLocation
+    {
+        uint64_t pageId;
+        uint16_t offset;
+    };
+
+private:
+    mutable BufferPool pool;
+    unordered_map<string, RecordLocation> articleIndex;
+
+public:
+    /**
+     * @brief Конструктор. Відкриває файл сторінок і будує індекс артикулів.
+     * @param pageFilePath Шлях до файлу сторінок.
+     * @param cachePages Розмір кешу в сторінках.
+     * @throws runtime_error, якщо файл пошкоджено.
+     */
+    PagedCatalog(const string& pageFilePath, size_t cachePages);
+
+    /**
+     * @brief Перетворює CSV-файл каталогу на файл сторінок, читаючи його потоково.
+     * @param csvPath Шлях до CSV-файлу (формат Library).
+     * @param pageFilePath Шлях до файлу сторінок, що створюється.
+     * @return Кількість записаних книг.
+     */
+    static size_t BuildFromCsv(const string& csvPath, const string& pageFilePath);
+
+    /**
+     * @brief Знаходить книгу за артикулом.
+     * @param article Артикул для пошуку.
+     * @return Копія книги або порожнє значення.
+     */
+    optional<Book> FindBookByArticle(const string& article) const;
+
+    /**
+     * @brief Кількість книг у каталозі.
+     */
+    size_t GetBookCount() const;
+
+    /**
+     * @brief Лічильники кешу сторінок (влучання, промахи, витіснення).
+     */
+    BufferPool::Stats GetCacheStats() const;
+
+private:
+    /**
+     * @brief Будує індекс послідовним читанням файлу в обхід кешу,
+     * щоб не витісняти з нього "гарячі" сторінки.
+     */
+    void buildIndex(const string& pageFilePath);
+
+    /**
+     * @brief Читає рядок CSV запису за його розташуванням.
+     */
+    string readRecord(const RecordLocation& location) const;
+
+    /**
+     * @brief Копіює size байтів із зсуву offset, закріплюючи сторінки по черзі.
+     */
+    void readBytes(uint64_t offset, char* target, size_t size) const;
+};
\ No newline at end of file
@@ -0,0 +1,1061 @@
+#include "QueryServer.h"
+#include "Library.h"
+#include "AuthManager.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <set>
+#include <shared_mutex>
+#include <string_view>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace std;
+
+namespace
+{
+    const int POLL_TIMEOUT_MS = 100;
+    const int SEND_TIMEOUT_MS = 5000;
+    const size_t READ_CHUNK_SIZE = 16 * 1024;
+    const size_t MAX_LINE_LENGTH = 64 * 1024;
+    const int LISTEN_BACKLOG = 1024;
+    const intptr_t INVALID_HANDLE = -1;
+
+    const string RESP_OK = "OK";
+    const string ERR_UNKNOWN_COMMAND = "ERR UNKNOWN_COMMAND";
+    const string ERR_BAD_REQUEST = "ERR BAD_REQUEST";
+    const string ERR_AUTH_REQUIRED = "ERR AUTH_REQUIRED";
+    const string ERR_AUTH_FAILED = "ERR AUTH_FAILED";
+    const string ERR_TRY_LATER = "ERR TRY_LATER";
+    const string ERR_RATE_LIMITED = "ERR RATE_LIMITED";
+    const string ERR_FORBIDDEN = "ERR FORBIDDEN";
+    const string ERR_NOT_FOUND = "ERR NOT_FOUND";
+    const string ERR_BOOK_BUSY = "ERR BUSY";
+    const string ERR_BOOK_AVAILABLE = "ERR AVAILABLE";
+    const string ERR_LINE_TOO_LONG = "ERR LINE_TOO_LONG";
+    const string ERR_INTERNAL = "ERR INTERNAL";
+    const string ERR_ALREADY_EXISTS = "ERR EXISTS";
+    const string ERR_NOT_LOADED = "ERR NOT_LOADED";
+    const string ERR_NO_TRANSACTION = "ERR NO_TRANSACTION";
+    const string ERR_IN_TRANSACTION = "ERR IN_TRANSACTION";
+    const string RESP_QUEUED = "OK QUEUED";
+
+#ifdef _WIN32
+    typedef SOCKET NativeSocket;
+
+    bool lastErrorWouldBlock()
+    {
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+    }
+
+    void closeNativeSocket(intptr_t socket)
+    {
+        closesocket(static_cast<NativeSocket>(socket));
+    }
+
+    void setNonBlocking(intptr_t socket)
+    {
+        u_long mode = 1;
+        ioctlsocket(static_cast<NativeSocket>(socket), FIONBIO, &mode);
+    }
+
+    bool waitWritable(intptr_t socket)
+    {
+        WSAPOLLFD pfd = {};
+        pfd.fd = static_cast<NativeSocket>(socket);
+        pfd.events = POLLWRNORM;
+        return WSAPoll(&pfd, 1, SEND_TIMEOUT_MS) > 0;
+    }
+
+    /**
+     * @brief Тримає бібліотеку Winsock ініціалізованою, поки живе сервер.
+     */
+    struct WinsockScope
+    {
+        WinsockScope()
+        {
+            WSADATA data;
+            if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+            {
+                throw runtime_error("Не вдалося ініціалізувати Winsock.");
+            }
+        }
+        ~WinsockScope() { WSACleanup(); }
+    };
+#else
+    typedef int NativeSocket;
+
+    bool lastErrorWouldBlock()
+    {
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+
+    void closeNativeSocket(intptr_t socket)
+    {
+        close(static_cast<NativeSocket>(socket));
+    }
+
+    void setNonBlocking(intptr_t socket)
+    {
+        int flags = fcntl(static_cast<NativeSocket>(socket), F_GETFL, 0);
+        fcntl(static_cast<NativeSocket>(socket), F_SETFL, flags | O_NONBLOCK);
+    }
+
+    bool waitWritable(intptr_t socket)
+    {
+        pollfd pfd = {};
+        pfd.fd = static_cast<NativeSocket>(socket);
+        pfd.events = POLLOUT;
+        return poll(&pfd, 1, SEND_TIMEOUT_MS) > 0;
+    }
+#endif
+
+    /**
+     * @brief Надсилає весь буфер, очікуючи готовності сокета за потреби.
+     * @return false, якщо з'єднання розірвано.
+     */
+    bool sendAll(intptr_t socket, const string& data)
+    {
+        size_t sent = 0;
+        while (sent < data.size())
+        {
+            int chunk = static_cast<int>(min<size_t>(data.size() - sent, 1 << 20));
+#ifdef _WIN32
+            int n = send(static_cast<NativeSocket>(socket), data.data() + sent, chunk, 0);
+#else
+            int n = static_cast<int>(send(static_cast<NativeSocket>(socket),
+                data.data() + sent, chunk, MSG_NOSIGNAL));
+#endif
+            if (n > 0)
+            {
+                sent += static_cast<size_t>(n);
+            }
+            else if (n < 0 && lastErrorWouldBlock())
+            {
+                if (!waitWritable(socket)) return false;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Відрізає перше слово від рядка.
+     * @param rest Рядок; після виклику містить залишок без провідних пробілів.
+     * @return Перше слово.
+     */
+    string nextToken(string& rest)
+    {
+        size_t start = rest.find_first_not_of(' ');
+        if (start == string::npos)
+        {
+            rest.clear();
+            return "";
+        }
+
+        size_t end = rest.find(' ', start);
+        string token = rest.substr(start, end == string::npos ? string::npos : end - start);
+
+        size_t next = (end == string::npos) ? string::npos : rest.find_first_not_of(' ', end);
+        rest = (next == string::npos) ? "" : rest.substr(next);
+        return token;
+    }
+
+    string toUpper(string value)
+    {
+        transform(value.begin(), value.end(), value.begin(),
+            [](unsigned char c) { return static_cast<char>(toupper(c)); });
+        return value;
+    }
+
+    QueryServer::CommandKind classifyCommand(const string& command)
+    {
+        if (command == "PING" || command == "QUIT" ||
+            command == "LOGIN" || command == "LOGOUT" || command == "RESUME" ||
+            command == "BEGIN" || command == "ABORT")
+        {
+            return QueryServer::CommandKind::Session;
+        }
+        if (command == "FIND" || command == "MFIND" ||
+            command == "LIST" || command == "FILTER")
+        {
+            return QueryServer::CommandKind::Read;
+        }
+        if (command == "SORT" || command == "ISSUE" || command == "RETURN" ||
+            command == "COMMIT")
+        {
+            return QueryServer::CommandKind::Write;
+        }
+        return QueryServer::CommandKind::Unknown;
+    }
+
+    /**
+     * @brief Право, без якого команду каталогу не виконати.
+     * Визначається при розборі, тож перевірка під блокуванням - один біт.
+     */
+    UserAccount::Permission requiredPermission(const string& command)
+    {
+        if (command == "SORT") return UserAccount::Permission::SortCatalog;
+        if (command == "ISSUE" || command == "RETURN" || command == "COMMIT")
+        {
+            return UserAccount::Permission::BorrowBooks;
+        }
+        return UserAccount::Permission::ViewCatalog;
+    }
+
+    /**
+     * @brief Чи потрібен команді весь каталог (а не лише індекс артикулів).
+     */
+    bool requiresFullCatalog(const string& command)
+    {
+        return command == "LIST" || command == "FILTER" || command == "SORT" ||
+            command == "COMMIT";
+    }
+
+    string formatCommitError(const LibraryTransaction::CommitResult& result)
+    {
+        string code;
+        switch (result.status)
+        {
+        case LibraryTransaction::Status::NotFound: code = ERR_NOT_FOUND; break;
+        case LibraryTransaction::Status::AlreadyExists: code = ERR_ALREADY_EXISTS; break;
+        case LibraryTransaction::Status::BookBusy: code = ERR_BOOK_BUSY; break;
+        case LibraryTransaction::Status::BookAvailable: code = ERR_BOOK_AVAILABLE; break;
+        case LibraryTransaction::Status::InvalidRequest: code = ERR_BAD_REQUEST; break;
+        default: code = ERR_NOT_LOADED; break;
+        }
+        return code + " " + to_string(result.failedOperation + 1) + "\n";
+    }
+
+    string formatBookList(const vector<Book>& books)
+    {
+        string response = RESP_OK + " " + to_string(books.size()) + "\n";
+        for (const Book& book : books)
+        {
+            response += book.ToCsvString();
+            response += '\n';
+        }
+        return response;
+    }
+}
+
+/**
+ * @struct QueryServer::Connection
+ * @brief Стан одного TCP-з'єднання.
+ *
+ * Одночасно обробляється не більше ніж одним робочим потоком:
+ * сокет повторно "озброюється" у поллері лише після обробки.
+ */
+struct QueryServer::Connection
+{
+    intptr_t socket;
+    Session session;
+    string inBuffer;
+};
+
+/**
+ * @class QueryServer::Poller
+ * @brief Очікування подій читання з семантикою "one-shot".
+ *
+ * Після того як сокет повернуто з Wait(), він не з'явиться знову,
+ * доки його не буде повторно озброєно через Rearm().
+ */
+class QueryServer::Poller
+{
+#ifdef _WIN32
+private:
+    WinsockScope winsock;
+    intptr_t listener = INVALID_HANDLE;
+    mutex armedMutex;
+    set<intptr_t> armed;
+
+public:
+    void AddListener(intptr_t socket) { this->listener = socket; }
+
+    void AddClient(intptr_t socket) { this->Rearm(socket); }
+
+    void Rearm(intptr_t socket)
+    {
+        lock_guard<mutex> lock(this->armedMutex);
+        this->armed.insert(socket);
+    }
+
+    void Remove(intptr_t socket)
+    {
+        lock_guard<mutex> lock(this->armedMutex);
+        this->armed.erase(socket);
+    }
+
+    void Wait(vector<intptr_t>& ready, int timeoutMs)
+    {
+        ready.clear();
+
+        vector<WSAPOLLFD> fds;
+        {
+            lock_guard<mutex> lock(this->armedMutex);
+            fds.reserve(this->armed.size() + 1);
+            for (intptr_t socket : this->armed)
+            {
+                WSAPOLLFD pfd = {};
+                pfd.fd = static_cast<NativeSocket>(socket);
+                pfd.events = POLLRDNORM;
+                fds.push_back(pfd);
+            }
+        }
+
+        WSAPOLLFD listenFd = {};
+        listenFd.fd = static_cast<NativeSocket>(this->listener);
+        listenFd.events = POLLRDNORM;
+        fds.push_back(listenFd);
+
+        // WSAPoll не вміє "прокидатися" при Rearm, тому тайм-аут короткий.
+        int count = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), min(timeoutMs, 10));
+        if (count <= 0) return;
+
+        lock_guard<mutex> lock(this->armedMutex);
+        for (const WSAPOLLFD& pfd : fds)
+        {
+            if (pfd.revents == 0) continue;
+
+            intptr_t socket = static_cast<intptr_t>(pfd.fd);
+            if (socket != this->listener) this->armed.erase(socket);
+            ready.push_back(socket);
+        }
+    }
+#else
+private:
+    int epollFd;
+
+    void control(int operation, intptr_t socket, uint32_t events)
+    {
+        epoll_event event = {};
+        event.events = events;
+        event.data.fd = static_cast<int>(socket);
+        epoll_ctl(this->epollFd, operation, static_cast<int>(socket), &event);
+    }
+
+public:
+    Poller()
+        : epollFd(epoll_create1(EPOLL_CLOEXEC))
+    {
+        if (this->epollFd < 0)
+        {
+            throw runtime_error("Не вдалося створити epoll.");
+        }
+    }
+
+    ~Poller() { close(this->epollFd); }
+
+    void AddListener(intptr_t socket) { this->control(EPOLL_CTL_ADD, socket, EPOLLIN); }
+
+    void AddClient(intptr_t socket)
+    {
+        this->control(EPOLL_CTL_ADD, socket, EPOLLIN | EPOLLRDHUP | EPOLLONESHOT);
+    }
+
+    void Rearm(intptr_t socket)
+    {
+        this->control(EPOLL_CTL_MOD, socket, EPOLLIN | EPOLLRDHUP | EPOLLONESHOT);
+    }
+
+    void Remove(intptr_t socket) { this->control(EPOLL_CTL_DEL, socket, 0); }
+
+    void Wait(vector<intptr_t>& ready, int timeoutMs)
+    {
+        epoll_event events[256];
+        ready.clear();
+
+        int count = epoll_wait(this->epollFd, events, 256, timeoutMs);
+        for (int i = 0; i < count; i++)
+        {
+            ready.push_back(events[i].data.fd);
+        }
+    }
+#endif
+};
+
+QueryServer::QueryServer(Library* library, AuthManager* authManager,
+    unsigned short port, size_t workerCount)
+    : library(library),
+    authManager(authManager),
+    port(port),
+    running(false),
+    listenSocket(INVALID_HANDLE),
+    poller(make_unique<Poller>()),
+    commitRequested(0),
+    commitCompleted(0),
+    commitWrites(0),
+    commitInProgress(false),
+    loginsInFlight(0),
+    maxLoginsInFlight(0),
+    workers(workerCount)
+{
+    if (this->library == nullptr || this->authManager == nullptr)
+    {
+        throw runtime_error("QueryServer: Менеджери не ініціалізовані (null).");
+    }
+    this->maxLoginsInFlight = max<size_t>(1, this->workers.GetWorkerCount() / 2);
+}
+
+QueryServer::~QueryServer()
+{
+    this->workers.Shutdown();
+
+    lock_guard<mutex> lock(this->connectionsMutex);
+    for (const auto& pair : this->connections)
+    {
+        closeNativeSocket(pair.first);
+    }
+    this->connections.clear();
+
+    if (this->listenSocket != INVALID_HANDLE)
+    {
+        closeNativeSocket(this->listenSocket);
+    }
+}
+
+void QueryServer::Run()
+{
+    this->openListener();
+    this->running = true;
+
+    cout << "Сервер слухає порт " << this->port << " ("
+        << this->workers.GetWorkerCount() << " робочих потоків).\n";
+
+    vector<intptr_t> ready;
+    while (this->running)
+    {
+        this->poller->Wait(ready, POLL_TIMEOUT_MS);
+
+        for (intptr_t socket : ready)
+        {
+            if (socket == this->listenSocket)
+            {
+                this->acceptConnections();
+                continue;
+            }
+
+            Connection* connection = nullptr;
+            {
+                lock_guard<mutex> lock(this->connectionsMutex);
+                auto it = this->connections.find(socket);
+                if (it != this->connections.end()) connection = it->second.get();
+            }
+
+            if (connection != nullptr)
+            {
+                this->workers.Submit([this, connection] { this->serviceConnection(connection); });
+            }
+        }
+    }
+
+    lock_guard<mutex> lock(this->commitMutex);
+    cout << "Сервер зупинено. Збережень каталогу: " << this->commitWrites
+        << " (запитів на фіксацію змін: " << this->commitRequested << ").\n";
+}
+
+void QueryServer::Stop()
+{
+    this->running = false;
+}
+
+void QueryServer::openListener()
+{
+    NativeSocket socketHandle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#ifdef _WIN32
+    if (socketHandle == INVALID_SOCKET)
+#else
+    if (socketHandle < 0)
+#endif
+    {
+        throw runtime_error("Не вдалося створити сокет сервера.");
+    }
+    this->listenSocket = static_cast<intptr_t>(socketHandle);
+
+    int reuse = 1;
+    setsockopt(socketHandle, SOL_SOCKET, SO_REUSEADDR,
+        reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(this->port);
+
+    if (::bind(socketHandle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(socketHandle, LISTEN_BACKLOG) != 0)
+    {
+        throw runtime_error("Не вдалося зайняти порт " + to_string(this->port) + ".");
+    }
+
+    setNonBlocking(this->listenSocket);
+    this->poller->AddListener(this->listenSocket);
+}
+
+void QueryServer::acceptConnections()
+{
+    while (true)
+    {
+        sockaddr_in peer = {};
+        socklen_t peerLength = sizeof(peer);
+        NativeSocket client = accept(static_cast<NativeSocket>(this->listenSocket),
+            reinterpret_cast<sockaddr*>(&peer), &peerLength);
+#ifdef _WIN32
+        if (client == INVALID_SOCKET) return;
+#else
+        if (client < 0) return;
+#endif
+
+        intptr_t handle = static_cast<intptr_t>(client);
+        setNonBlocking(handle);
+
+        int noDelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY,
+            reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+        auto connection = make_unique<Connection>();
+        connection->socket = handle;
+
+        char peerAddress[INET_ADDRSTRLEN] = {};
+        if (inet_ntop(AF_INET, &peer.sin_addr, peerAddress, sizeof(peerAddress)) != nullptr)
+        {
+            connection->session.clientAddress = peerAddress;
+        }
+        {
+            lock_guard<mutex> lock(this->connectionsMutex);
+            this->connections[handle] = move(connection);
+        }
+        this->poller->AddClient(handle);
+    }
+}
+
+void QueryServer::serviceConnection(Connection* connection)
+{
+    bool peerClosed = false;
+    char buffer[READ_CHUNK_SIZE];
+
+    // Початок незавершеного рядка в inBuffer. Щойно він перевищує
+    // MAX_LINE_LENGTH, читання зупиняється: клієнт, що шле байти без
+    // переведення рядка, не роздуває буфер понад межу.
+    size_t lastNewline = connection->inBuffer.rfind('\n');
+    size_t pendingStart = (lastNewline == string::npos) ? 0 : lastNewline + 1;
+
+    while (true)
+    {
+        int n = static_cast<int>(recv(static_cast<NativeSocket>(connection->socket),
+            buffer, static_cast<int>(sizeof(buffer)), 0));
+        if (n > 0)
+        {
+            size_t appendedAt = connection->inBuffer.size();
+            connection->inBuffer.append(buffer, static_cast<size_t>(n));
+
+            size_t newline = string_view(buffer, static_cast<size_t>(n)).rfind('\n');
+            if (newline != string_view::npos) pendingStart = appendedAt + newline + 1;
+            if (connection->inBuffer.size() - pendingStart > MAX_LINE_LENGTH) break;
+            continue;
+        }
+        if (n < 0 && lastErrorWouldBlock()) break;
+
+        peerClosed = true;
+        break;
+    }
+
+    // Задовгий рядок (цілий чи ще незавершений) не виконується: запити
+    // перед ним обслуговуються, а з'єднання після відповіді закривається.
+    vector<string> lines;
+    bool lineTooLong = false;
+    size_t lineStart = 0;
+    size_t lineEnd;
+    while ((lineEnd = connection->inBuffer.find('\n', lineStart)) != string::npos)
+    {
+        if (lineEnd - lineStart > MAX_LINE_LENGTH)
+        {
+            lineTooLong = true;
+            break;
+        }
+
+        string line = connection->inBuffer.substr(lineStart, lineEnd - lineStart);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        lineStart = lineEnd + 1;
+
+        if (!line.empty()) lines.push_back(move(line));
+    }
+    connection->inBuffer.erase(0, lineStart);
+    lineTooLong = lineTooLong || connection->inBuffer.size() > MAX_LINE_LENGTH;
+
+    // Усі запити, що прийшли одним пакетом, виконуються як один батч.
+    // Виняток з обробника не повинен зупиняти весь сервер (потік пулу
+    // завершив би процес), тож він закриває лише це з'єднання.
+    string response;
+    try
+    {
+        response = this->ExecuteBatch(connection->session, lines);
+    }
+    catch (const exception& e)
+    {
+        cerr << "Помилка: Запит завершився винятком. " << e.what() << "\n";
+        response += ERR_INTERNAL + "\n";
+        connection->session.closeRequested = true;
+    }
+
+    if (lineTooLong && !connection->session.closeRequested)
+    {
+        response += ERR_LINE_TOO_LONG + "\n";
+        connection->session.closeRequested = true;
+    }
+
+    bool alive = response.empty() || sendAll(connection->socket, response);
+
+    if (!alive || peerClosed || connection->session.closeRequested)
+    {
+        this->closeConnection(connection->socket);
+        return;
+    }
+
+    this->poller->Rearm(connection->socket);
+}
+
+void QueryServer::closeConnection(intptr_t socket)
+{
+    // Стан виймаємо до закриття сокета: інакше accept() може отримати
+    // той самий дескриптор, і ми видалили б уже нове з'єднання.
+    unique_ptr<Connection> connection;
+    {
+        lock_guard<mutex> lock(this->connectionsMutex);
+        auto it = this->connections.find(socket);
+        if (it != this->connections.end())
+        {
+            connection = move(it->second);
+            this->connections.erase(it);
+        }
+    }
+
+    this->poller->Remove(socket);
+    closeNativeSocket(socket);
+}
+
+string QueryServer::ExecuteCommand(Session& session, const string& line)
+{
+    return this->ExecuteBatch(session, vector<string>{ line });
+}
+
+string QueryServer::ExecuteBatch(Session& session, const vector<string>& lines)
+{
+    vector<ParsedCommand> commands;
+    commands.reserve(lines.size());
+    for (const string& line : lines)
+    {
+        ParsedCommand parsed;
+        parsed.arguments = line;
+        parsed.name = toUpper(nextToken(parsed.arguments));
+        parsed.kind = classifyCommand(parsed.name);
+        parsed.permission = requiredPermission(parsed.name);
+        commands.push_back(move(parsed));
+    }
+
+    // Сесія могла закінчитися або користувача могли видалити між батчами.
+    if (!session.token.empty())
+    {
+        this->refreshSession(session);
+    }
+
+    string response;
+    bool mutated = false;
+    size_t i = 0;
+
+    while (i < commands.size() && !session.closeRequested)
+    {
+        CommandKind kind = commands[i].kind;
+
+        if (kind == CommandKind::Session || kind == CommandKind::Unknown)
+        {
+            response += this->executeSessionCommand(session, commands[i]);
+            i++;
+            continue;
+        }
+
+        if (!session.IsLoggedIn())
+        {
+            response += ERR_AUTH_REQUIRED + "\n";
+            i++;
+            continue;
+        }
+
+        // Сусідні команди одного типу виконуються під одним захопленням блокування.
+        size_t runEnd = i;
+        bool needsFullCatalog = false;
+        while (runEnd < commands.size() && commands[runEnd].kind == kind)
+        {
+            needsFullCatalog = needsFullCatalog || requiresFullCatalog(commands[runEnd].name);
+            runEnd++;
+        }
+
+        // Точкові запити обслуговуються вже під час прогресивного
+        // завантаження, а повні переліки чекають на його завершення.
+        if (needsFullCatalog)
+        {
+            this->library->WaitForLoad();
+        }
+
+        if (kind == CommandKind::Read)
+        {
+            shared_lock<shared_mutex> lock(this->library->GetMutex());
+            for (; i < runEnd; i++)
+            {
+                response += this->executeCatalogCommand(session, commands[i], mutated);
+            }
+        }
+        else
+        {
+            unique_lock<shared_mutex> lock(this->library->GetMutex());
+            for (; i < runEnd; i++)
+            {
+                response += this->executeCatalogCommand(session, commands[i], mutated);
+            }
+        }
+    }
+
+    if (mutated)
+    {
+        this->commitChanges();
+    }
+
+    return response;
+}
+
+bool QueryServer::refreshSession(Session& session)
+{
+    optional<SessionTable::SessionInfo> info = this->authManager->GetSession(session.token);
+    if (!info)
+    {
+        session.token.clear();
+        session.username.clear();
+        session.permissions = 0;
+        return false;
+    }
+
+    session.username = info->username;
+    session.role = info->role;
+    session.permissions = info->permissions;
+    return true;
+}
+
+string QueryServer::executeSessionCommand(Session& session, const ParsedCommand& command)
+{
+    if (command.name == "PING")
+    {
+        return RESP_OK + " PONG\n";
+    }
+
+    if (command.name == "QUIT")
+    {
+        session.closeRequested = true;
+        return RESP_OK + " BYE\n";
+    }
+
+    if (command.name == "LOGIN")
+    {
+        string rest = command.arguments;
+        string username = nextToken(rest);
+        if (username.empty() || rest.empty()) return ERR_BAD_REQUEST + "\n";
+
+        // Вхід чекає на пул перевірки паролів. Щоб хвиля входів не зайняла
+        // очікуванням усі робочі потоки, одночасних входів не більше половини.
+        if (this->loginsInFlight.fetch_add(1) >= this->maxLoginsInFlight)
+        {
+            this->loginsInFlight--;
+            return ERR_TRY_LATER + "\n";
+        }
+
+        string token;
+        AuthManager::LoginStatus status;
+        try
+        {
+            status = this->authManager->Login(username, rest, token, session.clientAddress);
+        }
+        catch (...)
+        {
+            this->loginsInFlight--;
+            throw;
+        }
+        this->loginsInFlight--;
+
+        if (status == AuthManager::LoginStatus::Busy)
+        {
+            return ERR_TRY_LATER + "\n";
+        }
+        if (status == AuthManager::LoginStatus::RateLimited)
+        {
+            return ERR_RATE_LIMITED + "\n";
+        }
+        if (status != AuthManager::LoginStatus::Success)
+        {
+            session.Reset();
+            return ERR_AUTH_FAILED + "\n";
+        }
+
+        session.token = token;
+        if (!this->refreshSession(session)) return ERR_AUTH_FAILED + "\n";
+        return RESP_OK + " " + UserAccount::GetRoleName(session.role)
+            + " " + session.token + "\n";
+    }
+
+    if (command.name == "RESUME")
+    {
+        string token = command.arguments;
+        if (token.empty()) return ERR_BAD_REQUEST + "\n";
+
+        session.Reset();
+        session.token = token;
+        if (!this->refreshSession(session)) return ERR_AUTH_FAILED + "\n";
+        return RESP_OK + " " + UserAccount::GetRoleName(session.role) + "\n";
+    }
+
+    if (command.name == "LOGOUT")
+    {
+        this->authManager->Logout(session.token);
+        session.Reset();
+        return RESP_OK + "\n";
+    }
+
+    if (command.name == "BEGIN")
+    {
+        if (!session.IsLoggedIn()) return ERR_AUTH_REQUIRED + "\n";
+        if (session.transaction) return ERR_IN_TRANSACTION + "\n";
+
+        session.transaction = make_unique<LibraryTransaction>(*this->library);
+        return RESP_OK + "\n";
+    }
+
+    if (command.name == "ABORT")
+    {
+        if (!session.transaction) return ERR_NO_TRANSACTION + "\n";
+
+        session.transaction.reset();
+        return RESP_OK + "\n";
+    }
+
+    return ERR_UNKNOWN_COMMAND + "\n";
+}
+
+string QueryServer::executeCatalogCommand(Session& session,
+    const ParsedCommand& command, bool& mutated)
+{
+    if (!session.Can(command.permission)) return ERR_FORBIDDEN + "\n";
+
+    string rest = command.arguments;
+
+    if (command.name == "FIND")
+    {
+        string article = nextToken(rest);
+        if (article.empty()) return ERR_BAD_REQUEST + "\n";
+
+        const Library* catalog = this->library;
+        const Book* book = catalog->FindBookByArticle(article);
+        if (book == nullptr) return ERR_NOT_FOUND + "\n";
+
+        return RESP_OK + " " + book->ToCsvString() + "\n";
+    }
+
+    if (command.name == "MFIND")
+    {
+        vector<string> articles;
+        for (string article = nextToken(rest); !article.empty(); article = nextToken(rest))
+        {
+            articles.push_back(article);
+        }
+        if (articles.empty()) return ERR_BAD_REQUEST + "\n";
+
+        vector<const Book*> books = this->library->FindBooksByArticles(articles);
+
+        string response = RESP_OK + " " + to_string(books.size()) + "\n";
+        for (const Book* book : books)
+        {
+            if (book == nullptr)
+            {
+                response += ERR_NOT_FOUND + "\n";
+            }
+            else
+            {
+                response += RESP_OK + " " + book->ToCsvString() + "\n";
+            }
+        }
+        return response;
+    }
+
+    if (command.name == "LIST")
+    {
+        return formatBookList(this->library->GetAllBooks());
+    }
+
+    if (command.name == "FILTER")
+    {
+        string field = toUpper(nextToken(rest));
+        if (rest.empty()) return ERR_BAD_REQUEST + "\n";
+
+        if (field == "AUTHOR")
+        {
+            return formatBookList(this->library->FilterByAuthor(rest));
+        }
+        if (field == "SHELF")
+        {
+            try
+            {
+                return formatBookList(this->library->FilterByShelf(stoi(rest)));
+            }
+            catch (const exception&)
+            {
+                return ERR_BAD_REQUEST + "\n";
+            }
+        }
+        if (field == "PRICE")
+        {
+            try
+            {
+                Money minPrice = Money::Parse(nextToken(rest));
+                Money maxPrice = Money::Parse(nextToken(rest));
+                return formatBookList(this->library->FilterByPriceRange(minPrice, maxPrice));
+            }
+            catch (const exception&)
+            {
+                return ERR_BAD_REQUEST + "\n";
+            }
+        }
+        return ERR_BAD_REQUEST + "\n";
+    }
+
+    if (command.name == "SORT")
+    {
+        string field = toUpper(nextToken(rest));
+
+        if (field == "TITLE") this->library->SortByTitle();
+        else if (field == "AUTHOR") this->library->SortByAuthor();
+        else if (field == "PRICE") this->library->SortByPrice();
+        else return ERR_BAD_REQUEST + "\n";
+
+        mutated = true;
+        return RESP_OK + "\n";
+    }
+
+    if (command.name == "COMMIT")
+    {
+        if (!session.transaction) return ERR_NO_TRANSACTION + "\n";
+
+        size_t operationCount = session.transaction->GetOperationCount();
+        LibraryTransaction::CommitResult result = session.transaction->Commit();
+        session.transaction.reset();
+
+        if (!result.Succeeded()) return formatCommitError(result);
+
+        mutated = mutated || operationCount > 0;
+        return RESP_OK + " " + to_string(operationCount) + "\n";
+    }
+
+    string article = nextToken(rest);
+    if (article.empty()) return ERR_BAD_REQUEST + "\n";
+
+    if (command.name == "ISSUE")
+    {
+        // Звичайний читач може взяти книгу лише на себе (як і в UIManager).
+        string readerName = session.username;
+        if (!rest.empty())
+        {
+            if (!session.Can(UserAccount::Permission::IssueToOthers)) return ERR_FORBIDDEN + "\n";
+            readerName = rest;
+        }
+
+        if (session.transaction)
+        {
+            session.transaction->StageIssue(article, readerName);
+            return RESP_QUEUED + "\n";
+        }
+
+        Library::LoanStatus status = this->library->IssueBook(article, readerName);
+        if (status == Library::LoanStatus::NotFound) return ERR_NOT_FOUND + "\n";
+        if (status == Library::LoanStatus::AlreadyIssued) return ERR_BOOK_BUSY + "\n";
+        if (status == Library::LoanStatus::ReaderNameTooLong) return ERR_BAD_REQUEST + "\n";
+
+        mutated = true;
+        return RESP_OK + "\n";
+    }
+
+    // RETURN
+    if (session.transaction)
+    {
+        session.transaction->StageReturn(article);
+        return RESP_QUEUED + "\n";
+    }
+
+    Library::LoanStatus status = this->library->ReturnBook(article);
+    if (status == Library::LoanStatus::NotFound) return ERR_NOT_FOUND + "\n";
+    if (status == Library::LoanStatus::NotIssued) return ERR_BOOK_AVAILABLE + "\n";
+
+    mutated = true;
+    return RESP_OK + "\n";
+}
+
+void QueryServer::commitChanges()
+{
+    unique_lock<mutex> lock(this->commitMutex);
+    uint64_t ticket = ++this->commitRequested;
+
+    while (this->commitCompleted < ticket)
+    {
+        if (this->commitInProgress)
+        {
+            this->commitCondition.wait(lock);
+            continue;
+        }
+
+        // Цей потік стає "лідером" і одним записом фіксує всі зміни,
+        // про які попросили до цього моменту.
+        this->commitInProgress = true;
+        uint64_t target = this->commitRequested;
+        lock.unlock();
+
+        try
+        {
+            // Поки каталог ще дозавантажується, файл перезаписувати не можна,
+            // а неповний (після помилки завантаження) - не можна взагалі.
+            this->library->WaitForLoad();
+
+            if (this->library->IsLoaded())
+            {
+                shared_lock<shared_mutex> catalogLock(this->library->GetMutex());
+                this->library->SaveToFile();
+            }
+            else
+            {
+                cerr << "Помилка: Каталог завантажено не повністю, зміни не збережено.\n";
+            }
+        }
+        catch (const exception& e)
+        {
+            cerr << "Помилка: Не вдалося зберегти зміни. " << e.what() << "\n";
+        }
+
+        lock.lock();
+        this->commitInProgress = false;
+        this->commitCompleted = target;
+        this->commitWrites++;
+        this->commitCondition.notify_all();
+    }
+}
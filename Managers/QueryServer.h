@@ -0,0 +1,235 @@
+#pragma once
+#include "../Core/WorkerPool.h"
+#include "LibraryTransaction.h"
+#include "../Entities/UserAccount.h"
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+class Library;
+class AuthManager;
+
+ /**
+  * @class QueryServer
+  * @brief Мережевий (headless) інтерфейс до Library та AuthManager.
+  *
+  * Приймає TCP-з'єднання та обробляє текстовий протокол, де кожен
+  * запит і кожна відповідь - окремий рядок. Один потік очікує події
+  * сокетів (epoll на Linux, WSAPoll на Windows), а самі запити
+  * виконуються у пулі робочих потоків. Доступ до каталогу захищено
+  * Library::GetMutex(): пошук та фільтрація йдуть паралельно, зміни -
+  * ексклюзивно.
+  *
+  * Команди протоколу:
+  *  PING | LOGIN <логін> <пароль> | RESUME <токен> | LOGOUT | QUIT
+  *  FIND <артикул> | MFIND <артикул> <артикул>... | LIST
+  *  FILTER AUTHOR <автор> | FILTER SHELF <номер> | FILTER PRICE <від> <до>
+  *  SORT TITLE|AUTHOR|PRICE | ISSUE <артикул> [ПІБ] | RETURN <артикул>
+  *  BEGIN | COMMIT | ABORT - між BEGIN і COMMIT видача та повернення
+  *  лише накопичуються ("OK QUEUED") і фіксуються разом або не фіксуються
+  *  зовсім ("ERR <код> <номер операції>").
+  *
+  * Команди каталогу вимагають відповідного права ролі (перегляд, сортування,
+  * видача; ISSUE на інше ПІБ - лише бібліотекар чи адмін), інакше
+  * відповідь "ERR FORBIDDEN".
+  *
+  * Відповідь: "OK [дані]" або "ERR <код>". Списки повертаються як
+  * "OK <n>" і далі n рядків у форматі CSV; MFIND - "OK <n>" і n рядків
+  * "OK <CSV>" / "ERR NOT_FOUND". LOGIN відповідає "OK <тип> <токен>";
+  * з токеном RESUME продовжує ту саму сесію в іншому з'єднанні. Під час
+  * хвилі входів LOGIN може відповісти "ERR TRY_LATER" - повторіть пізніше,
+  * а на забагато спроб з одним логіном чи адресою - "ERR RATE_LIMITED".
+  * Рядок, довший за 64 КБ, не виконується ("ERR LINE_TOO_LONG"), а збій
+  * обробки відповідає "ERR INTERNAL"; в обох випадках з'єднання закривається.
+  *
+  * Клієнт може надсилати кілька запитів, не чекаючи відповідей (pipelining).
+  * Усе, що прийшло одним пакетом, виконується як батч: сусідні запити
+  * читання/зміни йдуть під одним захопленням блокування, а всі зміни
+  * батча фіксуються у файлі разом (group commit) до надсилання відповідей.
+  */
+class QueryServer
+{
+public:
+    /**
+     * @struct Session
+     * @brief Стан автентифікації одного клієнта.
+     * Джерело істини - сесія AuthManager за токеном; username, роль і
+     * маска прав оновлюються з неї на початку кожного батча, тож
+     * перевірка права на команду - лише бітова операція.
+     */
+    struct Session
+    {
+        string token;
+        string username;
+        string clientAddress;
+        UserAccount::Role role = UserAccount::Role::Reader;
+        UserAccount::PermissionMask permissions = 0;
+        bool closeRequested = false;
+        unique_ptr<LibraryTransaction> transaction;
+
+        bool IsLoggedIn() const { return !username.empty(); }
+
+        bool Can(UserAccount::Permission permission) const
+        {
+            return UserAccount::HasPermission(this->permissions, permission);
+        }
+
+        /**
+         * @brief Скидає автентифікацію, зберігаючи адресу клієнта.
+         */
+        void Reset()
+        {
+            string address = move(this->clientAddress);
+            *this = Session();
+            this->clientAddress = move(address);
+        }
+    };
+
+    /**
+     * @brief Тип команди з точки зору блокувань каталогу.
+     */
+    enum class CommandKind
+    {
+        Session,
+        Read,
+        Write,
+        Unknown
+    };
+
+private:
+    struct Connection;
+    class Poller;
+
+    struct ParsedCommand
+    {
+        string name;
+        string arguments;
+        CommandKind kind;
+        UserAccount::Permission permission;
+    };
+
+    Library* library;
+    AuthManager* authManager;
+    unsigned short port;
+    atomic<bool> running;
+
+    intptr_t listenSocket;
+    unique_ptr<Poller> poller;
+
+    mutex commitMutex;
+    condition_variable commitCondition;
+    uint64_t commitRequested;
+    uint64_t commitCompleted;
+    uint64_t commitWrites;
+    bool commitInProgress;
+
+    mutex connectionsMutex;
+    map<intptr_t, unique_ptr<Connection>> connections;
+
+    atomic<size_t> loginsInFlight;
+    size_t maxLoginsInFlight;
+
+    // Оголошено останнім, щоб пул зупинявся раніше за стан з'єднань.
+    WorkerPool workers;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param library Вказівник на екземпляр Library.
+     * @param authManager Вказівник на екземпляр AuthManager.
+     * @param port TCP-порт для прослуховування.
+     * @param workerCount Кількість робочих потоків (0 - за кількістю ядер).
+     */
+    QueryServer(Library* library, AuthManager* authManager,
+        unsigned short port, size_t workerCount);
+
+    /**
+     * @brief Деструктор. Закриває всі з'єднання.
+     */
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    /**
+     * @brief Запускає цикл обробки подій. Блокує, доки не викликано Stop().
+     */
+    void Run();
+
+    /**
+     * @brief Просить сервер завершити роботу (безпечно з іншого потоку).
+     */
+    void Stop();
+
+    /**
+     * @brief Виконує один рядок протоколу від імені сесії.
+     * @param session Стан клієнта (змінюється командами LOGIN/LOGOUT/QUIT).
+     * @param line Рядок запиту без символу кінця рядка.
+     * @return Відповідь (один або кілька рядків, кожен закінчується '\n').
+     */
+    string ExecuteCommand(Session& session, const string& line);
+
+    /**
+     * @brief Виконує кілька рядків протоколу як один батч.
+     * Відповіді повертаються у порядку запитів; зміни зберігаються один раз.
+     * @param session Стан клієнта.
+     * @param lines Рядки запитів.
+     * @return Відповіді на всі запити, об'єднані в один буфер.
+     */
+    string ExecuteBatch(Session& session, const vector<string>& lines);
+
+private:
+    /**
+     * @brief Створює сокет, що слухає порт.
+     */
+    void openListener();
+
+    /**
+     * @brief Приймає всі очікуючі з'єднання.
+     */
+    void acceptConnections();
+
+    /**
+     * @brief Читає запити з'єднання, виконує їх та надсилає відповіді.
+     * Викликається у робочому потоці.
+     * @param connection З'єднання, яке готове до читання.
+     */
+    void serviceConnection(Connection* connection);
+
+    /**
+     * @brief Закриває з'єднання та звільняє його стан.
+     * @param socket Сокет з'єднання.
+     */
+    void closeConnection(intptr_t socket);
+
+    /**
+     * @brief Оновлює ім'я та права сесії з AuthManager за її токеном.
+     * @return false, якщо сесія закінчилась (стан сесії очищується).
+     */
+    bool refreshSession(Session& session);
+
+    /**
+     * @brief Виконує команду, що не торкається каталогу (PING, LOGIN...).
+     */
+    string executeSessionCommand(Session& session, const ParsedCommand& command);
+
+    /**
+     * @brief Виконує команду над каталогом. Блокування вже має бути захоплене.
+     * @param mutated Встановлюється в true, якщо команда змінила каталог.
+     */
+    string executeCatalogCommand(Session& session,
+        const ParsedCommand& command, bool& mutated);
+
+    /**
+     * @brief Зберігає каталог у файл, об'єднуючи одночасні запити (group commit).
+     * Повертає керування, коли зміни, зроблені до виклику, записано.
+     */
+    void commitChanges();
+};
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "RateLimiter.h"
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    const size_t SHARD_COUNT = 16;
+}
+
+RateLimiter::RateLimiter(double capacity, double refillPerSecond, size_t maxBuckets)
+    : capacity(max(1.0, capacity)),
+    refillPerSecond(refillPerSecond),
+    maxBucketsPerShard(max<size_t>(1, maxBuckets / SHARD_COUNT)),
+    shards(SHARD_COUNT)
+{
+}
+
+bool RateLimiter::TryAcquire(const string& key)
+{
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    Shard& shard = this->shardFor(key);
+    lock_guard<mutex> lock(shard.shardMutex);
+
+    auto found = shard.buckets.find(key);
+    if (found == shard.buckets.end())
+    {
+        if (shard.buckets.size() >= this->maxBucketsPerShard)
+        {
+            shard.buckets.erase(shard.recent.back().key);
+            shard.recent.pop_back();
+        }
+
+        shard.recent.push_front(Bucket{ key, this->capacity - 1, now });
+        shard.buckets.emplace(key, shard.recent.begin());
+        return true;
+    }
+
+    // Відро переноситься на початок списку: воно щойно використане.
+    shard.recent.splice(shard.recent.begin(), shard.recent, found->second);
+    Bucket& bucket = *found->second;
+
+    double elapsed = chrono::duration<double>(now - bucket.updatedAt).count();
+    bucket.tokens = min(this->capacity, bucket.tokens + elapsed * this->refillPerSecond);
+    bucket.updatedAt = now;
+
+    if (bucket.tokens < 1.0)
+    {
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+size_t RateLimiter::GetBucketCount()
+{
+    size_t count = 0;
+    for (Shard& shard : this->shards)
+    {
+        lock_guard<mutex> lock(shard.shardMutex);
+        count += shard.buckets.size();
+    }
+    return count;
+}
+
+RateLimiter::Shard& RateLimiter::shardFor(const string& key)
+{
+    return this->shards[hash<string>()(key) % this->shards.size()];
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+
+using namespace std;
+
+ /**
+  * @class RateLimiter
+  * @brief Обмежувач частоти за ключем на основі "відер з токенами" (token bucket).
+  *
+  * Кожен ключ (логін, адреса клієнта) має відро на capacity токенів, що
+  * поповнюється зі швидкістю refillPerSecond; кожна спроба забирає один
+  * токен. Відро поповнюється ліниво під час перевірки, тож перевірка - O(1)
+  * без фонових потоків.
+  *
+  * Таблиця поділена на шарди зі своїм mutex. Пам'ять обмежена: у кожному
+  * шарді відра впорядковані за останнім використанням, і при переповненні
+  * відкидається найдовше не використане (LRU) - воно найімовірніше вже повне.
+  */
+class RateLimiter
+{
+private:
+    struct Bucket
+    {
+        string key;
+        double tokens;
+        chrono::steady_clock::time_point updatedAt;
+    };
+
+    struct Shard
+    {
+        mutex shardMutex;
+        list<Bucket> recent;
+        unordered_map<string, list<Bucket>::iterator> buckets;
+    };
+
+    double capacity;
+    double refillPerSecond;
+    size_t maxBucketsPerShard;
+    vector<Shard> shards;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param capacity Найбільша кількість спроб підряд (розмір відра).
+     * @param refillPerSecond Скільки спроб на секунду відновлюється.
+     * @param maxBuckets Найбільша кількість ключів, що зберігаються одночасно.
+     */
+    RateLimiter(double capacity, double refillPerSecond, size_t maxBuckets);
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * @brief Забирає один токен із відра ключа.
+     * @return false, якщо відро порожнє (спробу слід відхилити).
+     */
+    bool TryAcquire(const string& key);
+
+    /**
+     * @brief Кількість відер, що зараз зберігаються.
+     */
+    size_t GetBucketCount();
+
+private:
+    Shard& shardFor(const string& key);
+};
\ No newline at end of file
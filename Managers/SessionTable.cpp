@@ -0,0 +1,153 @@
+#include "SessionTable.h"
+#include <random>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    const size_t SHARD_COUNT = 16;
+    const size_t WHEEL_SLOTS = 512;
+    const size_t TOKEN_WORDS = 4;
+    const char HEX_DIGITS[] = "0123456789abcdef";
+}
+
+SessionTable::SessionTable(chrono::seconds idleTimeout)
+    : startTime(chrono::steady_clock::now()),
+    idleTimeoutTicks(max<uint64_t>(1, static_cast<uint64_t>(idleTimeout.count()))),
+    shards(SHARD_COUNT)
+{
+    for (Shard& shard : this->shards)
+    {
+        shard.wheel.resize(WHEEL_SLOTS);
+    }
+}
+
+string SessionTable::Create(const string& username, UserAccount::Role role)
+{
+    // random_device - криптографічне джерело на Linux та Windows,
+    // тож токен не можна вгадати за попередніми.
+    random_device randomSource;
+    string token;
+    token.reserve(TOKEN_WORDS * 8);
+    for (size_t i = 0; i < TOKEN_WORDS; i++)
+    {
+        uint32_t word = randomSource();
+        for (int shift = 28; shift >= 0; shift -= 4)
+        {
+            token += HEX_DIGITS[(word >> shift) & 0x0f];
+        }
+    }
+
+    UserAccount::PermissionMask permissions = UserAccount::GetRolePermissions(role);
+    uint64_t now = this->currentTick();
+    Shard& shard = this->shardFor(token);
+    lock_guard<mutex> lock(shard.shardMutex);
+    this->advance(shard, now);
+
+    uint64_t expiresAt = now + this->idleTimeoutTicks;
+    shard.entries[token] = Entry{ SessionInfo{ username, role, permissions }, expiresAt };
+    this->schedule(shard, token, expiresAt);
+    return token;
+}
+
+optional<SessionTable::SessionInfo> SessionTable::Find(const string& token)
+{
+    if (token.empty()) return nullopt;
+
+    uint64_t now = this->currentTick();
+    Shard& shard = this->shardFor(token);
+    lock_guard<mutex> lock(shard.shardMutex);
+    this->advance(shard, now);
+
+    auto it = shard.entries.find(token);
+    if (it == shard.entries.end())
+    {
+        return nullopt;
+    }
+
+    // Слот у колесі не переставляється: при його проходженні запис
+    // побачить новий строк і сам переїде далі.
+    it->second.expiresAt = now + this->idleTimeoutTicks;
+    return it->second.info;
+}
+
+bool SessionTable::Remove(const string& token)
+{
+    Shard& shard = this->shardFor(token);
+    lock_guard<mutex> lock(shard.shardMutex);
+
+    // Токен лишається в слоті колеса і буде пропущений при його проходженні.
+    return shard.entries.erase(token) > 0;
+}
+
+size_t SessionTable::RemoveUser(const string& username)
+{
+    size_t removed = 0;
+    for (Shard& shard : this->shards)
+    {
+        lock_guard<mutex> lock(shard.shardMutex);
+        removed += erase_if(shard.entries, [&username](const auto& pair)
+            {
+                return pair.second.info.username == username;
+            });
+    }
+    return removed;
+}
+
+size_t SessionTable::GetCount()
+{
+    size_t count = 0;
+    for (Shard& shard : this->shards)
+    {
+        lock_guard<mutex> lock(shard.shardMutex);
+        count += shard.entries.size();
+    }
+    return count;
+}
+
+SessionTable::Shard& SessionTable::shardFor(const string& token)
+{
+    return this->shards[hash<string>()(token) % this->shards.size()];
+}
+
+uint64_t SessionTable::currentTick() const
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::seconds>(
+        chrono::steady_clock::now() - this->startTime).count());
+}
+
+void SessionTable::advance(Shard& shard, uint64_t now)
+{
+    if (shard.nextTick > now) return;
+
+    // Після довгої паузи досить одного оберту: кожен слот пройдено раз,
+    // а все, що не прострочене, переставлено відносно поточної секунди.
+    uint64_t slotsToVisit = min<uint64_t>(now - shard.nextTick + 1, WHEEL_SLOTS);
+    uint64_t tick = now + 1 - slotsToVisit;
+
+    vector<string> due;
+    for (; tick <= now; tick++)
+    {
+        due.clear();
+        due.swap(shard.wheel[tick % WHEEL_SLOTS]);
+
+        for (string& token : due)
+        {
+            auto it = shard.entries.find(token);
+            if (it == shard.entries.end()) continue;
+
+            if (it->second.expiresAt <= now)
+                shard.entries.erase(it);
+            else
+                this->schedule(shard, token, it->second.expiresAt);
+        }
+    }
+    shard.nextTick = now + 1;
+}
+
+void SessionTable::schedule(Shard& shard, const string& token, uint64_t expiresAt)
+{
+    shard.wheel[expiresAt % WHEEL_SLOTS].push_back(token);
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+#include "../Entities/UserAccount.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <optional>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class SessionTable
+  * @brief Таблиця сесій: непрозорий токен -> користувач.
+  *
+  * Таблиця поділена на шарди за хешем токена, кожен зі своїм mutex, тож
+  * одночасні запити різних клієнтів майже ніколи не чекають один на одного.
+  *
+  * Сесія живе, доки нею користуються: кожне звернення продовжує строк.
+  * Прострочені сесії прибирає колесо таймерів (timer wheel) кожного шарда:
+  * токен лежить у слоті секунди, коли він мав би закінчитися, і при
+  * проходженні слота або видаляється, або (якщо сесією користувались)
+  * переноситься у слот нового строку. Повного перегляду таблиці немає -
+  * лише слоти, час яких уже настав.
+  */
+class SessionTable
+{
+public:
+    /**
+     * @brief Дані сесії, що повертаються за токеном.
+     */
+    struct SessionInfo
+    {
+        string username;
+        UserAccount::Role role;
+        UserAccount::PermissionMask permissions;
+    };
+
+private:
+    struct Entry
+    {
+        SessionInfo info;
+        uint64_t expiresAt;
+    };
+
+    struct Shard
+    {
+        mutex shardMutex;
+        unordered_map<string, Entry> entries;
+        vector<vector<string>> wheel;
+        uint64_t nextTick = 0;
+    };
+
+    chrono::steady_clock::time_point startTime;
+    uint64_t idleTimeoutTicks;
+    vector<Shard> shards;
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param idleTimeout Час без звернень, після якого сесія закінчується.
+     */
+    explicit SessionTable(chrono::seconds idleTimeout);
+
+    SessionTable(const SessionTable&) = delete;
+    SessionTable& operator=(const SessionTable&) = delete;
+
+    /**
+     * @brief Відкриває нову сесію. Права ролі обчислюються тут один раз
+     * і далі перевіряються бітовою операцією над маскою сесії.
+     * @return Випадковий токен (32 шістнадцяткові символи).
+     */
+    string Create(const string& username, UserAccount::Role role);
+
+    /**
+     * @brief Знаходить сесію за токеном і продовжує її строк.
+     * @return Дані сесії, або порожнє значення, якщо токен невідомий чи прострочений.
+     */
+    optional<SessionInfo> Find(const string& token);
+
+    /**
+     * @brief Закриває сесію.
+     * @return false, якщо такої сесії немає.
+     */
+    bool Remove(const string& token);
+
+    /**
+     * @brief Закриває всі сесії користувача (напр., після його видалення).
+     * Переглядає всі шарди, тож призначено для рідкісних дій адміністратора.
+     * @return Кількість закритих сесій.
+     */
+    size_t RemoveUser(const string& username);
+
+    /**
+     * @brief Кількість відкритих сесій (разом із ще не прибраними простроченими).
+     */
+    size_t GetCount();
+
+private:
+    Shard& shardFor(const string& token);
+
+    /**
+     * @brief Поточний час у секундах від створення таблиці.
+     */
+    uint64_t currentTick() const;
+
+    /**
+     * @brief Проходить слоти колеса до поточної секунди. Шард уже заблоковано.
+     */
+    void advance(Shard& shard, uint64_t now);
+
+    void schedule(Shard& shard, const string& token, uint64_t expiresAt);
+};
\ No newline at end of file
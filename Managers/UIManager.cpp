@@ -6,44 +6,66 @@
 #include <limits>
 #include <stdexcept>
 #include <algorithm>
+#include <optional>
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <iomanip>
 
 using namespace std;
 
 namespace
 {
-    const string PROMPT_CHOICE = " :";
-    const string PROMPT_LOGIN = " :";
-    const string PROMPT_PASSWORD = " :";
-    const string PROMPT_ARTICLE = " :";
-    const string PROMPT_TITLE = " :";
-    const string PROMPT_AUTHOR = " :";
-    const string PROMPT_PRICE = " ֳ ():";
-    const string PROMPT_SHELF = "  :";
-    const string PROMPT_READER_NAME = " ϲ :";
-    const string PROMPT_CONTINUE = "\n Enter  ...";
-
-    const string MSG_EXIT = "  .  !";
-    const string MSG_LOGIN_SUCCESS = " . ³, ";
-    const string MSG_SUCCESS = "  .";
-    const string MSG_CANCELLED = " .";
-    const string MSG_EMPTY_LIB = "  .";
-    const string MSG_NOT_FOUND_SEARCH = "ͳ  .";
-
-    const string ERR_INVALID_INPUT = ":  .";
-    const string ERR_LOGIN_FAILED = ":    .";
-    const string ERR_NOT_FOUND = ": '  .";
-    const string ERR_ALREADY_EXISTS = ":  '  .";
-    const string ERR_ITEM_BUSY = ":     .";
-    const string ERR_ITEM_AVAILABLE = ":     ( ).";
-    const string ERR_SELF_DELETE = ":      .";
-}
-
-UIManager::UIManager(Library* library, AuthManager* authManager)
-    : library(library), authManager(authManager)
+    const string PROMPT_CHOICE = "Ваш вибір:";
+    const string PROMPT_LOGIN = "Введіть логін:";
+    const string PROMPT_PASSWORD = "Введіть пароль:";
+    const string PROMPT_ARTICLE = "Введіть Артикул:";
+    const string PROMPT_TITLE = "Введіть Назву:";
+    const string PROMPT_AUTHOR = "Введіть Автора:";
+    const string PROMPT_PRICE = "Введіть Ціну (грн):";
+    const string PROMPT_SHELF = "Введіть Номер Полиці:";
+    const string PROMPT_MIN_PRICE = "Мінімальна ціна (грн):";
+    const string PROMPT_MAX_PRICE = "Максимальна ціна (грн):";
+    const string PROMPT_TITLE_FROM = "Назви від (напр., А):";
+    const string PROMPT_TITLE_TO = "Назви до (включно, напр., Г):";
+    const string PROMPT_READER_NAME = "Введіть ПІБ читача:";
+    const string PROMPT_FILE_PATH = "Введіть шлях до CSV-файлу:";
+    const string PROMPT_CONTINUE = "\nНатисніть Enter щоб продовжити...";
+
+    const string PROMPT_PAGER = "Enter/n - далі, p - назад, <номер> - перейти на сторінку, q - вихід: ";
+    const string CLEAR_SCREEN = "\x1b[2J\x1b[H";
+
+    const size_t BROWSE_PAGE_SIZE = 20;
+    const size_t MAX_IMPORT_ERRORS_SHOWN = 20;
+    const size_t TOP_READERS_SHOWN = 10;
+    const int STATS_KEY_WIDTH = 18;
+    const int STATS_NUMBER_WIDTH = 11;
+
+    const string MSG_EXIT = "Завершення роботи програми. До побачення!";
+    const string MSG_LOGIN_SUCCESS = "Вхід успішний. Вітаємо, ";
+    const string MSG_SUCCESS = "Операцію виконано успішно.";
+    const string MSG_CANCELLED = "Операцію скасовано.";
+    const string MSG_EMPTY_LIB = "Бібліотека наразі порожня.";
+    const string MSG_NOT_FOUND_SEARCH = "Нічого не знайдено.";
+
+    const string ERR_INVALID_INPUT = "Помилка: Некоректне введення.";
+    const string ERR_LOGIN_FAILED = "Помилка: Невірний логін або пароль.";
+    const string ERR_LOGIN_BUSY = "Помилка: Забагато одночасних спроб входу. Спробуйте пізніше.";
+    const string ERR_LOGIN_RATE_LIMITED = "Помилка: Забагато спроб входу. Зачекайте кілька секунд.";
+    const string ERR_SESSION_EXPIRED = "Сесія завершилась через тривалу бездіяльність. Увійдіть знову.";
+    const string ERR_NOT_FOUND = "Помилка: Об'єкт не знайдено.";
+    const string ERR_ALREADY_EXISTS = "Помилка: Такий об'єкт вже існує.";
+    const string ERR_ITEM_BUSY = "Помилка: Книга вже видана або недоступна.";
+    const string ERR_ITEM_AVAILABLE = "Помилка: Книга вже в бібліотеці (не видана).";
+    const string ERR_SELF_DELETE = "Помилка: Ви не можете видалити самі себе.";
+}
+
+UIManager::UIManager(Library* library, AuthManager* authManager, Executor* executor)
+    : library(library), authManager(authManager), executor(executor)
 {
     if (this->library == nullptr || this->authManager == nullptr)
     {
-        throw runtime_error("UIManager:    (null).");
+        throw runtime_error("UIManager: Менеджери не ініціалізовані (null).");
     }
 }
 
@@ -55,7 +77,9 @@ void UIManager::StartMainLoop()
 
         if (!loggedIn) break;
 
-        if (authManager->IsAdmin())
+        if (!RefreshSession()) continue;
+
+        if (Can(UserAccount::Permission::EditCatalog))
         {
             ShowAdminMainMenu();
         }
@@ -64,16 +88,38 @@ void UIManager::StartMainLoop()
             ShowUserMainMenu();
         }
     }
+
+    ReportPendingSave();
     cout << MSG_EXIT << "\n";
 }
 
+bool UIManager::RefreshSession()
+{
+    optional<SessionTable::SessionInfo> session = authManager->GetSession(sessionToken);
+    if (!session)
+    {
+        currentUser.clear();
+        permissions = 0;
+        return false;
+    }
+
+    currentUser = session->username;
+    permissions = session->permissions;
+    return true;
+}
+
+bool UIManager::Can(UserAccount::Permission permission) const
+{
+    return UserAccount::HasPermission(permissions, permission);
+}
+
 bool UIManager::HandleLogin()
 {
     while (true)
     {
-        cout << "\n---    ---\n";
-        cout << "1. \n";
-        cout << "2. \n";
+        cout << "\n--- Вхід до Системи ---\n";
+        cout << "1. Увійти\n";
+        cout << "2. Вийти\n";
         int choice = GetMenuChoice(2);
 
         if (choice == 2) return false;
@@ -81,15 +127,21 @@ bool UIManager::HandleLogin()
         string username = GetStringInput(PROMPT_LOGIN);
         string password = GetStringInput(PROMPT_PASSWORD);
 
-        if (authManager->Login(username, password))
+        AuthManager::LoginStatus status = authManager->Login(username, password, sessionToken);
+        if (status == AuthManager::LoginStatus::Success)
         {
-            cout << MSG_LOGIN_SUCCESS << authManager->GetCurrentUser() << "!\n";
+            cout << MSG_LOGIN_SUCCESS << authManager->GetCurrentUser(sessionToken) << "!\n";
             PressEnterToContinue();
             return true;
         }
         else
         {
-            cout << ERR_LOGIN_FAILED << "\n";
+            if (status == AuthManager::LoginStatus::RateLimited)
+                cout << ERR_LOGIN_RATE_LIMITED << "\n";
+            else if (status == AuthManager::LoginStatus::Busy)
+                cout << ERR_LOGIN_BUSY << "\n";
+            else
+                cout << ERR_LOGIN_FAILED << "\n";
             PressEnterToContinue();
         }
     }
@@ -100,28 +152,51 @@ void UIManager::ShowAdminMainMenu()
     bool running = true;
     while (running)
     {
-        cout << "\n---   () ---\n";
-        cout << ": " << authManager->GetCurrentUser() << "\n";
-
-        cout << "---   ---\n";
-        cout << "1.   \n";
-        cout << "2.   \n";
-        cout << "3.  \n";
-        cout << "4.  \n";
-
-        cout << "--- ĳ   ---\n";
-        cout << "5.   ( )\n";
-        cout << "6. Գ \n";
-        cout << "7.  \n";
-        cout << "8.   \n";
-        cout << "9.    \n";
-
-        cout << "---  ---\n";
-        cout << "10.  ()\n";
-        cout << "11. \n";
-        cout << "12.   \n";
+        if (!RefreshSession())
+        {
+            cout << ERR_SESSION_EXPIRED << "\n";
+            return;
+        }
 
-        int choice = GetMenuChoice(12);
+        bool canManageUsers = Can(UserAccount::Permission::ManageUsers);
+
+        cout << (canManageUsers ? "\n--- Головне Меню (Адміністратор) ---\n"
+            : "\n--- Головне Меню (Бібліотекар) ---\n");
+        cout << "Користувач: " << currentUser << "\n";
+
+        cout << "--- Керування Книгами ---\n";
+        cout << "1. Список усіх книг\n";
+        cout << "2. Додати нову книгу\n";
+        cout << "3. Оновити книгу\n";
+        cout << "4. Видалити книгу\n";
+        cout << "5. Імпорт книг з CSV\n";
+        cout << "6. Експорт каталогу в CSV\n";
+
+        cout << "--- Дії з Книгами ---\n";
+        cout << "7. Пошук книги (за Артикулом)\n";
+        cout << "8. Фільтрація книг\n";
+        cout << "9. Сортування книг\n";
+        cout << "10. Видати книгу читачу\n";
+        cout << "11. Повернути книгу в бібліотеку\n";
+        cout << "12. Статистика каталогу\n";
+
+        cout << "--- Система ---\n";
+        int choice;
+        if (canManageUsers)
+        {
+            cout << "13. Адміністрування (Користувачі)\n";
+            cout << "14. Допомога\n";
+            cout << "15. Вийти з акаунту\n";
+            choice = GetMenuChoice(15);
+        }
+        else
+        {
+            // Без пункту 13 наступні пункти зсуваються на один номер вгору.
+            cout << "13. Допомога\n";
+            cout << "14. Вийти з акаунту\n";
+            choice = GetMenuChoice(14);
+            if (choice >= 13) choice++;
+        }
 
         switch (choice)
         {
@@ -129,16 +204,19 @@ void UIManager::ShowAdminMainMenu()
         case 2: DoAddBook(); break;
         case 3: DoUpdateBook(); break;
         case 4: DoDeleteBook(); break;
-        case 5: DoFindBookByArticle(); break;
-        case 6: DoFilterBooks(); break;
-        case 7: DoSortBooks(); break;
-        case 8: DoIssueBook(); break;
-        case 9: DoReturnBook(); break;
-        case 10: ShowAdminMenu(); break;
-        case 11: ShowHelpScreen(); break;
-        case 12:
+        case 5: DoImportBooks(); break;
+        case 6: DoExportBooks(); break;
+        case 7: DoFindBookByArticle(); break;
+        case 8: DoFilterBooks(); break;
+        case 9: DoSortBooks(); break;
+        case 10: DoIssueBook(); break;
+        case 11: DoReturnBook(); break;
+        case 12: DoShowStatistics(); break;
+        case 13: ShowAdminMenu(); break;
+        case 14: ShowHelpScreen(); break;
+        case 15:
             running = false;
-            authManager->Logout();
+            authManager->Logout(sessionToken);
             break;
         }
     }
@@ -149,18 +227,25 @@ void UIManager::ShowUserMainMenu()
     bool running = true;
     while (running)
     {
-        cout << "\n---   ---\n";
-        cout << ": " << authManager->GetCurrentUser() << "\n";
-        cout << "1.   \n";
-        cout << "2.   ( )\n";
-        cout << "3. Գ \n";
-        cout << "4.  \n";
-        cout << "5.   ()\n";
-        cout << "6.  \n";
-        cout << "7. \n";
-        cout << "8.   \n";
+        if (!RefreshSession())
+        {
+            cout << ERR_SESSION_EXPIRED << "\n";
+            return;
+        }
 
-        int choice = GetMenuChoice(8);
+        cout << "\n--- Головне Меню ---\n";
+        cout << "Користувач: " << currentUser << "\n";
+        cout << "1. Список усіх книг\n";
+        cout << "2. Пошук книги (за Артикулом)\n";
+        cout << "3. Фільтрація книг\n";
+        cout << "4. Сортування книг\n";
+        cout << "5. Взяти книгу (Видача)\n";
+        cout << "6. Повернути книгу\n";
+        cout << "7. Мої книги\n";
+        cout << "8. Допомога\n";
+        cout << "9. Вийти з акаунту\n";
+
+        int choice = GetMenuChoice(9);
 
         switch (choice)
         {
@@ -170,10 +255,11 @@ void UIManager::ShowUserMainMenu()
         case 4: DoSortBooks(); break;
         case 5: DoIssueBook(); break;
         case 6: DoReturnBook(); break;
-        case 7: ShowHelpScreen(); break;
-        case 8:
+        case 7: DoShowMyLoans(); break;
+        case 8: ShowHelpScreen(); break;
+        case 9:
             running = false;
-            authManager->Logout();
+            authManager->Logout(sessionToken);
             break;
         }
     }
@@ -184,11 +270,11 @@ void UIManager::ShowAdminMenu()
     bool running = true;
     while (running)
     {
-        cout << "\n---   () ---\n";
-        cout << "1.   \n";
-        cout << "2.   \n";
-        cout << "3.  \n";
-        cout << "4.    \n";
+        cout << "\n--- Меню Адміністратора (Користувачі) ---\n";
+        cout << "1. Список усіх користувачів\n";
+        cout << "2. Створити нового користувача\n";
+        cout << "3. Видалити користувача\n";
+        cout << "4. Назад до Головного Меню\n";
 
         int choice = GetMenuChoice(4);
 
@@ -204,38 +290,49 @@ void UIManager::ShowAdminMenu()
 
 void UIManager::ShowHelpScreen()
 {
-    cout << "\n---  ---\n";
-    cout << "    .\n";
-
-    cout << "\n==   ==\n";
-    cout << "  ,      .\n";
-
-    cout << "\n==   ==\n";
-    cout << "-    (y/n),  'y' ()  'n' ().\n";
-
-    cout << "\n==   ==\n";
-    cout << "  :   ,    .\n";
-    cout << " :      .\n";
-    cout << "Գ:     (  ).\n";
-    cout << ":    ,   .\n";
-    cout << " :     .\n";
-    cout << " :      .\n";
-
-    if (authManager->IsAdmin())
+    cout << "\n--- Довідка ---\n";
+    cout << "Це автоматизована система управління бібліотекою.\n";
+
+    cout << "\n== Призначення програми ==\n";
+    cout << "Керування колекцією книг, відстеження їх статусу та управління користувачами.\n";
+
+    cout << "\n== Загальні правила ==\n";
+    cout << "- Коли система запитує (y/n), введіть 'y' (так) або 'n' (ні).\n";
+
+    cout << "\n== Опис команд ==\n";
+    cout << "Список усіх книг: Показати всі книги, що є в базі.\n";
+    cout << "Пошук книги: Знайти одну книгу за унікальним Артикулом.\n";
+    cout << "Фільтрація: Показати книги за критерієм (автор, полиця, діапазон цін або назв, наявність).\n";
+    cout << "Сортування: Впорядкувати список за назвою, автором або ціною.\n";
+    cout << "Взяти книгу: Позначити книгу як видану читачу.\n";
+    cout << "Повернути книгу: Позначити книгу як доступну в бібліотеці.\n";
+    if (!Can(UserAccount::Permission::EditCatalog))
     {
-        cout << "\n==    (ҳ ) ==\n";
-        cout << "-  :  Enter,    .\n";
-        cout << "-       '.\n";
-        cout << "- : . 6 , /.\n";
-        cout << "- /: . 16 .\n";
-        cout << "- : . 5 .\n";
-        cout << "- ֳ: ,  0.\n";
+        cout << "Мої книги: Показати книги, які зараз видані вам.\n";
+    }
 
-        cout << "\n==   ==\n";
-        cout << "// : "
-            << "  .\n";
-        cout << " (): "
-            << "   .\n";
+    if (Can(UserAccount::Permission::EditCatalog))
+    {
+        cout << "\n== Правила вводу даних (Адмін і Бібліотекар) ==\n";
+        cout << "- При оновленні: натисніть Enter, щоб залишити старе значення.\n";
+        cout << "- При додаванні книги всі поля є обов'язковими.\n";
+        cout << "- Артикул: макс. 6 символів, латиниця/цифри.\n";
+        cout << "- Назва/Автор: макс. 16 символів.\n";
+        cout << "- Полиця: макс. 5 цифр.\n";
+        cout << "- Ціна: число, більше 0.\n";
+
+        cout << "\n== Команди Адміністратора та Бібліотекаря ==\n";
+        cout << "Додати/Оновити/Видалити книгу: "
+            << "Повне керування каталогом.\n";
+        cout << "Імпорт/Експорт CSV: "
+            << "Пакетне додавання книг з файлу (усе або нічого) та вивантаження каталогу.\n";
+        cout << "Статистика каталогу: "
+            << "Кількість книг і ціни за полицями, авторами та наявністю; найактивніші читачі.\n";
+        if (Can(UserAccount::Permission::ManageUsers))
+        {
+            cout << "Адміністрування (Користувачі): "
+                << "Створення та видалення акаунтів (читач, бібліотекар, адмін).\n";
+        }
     }
 
     PressEnterToContinue();
@@ -244,7 +341,7 @@ void UIManager::ShowHelpScreen()
 Book* UIManager::PromptAndFindBook(const string& actionName)
 {
     cout << "\n--- " << actionName << " ---\n";
-    string article = GetStringInput(" :");
+    string article = GetStringInput("Введіть Артикул:");
 
     Book* book = library->FindBookByArticle(article);
     if (book == nullptr)
@@ -259,7 +356,7 @@ string UIManager::GetValidNewArticle()
 {
     while (true)
     {
-        string article = GetStringInput(" :");
+        string article = GetStringInput("Введіть Артикул:");
 
         if (article.length() > 6)
         {
@@ -293,26 +390,113 @@ string UIManager::GetValidNewArticle()
     }
 }
 
+void UIManager::PrintBooks(const vector<Book>& books)
+{
+    // Рядки збираються у спільний буфер і йдуть у консоль блоками по
+    // кілька десятків КБ, а не вісьмома операторами << на кожну книгу.
+    string& buffer = console.GetBuffer();
+    Book::AppendTableHeader(buffer);
+    for (const Book& book : books)
+    {
+        book.AppendTableRow(buffer);
+        console.FlushIfFull();
+    }
+    buffer += "Усього книг: ";
+    buffer += to_string(books.size());
+    buffer += '\n';
+    console.Flush();
+}
+
 void UIManager::DoListAllBooks()
 {
-    cout << "\n---    ---\n";
-    if (library->IsEmpty())
+    EnsureCatalogLoaded();
+    cout << "\n--- Список Усіх Книг ---\n";
+    cout << "Порядок: 1. Як у каталозі  2. За назвою  3. За ціною\n";
+
+    Library::PageOrder order;
+    switch (GetMenuChoice(3))
     {
-        cout << MSG_EMPTY_LIB << "\n";
+    case 2: order = Library::PageOrder::Title; break;
+    case 3: order = Library::PageOrder::Price; break;
+    default: order = Library::PageOrder::Catalog; break;
     }
-    else
+
+    size_t page = 0;
+    while (true)
     {
-        for (const auto& book : library->GetAllBooks())
+        // З каталогу копіюється лише видима сторінка, тож перегортання
+        // не залежить від розміру каталогу.
+        vector<Book> books;
+        size_t total;
+        size_t pageCount;
+        {
+            shared_lock<shared_mutex> lock(library->GetMutex());
+            total = library->GetBookCount();
+            pageCount = max<size_t>(1, (total + BROWSE_PAGE_SIZE - 1) / BROWSE_PAGE_SIZE);
+            page = min(page, pageCount - 1);
+            books = library->GetPage(page * BROWSE_PAGE_SIZE, BROWSE_PAGE_SIZE, order);
+        }
+
+        ClearScreen();
+        if (total == 0)
+        {
+            cout << MSG_EMPTY_LIB << "\n";
+            PressEnterToContinue();
+            return;
+        }
+
+        string& buffer = console.GetBuffer();
+        buffer += "--- Список Усіх Книг: сторінка ";
+        buffer += to_string(page + 1);
+        buffer += " з ";
+        buffer += to_string(pageCount);
+        buffer += " (книг: ";
+        buffer += to_string(total);
+        buffer += ") ---\n";
+        Book::AppendTableHeader(buffer);
+        for (const Book& book : books)
         {
-            book.Display();
+            book.AppendTableRow(buffer);
+        }
+        buffer += PROMPT_PAGER;
+        console.Flush();
+
+        string command;
+        if (!getline(cin, command)) break;
+
+        char key = command.empty() ? 'n' : static_cast<char>(tolower(static_cast<unsigned char>(command[0])));
+        if (key == 'q')
+        {
+            break;
+        }
+        else if (key == 'n')
+        {
+            if (page + 1 < pageCount) page++;
+        }
+        else if (key == 'p')
+        {
+            if (page > 0) page--;
+        }
+        else
+        {
+            try
+            {
+                size_t target = stoul(command);
+                if (target >= 1) page = min(target, pageCount) - 1;
+            }
+            catch (const exception&)
+            {
+                // Невідома команда: сторінка просто показується знову.
+            }
         }
     }
-    PressEnterToContinue();
+    ClearScreen();
 }
 
 void UIManager::DoAddBook()
 {
-    cout << "\n---    ---\n";
+    EnsureCatalogLoaded();
+    cout << "\n--- Додавання Нової Книги ---\n";
 
     try
     {
@@ -325,9 +509,15 @@ void UIManager::DoAddBook()
         int shelf = GetIntInput(PROMPT_SHELF);
 
         Book newBook(article, author, title, price, shelf);
-        if (library->AddBook(newBook))
+        bool added;
+        {
+            unique_lock<shared_mutex> lock(library->GetMutex());
+            added = library->AddBook(newBook);
+        }
+        if (added)
         {
             cout << MSG_SUCCESS << "\n";
+            SaveInBackground();
         }
     }
     catch (const exception&)
@@ -339,24 +529,48 @@ void UIManager::DoAddBook()
 
 void UIManager::DoFindBookByArticle()
 {
-    Book* book = PromptAndFindBook(" ");
-    if (book != nullptr)
+    cout << "\n--- Пошук Книги ---\n";
+    string article = GetStringInput(PROMPT_ARTICLE);
+
+    // Пошук під блокуванням і показ копії працює й тоді, коли каталог
+    // ще дозавантажується у фоні (запис підтягується за індексом).
+    optional<Book> book;
+    {
+        shared_lock<shared_mutex> lock(library->GetMutex());
+        const Book* found = library->FindBookByArticle(article);
+        if (found != nullptr) book = *found;
+    }
+
+    if (!book)
+    {
+        cout << ERR_NOT_FOUND << "\n";
+    }
+    else
     {
-        cout << " :\n";
+        cout << "Книгу знайдено:\n";
         book->Display();
-        PressEnterToContinue();
     }
+    PressEnterToContinue();
 }
 
 void UIManager::DoDeleteBook()
 {
-    Book* book = PromptAndFindBook(" ");
+    EnsureCatalogLoaded();
+    Book* book = PromptAndFindBook("Видалення Книги");
     if (book != nullptr)
     {
-        if (GetYesNoInput("  ? (y/n):"))
+        if (GetYesNoInput("Видалити цю книгу? (y/n):"))
         {
-            if (library->DeleteBook(book->GetArticle()))
+            bool deleted;
+            {
+                unique_lock<shared_mutex> lock(library->GetMutex());
+                deleted = library->DeleteBook(book->GetArticle());
+            }
+            if (deleted)
+            {
                 cout << MSG_SUCCESS << "\n";
+                SaveInBackground();
+            }
         }
         else
         {
@@ -368,7 +582,8 @@ void UIManager::DoDeleteBook()
 
 void UIManager::DoIssueBook()
 {
-    Book* book = PromptAndFindBook(" ");
+    EnsureCatalogLoaded();
+    Book* book = PromptAndFindBook("Видача Книги");
     if (book != nullptr)
     {
         if (!book->IsAvailable())
@@ -378,13 +593,25 @@ void UIManager::DoIssueBook()
         else
         {
             string readerName;
-            if (authManager->IsAdmin())
+            if (Can(UserAccount::Permission::IssueToOthers))
                 readerName = GetStringInput(PROMPT_READER_NAME);
             else
-                readerName = authManager->GetCurrentUser();
+                readerName = currentUser;
 
-            book->IssueToReader(readerName);
-            cout << MSG_SUCCESS << "\n";
+            Library::LoanStatus status;
+            {
+                unique_lock<shared_mutex> lock(library->GetMutex());
+                status = library->IssueBook(book->GetArticle(), readerName);
+            }
+            if (status == Library::LoanStatus::Done)
+            {
+                cout << MSG_SUCCESS << "\n";
+                SaveInBackground();
+            }
+            else
+            {
+                cout << ERR_INVALID_INPUT << "\n";
+            }
         }
         PressEnterToContinue();
     }
@@ -392,7 +619,8 @@ void UIManager::DoIssueBook()
 
 void UIManager::DoReturnBook()
 {
-    Book* book = PromptAndFindBook(" ");
+    EnsureCatalogLoaded();
+    Book* book = PromptAndFindBook("Повернення Книги");
     if (book != nullptr)
     {
         if (book->IsAvailable())
@@ -401,46 +629,76 @@ void UIManager::DoReturnBook()
         }
         else
         {
-            book->ReturnToLibrary();
+            {
+                unique_lock<shared_mutex> lock(library->GetMutex());
+                library->ReturnBook(book->GetArticle());
+            }
             cout << MSG_SUCCESS << "\n";
+            SaveInBackground();
         }
         PressEnterToContinue();
     }
 }
 
+void UIManager::DoShowMyLoans()
+{
+    EnsureCatalogLoaded();
+    cout << "\n--- Мої Книги ---\n";
+
+    vector<Book> loans;
+    {
+        shared_lock<shared_mutex> lock(library->GetMutex());
+        loans = library->GetLoansByReader(currentUser);
+    }
+
+    if (loans.empty())
+        cout << MSG_NOT_FOUND_SEARCH << "\n";
+    else
+        PrintBooks(loans);
+
+    PressEnterToContinue();
+}
+
 void UIManager::DoUpdateBook()
 {
-    Book* bookToUpdate = PromptAndFindBook(" ");
+    EnsureCatalogLoaded();
+    Book* bookToUpdate = PromptAndFindBook("Оновлення Книги");
 
     if (bookToUpdate == nullptr)
     {
         return;
     }
 
-    cout << " :\n";
+    cout << "Поточні дані:\n";
     bookToUpdate->Display();
-    cout << "   (Enter -  ):\n";
+    cout << "Введіть нові дані (Enter - залишити старі):\n";
 
     Book updatedData = *bookToUpdate;
     string input;
 
     try
     {
-        cout << ": "; getline(cin, input);
+        cout << "Назва: "; getline(cin, input);
         if (!input.empty()) updatedData.SetBookTitle(input);
 
-        cout << ": "; getline(cin, input);
+        cout << "Автор: "; getline(cin, input);
         if (!input.empty()) updatedData.SetAuthorName(input);
 
-        cout << "ֳ: "; getline(cin, input);
+        cout << "Ціна: "; getline(cin, input);
         if (!input.empty()) updatedData.SetPrice(stod(input));
 
-        cout << ": "; getline(cin, input);
+        cout << "Полиця: "; getline(cin, input);
         if (!input.empty()) updatedData.SetShelfNumber(stoi(input));
 
-        if (library->UpdateBook(bookToUpdate->GetArticle(), updatedData))
+        bool updated;
+        {
+            unique_lock<shared_mutex> lock(library->GetMutex());
+            updated = library->UpdateBook(bookToUpdate->GetArticle(), updatedData);
+        }
+        if (updated)
         {
             cout << MSG_SUCCESS << "\n";
+            SaveInBackground();
         }
     }
     catch (const exception& e)
@@ -452,68 +710,250 @@ void UIManager::DoUpdateBook()
 
 void UIManager::DoFilterBooks()
 {
-    cout << "\n--- Գ  ---\n";
-    cout << "1.  \n";
-    cout << "2.   \n";
-    int choice = GetMenuChoice(2);
+    EnsureCatalogLoaded();
+    cout << "\n--- Фільтрація Книг ---\n";
+    cout << "1. За Автором\n";
+    cout << "2. За Номером Полиці\n";
+    cout << "3. За Діапазоном Ціни\n";
+    cout << "4. За Діапазоном Назв\n";
+    cout << "5. Лише доступні\n";
+    cout << "6. Лише видані\n";
+    cout << "7. Кілька критеріїв (полиця, автор, наявність)\n";
+    int choice = GetMenuChoice(7);
 
     vector<Book> results;
     if (choice == 1)
         results = library->FilterByAuthor(GetStringInput(PROMPT_AUTHOR));
-    else
+    else if (choice == 2)
         results = library->FilterByShelf(GetIntInput(PROMPT_SHELF));
+    else if (choice == 3)
+    {
+        Money minPrice = Money::FromDouble(GetDoubleInput(PROMPT_MIN_PRICE));
+        Money maxPrice = Money::FromDouble(GetDoubleInput(PROMPT_MAX_PRICE));
+        results = library->FilterByPriceRange(minPrice, maxPrice);
+    }
+    else if (choice == 4)
+    {
+        string fromTitle = GetStringInput(PROMPT_TITLE_FROM);
+        string toTitle = GetStringInput(PROMPT_TITLE_TO);
+        results = library->FilterByTitleRange(fromTitle, toTitle);
+    }
+    else if (choice == 5)
+        results = library->GetAvailableBooks();
+    else if (choice == 6)
+        results = library->GetIssuedBooks();
+    else
+    {
+        Library::BookQuery query;
+        if (GetYesNoInput("Обмежити номером полиці? (y/n):"))
+            query.shelfNumber = GetIntInput(PROMPT_SHELF);
+        if (GetYesNoInput("Обмежити автором? (y/n):"))
+            query.authorName = GetStringInput(PROMPT_AUTHOR);
+        if (GetYesNoInput("Лише доступні книги? (y/n):"))
+            query.available = true;
+        results = library->FilterBooks(query);
+    }
 
     if (results.empty())
         cout << MSG_NOT_FOUND_SEARCH << "\n";
     else
-        for (const auto& book : results) book.Display();
+        PrintBooks(results);
 
     PressEnterToContinue();
 }
 
 void UIManager::DoSortBooks()
 {
-    cout << "\n---   ---\n";
-    cout << "1.  \n";
-    cout << "2.  \n";
-    cout << "3.  ֳ\n";
+    EnsureCatalogLoaded();
+    cout << "\n--- Сортування Книг ---\n";
+    cout << "1. За Назвою\n";
+    cout << "2. За Автором\n";
+    cout << "3. За Ціною\n";
     int choice = GetMenuChoice(3);
 
-    if (choice == 1) library->SortByTitle();
-    else if (choice == 2) library->SortByAuthor();
-    else if (choice == 3) library->SortByPrice();
+    {
+        unique_lock<shared_mutex> lock(library->GetMutex());
+        if (choice == 1) library->SortByTitle();
+        else if (choice == 2) library->SortByAuthor();
+        else if (choice == 3) library->SortByPrice();
+    }
+    SaveInBackground();
 
-    cout << " . ";
-    if (GetYesNoInput("? (y/n):"))
+    cout << "Список відсортовано. ";
+    if (GetYesNoInput("Показати? (y/n):"))
         DoListAllBooks();
 }
 
+void UIManager::DoShowStatistics()
+{
+    EnsureCatalogLoaded();
+    cout << "\n--- Статистика Каталогу ---\n";
+
+    Library::PriceStats totals;
+    Library::PriceStats issued;
+    {
+        shared_lock<shared_mutex> lock(library->GetMutex());
+        totals = library->GetTotals();
+        issued = library->GetStatistics(Library::GroupBy::Availability).back().stats;
+    }
+
+    cout << fixed << setprecision(2);
+    cout << "Усього книг: " << totals.count << ", загальна вартість: " << totals.sum << " грн\n";
+    if (totals.count > 0)
+    {
+        cout << "Видано: " << issued.count << " ("
+            << 100.0 * issued.count / totals.count << "%)\n";
+    }
+
+    cout << "\n1. За Полицями\n";
+    cout << "2. За Авторами\n";
+    cout << "3. За Наявністю\n";
+    cout << "4. Найактивніші читачі\n";
+    int choice = GetMenuChoice(4);
+
+    if (choice == 4)
+    {
+        vector<pair<string, size_t>> readers;
+        {
+            shared_lock<shared_mutex> lock(library->GetMutex());
+            readers = library->GetTopReaders(TOP_READERS_SHOWN);
+        }
+
+        if (readers.empty())
+            cout << MSG_NOT_FOUND_SEARCH << "\n";
+        for (const auto& reader : readers)
+        {
+            cout << left << setw(STATS_KEY_WIDTH) << reader.first << right << reader.second << "\n";
+        }
+        PressEnterToContinue();
+        return;
+    }
+
+    Library::GroupBy groupBy = Library::GroupBy::Availability;
+    if (choice == 1) groupBy = Library::GroupBy::Shelf;
+    else if (choice == 2) groupBy = Library::GroupBy::Author;
+
+    vector<Library::GroupStats> groups;
+    {
+        shared_lock<shared_mutex> lock(library->GetMutex());
+        groups = library->GetStatistics(groupBy);
+    }
+
+    cout << left << setw(STATS_KEY_WIDTH) << "Група" << right
+        << setw(STATS_NUMBER_WIDTH) << "Книг"
+        << setw(STATS_NUMBER_WIDTH) << "Сума"
+        << setw(STATS_NUMBER_WIDTH) << "Середня"
+        << setw(STATS_NUMBER_WIDTH) << "Мін."
+        << setw(STATS_NUMBER_WIDTH) << "Макс." << "\n";
+    for (const auto& group : groups)
+    {
+        const Library::PriceStats& stats = group.stats;
+        cout << left << setw(STATS_KEY_WIDTH) << group.key << right
+            << setw(STATS_NUMBER_WIDTH) << stats.count
+            << setw(STATS_NUMBER_WIDTH) << stats.sum
+            << setw(STATS_NUMBER_WIDTH) << stats.Average()
+            << setw(STATS_NUMBER_WIDTH) << stats.min
+            << setw(STATS_NUMBER_WIDTH) << stats.max << "\n";
+    }
+    PressEnterToContinue();
+}
+
+void UIManager::DoImportBooks()
+{
+    EnsureCatalogLoaded();
+    cout << "\n--- Імпорт Книг з CSV ---\n";
+    string filePath = GetStringInput(PROMPT_FILE_PATH);
+
+    try
+    {
+        Library::BulkResult result;
+        {
+            unique_lock<shared_mutex> lock(library->GetMutex());
+            result = library->ImportCsv(filePath, true);
+        }
+
+        if (!result.Succeeded())
+        {
+            cout << "Знайдено помилок: " << result.errors.size() << "\n";
+            size_t shown = min(result.errors.size(), MAX_IMPORT_ERRORS_SHOWN);
+            for (size_t i = 0; i < shown; i++)
+            {
+                const Library::BulkError& error = result.errors[i];
+                cout << "  Рядок " << error.row << " (" << error.article << "): "
+                     << error.message << "\n";
+            }
+            if (shown < result.errors.size())
+                cout << "  ...\n";
+
+            if (!GetYesNoInput("Імпортувати лише коректні рядки? (y/n):"))
+            {
+                cout << MSG_CANCELLED << " Каталог не змінено.\n";
+                PressEnterToContinue();
+                return;
+            }
+
+            unique_lock<shared_mutex> lock(library->GetMutex());
+            result = library->ImportCsv(filePath, false);
+        }
+
+        if (result.applied > 0) SaveInBackground();
+        cout << "Імпортовано книг: " << result.applied << "\n";
+    }
+    catch (const exception& e)
+    {
+        cout << "Помилка: " << e.what() << "\n";
+    }
+    PressEnterToContinue();
+}
+
+void UIManager::DoExportBooks()
+{
+    EnsureCatalogLoaded();
+    cout << "\n--- Експорт Каталогу в CSV ---\n";
+    string filePath = GetStringInput(PROMPT_FILE_PATH);
+
+    if (library->ExportCsv(filePath))
+        cout << MSG_SUCCESS << "\n";
+    else
+        cout << "Помилка: Не вдалося записати файл " << filePath << "\n";
+    PressEnterToContinue();
+}
+
 void UIManager::DoListUsers()
 {
-    cout << "\n---   ---\n";
-    authManager->ListUsers();
+    cout << "\n--- Список Користувачів ---\n";
+    authManager->ListUsers(sessionToken);
     PressEnterToContinue();
 }
 
 void UIManager::DoCreateUser()
 {
-    cout << "\n---   ---\n";
+    cout << "\n--- Створення Користувача ---\n";
     string user = GetStringInput(PROMPT_LOGIN);
     string pass = GetStringInput(PROMPT_PASSWORD);
 
-    authManager->CreateUser(user, pass, false);
+    cout << "Роль: 1. Читач  2. Бібліотекар  3. Адміністратор\n";
+    UserAccount::Role role;
+    switch (GetMenuChoice(3))
+    {
+    case 2: role = UserAccount::Role::Librarian; break;
+    case 3: role = UserAccount::Role::Admin; break;
+    default: role = UserAccount::Role::Reader; break;
+    }
+
+    authManager->CreateUser(sessionToken, user, pass, role);
     PressEnterToContinue();
 }
 
 void UIManager::DoDeleteUser()
 {
-    cout << "\n---   ---\n";
+    cout << "\n--- Видалення Користувача ---\n";
     string user = GetStringInput(PROMPT_LOGIN);
 
-    if (user == authManager->GetCurrentUser())
+    if (user == currentUser)
         cout << ERR_SELF_DELETE << "\n";
     else
-        authManager->DeleteUser(user);
+        authManager->DeleteUser(sessionToken, user);
 
     PressEnterToContinue();
 }
@@ -584,14 +1024,54 @@ bool UIManager::GetYesNoInput(const string& prompt)
         string s = GetStringInput(prompt);
         if (s == "y" || s == "Y") return true;
         if (s == "n" || s == "N") return false;
-        cout << " ,  'y'  'n'.\n";
+        cout << "Будь ласка, введіть 'y' або 'n'.\n";
     }
 }
 
+void UIManager::EnsureCatalogLoaded()
+{
+    if (library->IsLoading())
+    {
+        cout << "Зачекайте, каталог ще завантажується...\n";
+        library->WaitForLoad();
+    }
+}
+
+void UIManager::SaveInBackground()
+{
+    if (executor == nullptr) return;
+
+    ReportPendingSave();
+    pendingSave = library->SaveAsync(*executor);
+    pendingSave.Start();
+}
+
+void UIManager::ReportPendingSave()
+{
+    if (!pendingSave.IsValid()) return;
+
+    try
+    {
+        pendingSave.Get();
+    }
+    catch (const exception& e)
+    {
+        // Незбережені зміни лишаються позначеними: їх запише наступне
+        // збереження або вихід із програми.
+        cerr << "Помилка: Не вдалося зберегти зміни у фоні. " << e.what() << "\n";
+    }
+    pendingSave = Task<void>();
+}
+
 void UIManager::PressEnterToContinue()
 {
     cout << PROMPT_CONTINUE << flush;
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-    system("cls");
+    ClearScreen();
+}
+
+void UIManager::ClearScreen()
+{
+    cout << CLEAR_SCREEN << flush;
 }
\ No newline at end of file
@@ -1,174 +1,250 @@
 #pragma once
+#include "../Core/Task.h"
+#include "../Core/ConsoleBuffer.h"
+#include "../Entities/UserAccount.h"
 #include <string>
+#include <vector>
 
 using namespace std;
 
 class Library;
 class AuthManager;
+class Executor;
+class Book;
 
 /**
  * @class UIManager
- * @brief     .
+ * @brief Керує всім консольним інтерфейсом користувача.
  *
- *  䳺 ,     
- *   .
+ * Не володіє менеджерами, а отримує вказівники на них
+ * для виконання операцій.
  */
 class UIManager
 {
 public:
     /**
-     * @brief .
-     * @param library    Library.
-     * @param authManager    AuthManager.
+     * @brief Конструктор.
+     * @param library Вказівник на екземпляр Library.
+     * @param authManager Вказівник на екземпляр AuthManager.
+     * @param executor Виконавець для фонового збереження (nullptr - зберігати лише при виході).
      */
-    UIManager(Library* library, AuthManager* authManager);
+    UIManager(Library* library, AuthManager* authManager, Executor* executor = nullptr);
 
     /**
-     * @brief    .
-     *    .
+     * @brief Запускає головний цикл інтерфейсу.
+     * Починається з екрану логіна.
      */
     void StartMainLoop();
 
 private:
     /**
-     * @brief   ,    .
-     * @return true,   , false -   .
+     * @brief Показує екран логіна, доки користувач не увійде.
+     * @return true, якщо вхід успішний, false - якщо користувач вийшов.
      */
     bool HandleLogin();
 
     /**
-     * @brief ³    .
+     * @brief Оновлює логін і права з сесії (один пошук сесії).
+     * @return false, якщо сесія закінчилась.
+     */
+    bool RefreshSession();
+
+    /**
+     * @brief Перевіряє право поточної сесії (бітова перевірка маски).
+     */
+    bool Can(UserAccount::Permission permission) const;
+
+    /**
+     * @brief Відображає головне меню для адміністратора та бібліотекаря.
+     * Пункт керування користувачами показується лише з правом ManageUsers.
      */
     void ShowAdminMainMenu();
 
     /**
-     * @brief ³     .
+     * @brief Відображає обмежене меню для читача.
      */
     void ShowUserMainMenu();
 
     /**
-     * @brief ³   (  ).
+     * @brief Відображає меню адміністратора (для керування користувачами).
      */
     void ShowAdminMenu();
 
     /**
-     * @brief   .
+     * @brief Показує екран допомоги.
      */
     void ShowHelpScreen();
 
     /**
-     * @brief       .
-     * @param maxOption   .
-     * @return   ().
+     * @brief Очищує екран ANSI-послідовністю (без запуску процесу).
+     */
+    void ClearScreen();
+
+    /**
+     * @brief Виводить книги компактною таблицею через буфер консолі.
+     * @param books Книги для виводу.
+     */
+    void PrintBooks(const vector<Book>& books);
+
+    /**
+     * @brief Отримує та валідує вибір користувача в меню.
+     * @param maxOption Максимальний номер опції.
+     * @return Вибір користувача (число).
      */
     int GetMenuChoice(int maxOption);
 
     /**
-     * @brief     (    ).
-     * @param prompt   .
-     * @return  .
+     * @brief Отримує рядок від користувача (з валідацією на порожній ввід).
+     * @param prompt Повідомлення для користувача.
+     * @return Введений рядок.
      */
     string GetStringInput(const string& prompt);
 
     /**
-     * @brief     .
-     * @param prompt   .
-     * @return  .
+     * @brief Отримує ціле число від користувача.
+     * @param prompt Повідомлення для користувача.
+     * @return Введене число.
      */
     int GetIntInput(const string& prompt);
 
     /**
-     * @brief     .
-     * @param prompt   .
-     * @return  .
+     * @brief Отримує число з плаваючою комою.
+     * @param prompt Повідомлення для користувача.
+     * @return Введене число.
      */
     double GetDoubleInput(const string& prompt);
 
     /**
-     * @brief   /ͳ.
-     * @param prompt   .
-     * @return true,  'y', false -  'n'.
+     * @brief Отримує відповідь Так/Ні.
+     * @param prompt Повідомлення для користувача.
+     * @return true, якщо 'y', false - якщо 'n'.
      */
     bool GetYesNoInput(const string& prompt);
 
     /**
-     * @brief   Enter     .
+     * @brief Очікує натискання Enter від користувача та очищує екран.
      */
     void PressEnterToContinue();
 
     /**
-     * @brief  ,     .
-     * @param actionName   䳿 ( ).
-     * @return     nullptr,   /.
+     * @brief Чекає кінця фонового завантаження перед операціями,
+     * яким потрібен увесь каталог (список, фільтр, сортування, зміни).
+     */
+    void EnsureCatalogLoaded();
+
+    /**
+     * @brief Запускає фонове збереження каталогу після зміни.
+     * Меню при цьому одразу готове до наступної команди.
+     */
+    void SaveInBackground();
+
+    /**
+     * @brief Дочікується попереднього фонового збереження й повідомляє,
+     * якщо воно не вдалося (інакше виняток задачі ніхто б не прочитав).
+     */
+    void ReportPendingSave();
+
+    /**
+     * @brief Запитує артикул, шукає книгу та обробляє помилки.
+     * @param actionName Назва поточної дії (для заголовка).
+     * @return Вказівник на книгу або nullptr, якщо не знайдено/скасовано.
      */
     class Book* PromptAndFindBook(const string& actionName);
 
     /**
-     * @brief      (, ).
-     * @return      ().
+     * @brief Отримує та валідує новий артикул (унікальність, формат).
+     * @return Коректний артикул або порожній рядок (скасування).
      */
     string GetValidNewArticle();
 
     /**
-     * @brief     .
+     * @brief Виконує сценарій додавання нової книги.
      */
     void DoAddBook();
 
     /**
-     * @brief    .
+     * @brief Виводить список усіх книг.
      */
     void DoListAllBooks();
 
     /**
-     * @brief     .
+     * @brief Виконує пошук книги за артикулом.
      */
     void DoFindBookByArticle();
 
     /**
-     * @brief     .
+     * @brief Виконує фільтрацію книг за критеріями.
      */
     void DoFilterBooks();
 
     /**
-     * @brief   .
+     * @brief Виконує сортування книг.
      */
     void DoSortBooks();
 
     /**
-     * @brief    .
+     * @brief Виконує оновлення даних книги.
      */
     void DoUpdateBook();
 
     /**
-     * @brief   .
+     * @brief Виконує видалення книги.
      */
     void DoDeleteBook();
 
     /**
-     * @brief    .
+     * @brief Виконує видачу книги читачу.
      */
     void DoIssueBook();
 
     /**
-     * @brief     .
+     * @brief Виконує повернення книги в бібліотеку.
      */
     void DoReturnBook();
 
     /**
-     * @brief   .
+     * @brief Виводить книги, видані поточному користувачу.
+     */
+    void DoShowMyLoans();
+
+    /**
+     * @brief Виводить статистику каталогу за полицями, авторами,
+     * наявністю та найактивніших читачів.
+     */
+    void DoShowStatistics();
+
+    /**
+     * @brief Імпортує книги з CSV-файлу (усе або нічого; за помилок
+     * пропонує імпортувати лише коректні рядки).
+     */
+    void DoImportBooks();
+
+    /**
+     * @brief Експортує каталог у CSV-файл.
+     */
+    void DoExportBooks();
+
+    /**
+     * @brief Створює нового користувача.
      */
     void DoCreateUser();
 
     /**
-     * @brief  .
+     * @brief Видаляє користувача.
      */
     void DoDeleteUser();
 
     /**
-     * @brief    .
+     * @brief Виводить список усіх користувачів.
      */
     void DoListUsers();
 
     Library* library;
     AuthManager* authManager;
+    Executor* executor;
+    Task<void> pendingSave;
+    string sessionToken;
+    string currentUser;
+    UserAccount::PermissionMask permissions = 0;
+    ConsoleBuffer console;
 };
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include "UserDirectory.h"
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <filesystem>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    const string JOURNAL_SUFFIX = ".journal";
+    const string COMPACT_SUFFIX = ".tmp";
+    const char ENTRY_ADD = '+';
+    const char ENTRY_REMOVE = '-';
+
+    const uint32_t EMPTY_SLOT = UINT32_MAX;
+    const size_t MIN_SLOTS = 16;
+
+    // Журнал ущільнюється, коли в ньому більше записів, ніж користувачів
+    // (але не частіше, ніж раз на стільки змін).
+    const size_t MIN_COMPACTION_ENTRIES = 256;
+}
+
+UserDirectory::UserDirectory(const string& usersFilePath)
+    : snapshotPath(usersFilePath),
+    journalPath(usersFilePath + JOURNAL_SUFFIX),
+    slots(MIN_SLOTS, EMPTY_SLOT),
+    journalEntries(0)
+{
+}
+
+bool UserDirectory::Load()
+{
+    this->accounts.clear();
+    this->slots.assign(MIN_SLOTS, EMPTY_SLOT);
+    this->journalEntries = 0;
+
+    ifstream snapshot(this->snapshotPath, ios::binary);
+    bool exists = snapshot.is_open();
+
+    string line;
+    size_t lineNumber = 0;
+    while (exists && getline(snapshot, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        UserAccount account("", "", UserAccount::Role::Reader);
+        if (!UserAccount::FromFileString(line, account))
+        {
+            cerr << "Попередження: Пропущено пошкоджені дані у рядку " << lineNumber << "\n";
+            continue;
+        }
+
+        size_t slot = this->findSlot(account.GetUsername());
+        if (this->slots[slot] != EMPTY_SLOT)
+        {
+            this->accounts[this->slots[slot]] = account;
+            continue;
+        }
+        this->insertRecord(account);
+    }
+
+    ifstream journal(this->journalPath, ios::binary);
+    lineNumber = 0;
+    while (journal.is_open() && getline(journal, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        if (!this->replay(line))
+        {
+            cerr << "Попередження: Пропущено пошкоджений запис журналу у рядку " << lineNumber << "\n";
+            continue;
+        }
+        this->journalEntries++;
+    }
+    return exists;
+}
+
+const UserAccount* UserDirectory::Find(const string& username) const
+{
+    uint32_t index = this->slots[this->findSlot(username)];
+    return index == EMPTY_SLOT ? nullptr : &this->accounts[index];
+}
+
+bool UserDirectory::Add(const UserAccount& account)
+{
+    if (this->slots[this->findSlot(account.GetUsername())] != EMPTY_SLOT)
+    {
+        return false;
+    }
+
+    // Спершу журнал: якщо запис не вдався, у пам'яті нічого не змінюється.
+    this->appendToJournal(ENTRY_ADD + account.ToFileString());
+    this->insertRecord(account);
+    this->compactIfNeeded();
+    return true;
+}
+
+bool UserDirectory::Replace(const UserAccount& account)
+{
+    uint32_t index = this->slots[this->findSlot(account.GetUsername())];
+    if (index == EMPTY_SLOT)
+    {
+        return false;
+    }
+
+    // Повторний запис "+" з тим самим логіном при відтворенні журналу замінює попередній.
+    this->appendToJournal(ENTRY_ADD + account.ToFileString());
+    this->accounts[index] = account;
+    this->compactIfNeeded();
+    return true;
+}
+
+bool UserDirectory::Remove(const string& username)
+{
+    size_t slot = this->findSlot(username);
+    if (this->slots[slot] == EMPTY_SLOT)
+    {
+        return false;
+    }
+
+    this->appendToJournal(ENTRY_REMOVE + username);
+    this->removeRecord(slot);
+    this->compactIfNeeded();
+    return true;
+}
+
+size_t UserDirectory::GetCount() const
+{
+    return this->accounts.size();
+}
+
+const vector<UserAccount>& UserDirectory::GetAccounts() const
+{
+    return this->accounts;
+}
+
+void UserDirectory::Compact()
+{
+    // Новий знімок пишеться поруч і лише потім підміняє старий, тож збій
+    // посередині лишає попередній знімок і журнал неушкодженими.
+    string temporaryPath = this->snapshotPath + COMPACT_SUFFIX;
+    {
+        ofstream file(temporaryPath, ios::binary | ios::trunc);
+        if (!file.is_open())
+        {
+            throw runtime_error("Не вдалося відкрити файл користувачів для запису: " + temporaryPath);
+        }
+
+        string content;
+        for (const UserAccount& account : this->accounts)
+        {
+            content += account.ToFileString();
+            content += '\n';
+        }
+        file.write(content.data(), content.size());
+        if (!file)
+        {
+            throw runtime_error("Не вдалося записати файл користувачів: " + temporaryPath);
+        }
+    }
+    filesystem::rename(temporaryPath, this->snapshotPath);
+
+    // Журнал, що пережив збій між цими кроками, застосовується повторно без шкоди.
+    ofstream journal(this->journalPath, ios::binary | ios::trunc);
+    this->journalEntries = 0;
+}
+
+size_t UserDirectory::findSlot(string_view username) const
+{
+    size_t mask = this->slots.size() - 1;
+    size_t slot = this->homeSlot(username);
+    while (this->slots[slot] != EMPTY_SLOT &&
+        this->accounts[this->slots[slot]].GetUsername() != username)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+size_t UserDirectory::homeSlot(string_view username) const
+{
+    return hash<string_view>()(username) & (this->slots.size() - 1);
+}
+
+void UserDirectory::insertRecord(const UserAccount& account)
+{
+    this->growIfNeeded();
+    this->slots[this->findSlot(account.GetUsername())] = static_cast<uint32_t>(this->accounts.size());
+    this->accounts.push_back(account);
+}
+
+void UserDirectory::removeRecord(size_t slot)
+{
+    uint32_t index = this->slots[slot];
+    this->eraseSlot(slot);
+
+    // Останній запис переїжджає на місце видаленого, щоб масив лишався суцільним.
+    uint32_t last = static_cast<uint32_t>(this->accounts.size() - 1);
+    if (index != last)
+    {
+        this->slots[this->findSlot(this->accounts[last].GetUsername())] = index;
+        this->accounts[index] = std::move(this->accounts[last]);
+    }
+    this->accounts.pop_back();
+}
+
+void UserDirectory::eraseSlot(size_t slot)
+{
+    size_t mask = this->slots.size() - 1;
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+
+    while (this->slots[next] != EMPTY_SLOT)
+    {
+        size_t home = this->homeSlot(this->accounts[this->slots[next]].GetUsername());
+
+        // Запис можна перенести в "дірку", якщо його домашній слот не лежить
+        // циклічно між діркою (не включно) і його поточним місцем.
+        bool homeBetween = hole <= next
+            ? (home > hole && home <= next)
+            : (home > hole || home <= next);
+        if (!homeBetween)
+        {
+            this->slots[hole] = this->slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    this->slots[hole] = EMPTY_SLOT;
+}
+
+void UserDirectory::growIfNeeded()
+{
+    if ((this->accounts.size() + 1) * 2 <= this->slots.size())
+    {
+        return;
+    }
+
+    this->slots.assign(this->slots.size() * 2, EMPTY_SLOT);
+    for (size_t i = 0; i < this->accounts.size(); i++)
+    {
+        this->slots[this->findSlot(this->accounts[i].GetUsername())] = static_cast<uint32_t>(i);
+    }
+}
+
+bool UserDirectory::replay(string_view entry)
+{
+    if (entry.size() < 2) return false;
+
+    if (entry[0] == ENTRY_REMOVE)
+    {
+        size_t slot = this->findSlot(entry.substr(1));
+        if (this->slots[slot] != EMPTY_SLOT) this->removeRecord(slot);
+        return true;
+    }
+
+    UserAccount account("", "", UserAccount::Role::Reader);
+    if (entry[0] != ENTRY_ADD || !UserAccount::FromFileString(entry.substr(1), account))
+    {
+        return false;
+    }
+
+    size_t slot = this->findSlot(account.GetUsername());
+    if (this->slots[slot] != EMPTY_SLOT)
+        this->accounts[this->slots[slot]] = account;
+    else
+        this->insertRecord(account);
+    return true;
+}
+
+void UserDirectory::appendToJournal(const string& entry)
+{
+    {
+        ofstream journal(this->journalPath, ios::binary | ios::app);
+        journal << entry << '\n';
+        journal.flush();
+        if (!journal)
+        {
+            throw runtime_error("Не вдалося записати журнал користувачів: " + this->journalPath);
+        }
+    }
+    this->journalEntries++;
+}
+
+void UserDirectory::compactIfNeeded()
+{
+    if (this->journalEntries < max(MIN_COMPACTION_ENTRIES, this->accounts.size()))
+    {
+        return;
+    }
+
+    // Зміна вже збережена в журналі, тож невдале ущільнення не є помилкою:
+    // журнал просто залишиться довшим до наступної спроби.
+    try
+    {
+        this->Compact();
+    }
+    catch (const exception& e)
+    {
+        cerr << "Попередження: Не вдалося ущільнити журнал користувачів. " << e.what() << "\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+#include "../Entities/UserAccount.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+ /**
+  * @class UserDirectory
+  * @brief Довідник облікових записів із хеш-пошуком та журналом змін.
+  *
+  * Записи лежать підряд у масиві, а хеш-таблиця з відкритою адресацією
+  * зберігає лише їх номери, тож пошук за логіном - O(1) без окремого
+  * об'єкта в купі на кожного користувача.
+  *
+  * На диску - знімок (файл користувачів) і журнал поруч із ним. Кожна
+  * зміна дописує один рядок у журнал (O(1) вводу-виводу); коли журнал
+  * стає довшим за знімок, Compact() переписує знімок і очищує журнал.
+  *
+  * Сам нічого не блокує: викликач (AuthManager) тримає своє блокування.
+  */
+class UserDirectory
+{
+private:
+    string snapshotPath;
+    string journalPath;
+    vector<UserAccount> accounts;
+    vector<uint32_t> slots;
+    size_t journalEntries;
+
+public:
+    /**
+     * @brief Конструктор. Дані читаються лише в Load().
+     * @param usersFilePath Шлях до файлу користувачів (знімка).
+     */
+    explicit UserDirectory(const string& usersFilePath);
+
+    /**
+     * @brief Читає знімок і застосовує до нього журнал.
+     * @return false, якщо файлу знімка немає (новий довідник).
+     */
+    bool Load();
+
+    /**
+     * @brief Знаходить користувача за логіном.
+     * @return Вказівник, дійсний до наступної зміни довідника, або nullptr.
+     */
+    const UserAccount* Find(const string& username) const;
+
+    /**
+     * @brief Додає користувача та записує зміну в журнал.
+     * @return false, якщо логін вже зайнятий.
+     * @throws runtime_error, якщо журнал не вдалося записати (довідник не змінюється).
+     */
+    bool Add(const UserAccount& account);
+
+    /**
+     * @brief Замінює запис користувача з тим самим логіном (напр., новий хеш пароля).
+     * @return false, якщо користувача не знайдено.
+     * @throws runtime_error, якщо журнал не вдалося записати (довідник не змінюється).
+     */
+    bool Replace(const UserAccount& account);
+
+    /**
+     * @brief Видаляє користувача та записує зміну в журнал.
+     * @return false, якщо користувача не знайдено.
+     * @throws runtime_error, якщо журнал не вдалося записати (довідник не змінюється).
+     */
+    bool Remove(const string& username);
+
+    size_t GetCount() const;
+
+    /**
+     * @brief Усі записи (у довільному порядку).
+     */
+    const vector<UserAccount>& GetAccounts() const;
+
+    /**
+     * @brief Переписує знімок поточним станом і очищує журнал.
+     * @throws runtime_error, якщо файл не вдалося записати.
+     */
+    void Compact();
+
+private:
+    /**
+     * @brief Слот таблиці з цим логіном або порожній слот, куди його вставити.
+     */
+    size_t findSlot(string_view username) const;
+
+    size_t homeSlot(string_view username) const;
+
+    void insertRecord(const UserAccount& account);
+    void removeRecord(size_t slot);
+
+    /**
+     * @brief Звільняє слот, зсуваючи назад записи з того ж ланцюжка проб.
+     */
+    void eraseSlot(size_t slot);
+
+    /**
+     * @brief Подвоює таблицю, коли вона заповнена більш ніж наполовину.
+     */
+    void growIfNeeded();
+
+    /**
+     * @brief Застосовує рядок журналу ("+Тип:логін:хеш" або "-логін").
+     * Повторне застосування не змінює результату.
+     * @return false, якщо рядок пошкоджений.
+     */
+    bool replay(string_view entry);
+
+    /**
+     * @brief Дописує рядок у журнал.
+     * @throws runtime_error, якщо запис не вдався.
+     */
+    void appendToJournal(const string& entry);
+
+    /**
+     * @brief Ущільнює журнал, коли в ньому більше записів, ніж користувачів.
+     */
+    void compactIfNeeded();
+};
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "TestCheck.h"
+#include "../Core/BPlusTree.h"
+#include <set>
+#include <vector>
+#include <random>
+#include <string>
+
+using namespace std;
+
+namespace
+{
+    // Вузли по 4 ключі: дерево з кількох тисяч ключів має кілька рівнів,
+    // і вставки/видалення постійно ділять, позичають і зливають вузли.
+    typedef BPlusTree<int, less<int>, 4> SmallTree;
+
+    const int KEY_RANGE = 2000;
+    const size_t OPERATIONS = 20000;
+    const size_t CHECK_INTERVAL = 250;
+
+    /**
+     * @brief Порівнює дерево з еталонною множиною: розмір, порядок обходу,
+     * At() для кожного номера, LowerBound() і Contains() для кожного ключа діапазону.
+     */
+    bool matches(TestCheck& check, const SmallTree& tree, const set<int>& expected, const string& context)
+    {
+        if (!check.Expect(tree.Size() == expected.size(), context + ": Size()")) return false;
+
+        size_t index = 0;
+        SmallTree::ConstIterator it = tree.begin();
+        for (int key : expected)
+        {
+            if (!check.Expect(it != tree.end() && *it == key, context + ": обхід, номер " + to_string(index))) return false;
+            SmallTree::ConstIterator byRank = tree.At(index);
+            if (!check.Expect(byRank != tree.end() && *byRank == key, context + ": At(" + to_string(index) + ")")) return false;
+            ++it;
+            index++;
+        }
+        if (!check.Expect(it == tree.end(), context + ": зайві ключі після обходу")) return false;
+        if (!check.Expect(tree.At(expected.size()) == tree.end(), context + ": At(Size())")) return false;
+
+        for (int key = -1; key <= KEY_RANGE; key++)
+        {
+            auto lower = expected.lower_bound(key);
+            SmallTree::ConstIterator found = tree.LowerBound(key);
+            bool same = (lower == expected.end()) ? found == tree.end() : (found != tree.end() && *found == *lower);
+            if (!check.Expect(same, context + ": LowerBound(" + to_string(key) + ")")) return false;
+            if (!check.Expect(tree.Contains(key) == (expected.count(key) > 0), context + ": Contains(" + to_string(key) + ")")) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Випадкові вставки й видалення, звірені з std::set.
+     * Спершу переважають вставки, потім - видалення, тож дерево і росте, і спорожніє.
+     */
+    void checkRandomOperations(TestCheck& check, SmallTree& tree, set<int>& expected, mt19937& random, const string& context)
+    {
+        for (size_t i = 0; i < OPERATIONS; i++)
+        {
+            int key = static_cast<int>(random() % KEY_RANGE);
+            bool insert = random() % 100 < (i < OPERATIONS / 2 ? 70u : 30u);
+            if (insert)
+            {
+                bool inserted = expected.insert(key).second;
+                if (!check.Expect(tree.Insert(key) == inserted, context + ": Insert(" + to_string(key) + ")")) return;
+            }
+            else
+            {
+                bool erased = expected.erase(key) > 0;
+                if (!check.Expect(tree.Erase(key) == erased, context + ": Erase(" + to_string(key) + ")")) return;
+            }
+
+            if (i % CHECK_INTERVAL == 0 && !matches(check, tree, expected, context)) return;
+        }
+        matches(check, tree, expected, context);
+    }
+
+    void checkInsertErase(TestCheck& check)
+    {
+        mt19937 random(20240601);
+        SmallTree tree;
+        set<int> expected;
+        checkRandomOperations(check, tree, expected, random, "вставки/видалення");
+
+        // Повне спорожнення: корінь має стиснутися до порожнього листка.
+        for (int key : vector<int>(expected.begin(), expected.end()))
+        {
+            tree.Erase(key);
+        }
+        expected.clear();
+        matches(check, tree, expected, "спорожнене дерево");
+        check.Expect(tree.IsEmpty(), "спорожнене дерево: IsEmpty()");
+    }
+
+    void checkAssign(TestCheck& check)
+    {
+        mt19937 random(7);
+        for (size_t size : { 0, 1, 4, 5, 21, 100, 1000, 1999 })
+        {
+            set<int> expected;
+            while (expected.size() < size)
+            {
+                expected.insert(static_cast<int>(random() % KEY_RANGE));
+            }
+
+            SmallTree tree;
+            tree.Assign(vector<int>(expected.begin(), expected.end()));
+            string context = "Assign(" + to_string(size) + ")";
+            if (!matches(check, tree, expected, context)) continue;
+
+            // Вузли, збудовані Assign, мають так само ділитися й зливатися.
+            checkRandomOperations(check, tree, expected, random, context + " і зміни");
+        }
+    }
+
+    void checkScanRange(TestCheck& check)
+    {
+        SmallTree tree;
+        for (int key = 0; key < 100; key += 2) tree.Insert(key);
+
+        vector<int> visited;
+        tree.ScanRange(9, 21, [&](const int& key) { visited.push_back(key); });
+        check.Expect(visited == vector<int>({ 10, 12, 14, 16, 18, 20 }), "ScanRange(9, 21)");
+
+        visited.clear();
+        tree.ScanRange(200, 300, [&](const int& key) { visited.push_back(key); });
+        check.Expect(visited.empty(), "ScanRange за межами ключів");
+    }
+}
+
+/**
+ * Перевіряє BPlusTree на випадкових вставках і видаленнях проти std::set.
+ */
+int main()
+{
+    TestCheck check("BPlusTree");
+    checkInsertErase(check);
+    checkAssign(check);
+    checkScanRange(check);
+    return check.Report();
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "TestCheck.h"
+#include "../Managers/Library.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    const string DATA_FILE = "library_filter_tests.csv";
+    const string INDEX_FILE = DATA_FILE + ".idx";
+
+    const char* const ROWS[] = {
+        "A1,Author,Alpha,10.00,1,",
+        "B1,Author,Beta,10.00,1,",
+        "B2,Author,Betamax,10.00,1,",
+        "C1,Author,Gamma,10.00,1,",
+        "D1,Author,Delta,10.00,1,",
+        "Z1,Author,Zeta,10.00,1,",
+    };
+
+    void removeDataFile()
+    {
+        remove(DATA_FILE.c_str());
+        remove(INDEX_FILE.c_str());
+    }
+
+    void writeDataFile()
+    {
+        removeDataFile();
+        ofstream file(DATA_FILE, ios::trunc);
+        for (const char* row : ROWS) file << row << "\n";
+    }
+
+    vector<string> titles(const vector<Book>& books)
+    {
+        vector<string> result;
+        for (const Book& book : books) result.push_back(book.GetBookTitle());
+        return result;
+    }
+
+    void checkTitleRange(TestCheck& check, const Library& library)
+    {
+        struct Case
+        {
+            string fromTitle;
+            string toTitle;
+            vector<string> expected;
+        };
+        const Case cases[] = {
+            { "Alpha", "Delta", { "Alpha", "Beta", "Betamax", "Delta" } },
+            // Верхня межа включає назви, що з неї починаються.
+            { "B", "Beta", { "Beta", "Betamax" } },
+            { "", "Beta", { "Alpha", "Beta", "Betamax" } },
+            { "Gamma", "Zeta", { "Gamma", "Zeta" } },
+            { "Zeta", "Alpha", {} },
+            // Порожня верхня межа - префікс усього, тож діапазон порожній,
+            // а не "від fromTitle до кінця".
+            { "Beta", "", {} },
+            { "", "", {} },
+        };
+
+        for (const Case& testCase : cases)
+        {
+            check.Expect(titles(library.FilterByTitleRange(testCase.fromTitle, testCase.toTitle)) == testCase.expected,
+                "FilterByTitleRange(\"" + testCase.fromTitle + "\", \"" + testCase.toTitle + "\")");
+        }
+    }
+}
+
+/**
+ * Перевіряє фільтри Library за індексами, зокрема межі діапазону назв.
+ */
+int main()
+{
+    TestCheck check("LibraryFilter");
+    writeDataFile();
+    {
+        Library library(DATA_FILE);
+        checkTitleRange(check, library);
+    }
+    removeDataFile();
+    return check.Report();
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "TestCheck.h"
+#include "../Managers/Library.h"
+#include "../Managers/LibraryTransaction.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+    const string DATA_FILE = "library_transaction_tests.csv";
+    const string INDEX_FILE = DATA_FILE + ".idx";
+
+    const char* const INITIAL_ROWS[] = {
+        "A1,Author A,Title A,10.00,1,",
+        "B2,Author B,Title B,20.00,2,Reader B",
+        "C3,Author C,Title C,30.00,3,",
+        "D4,Author A,Title D,40.00,1,",
+    };
+
+    void removeDataFile()
+    {
+        remove(DATA_FILE.c_str());
+        remove(INDEX_FILE.c_str());
+    }
+
+    void writeDataFile()
+    {
+        removeDataFile();
+        ofstream file(DATA_FILE, ios::trunc);
+        for (const char* row : INITIAL_ROWS) file << row << "\n";
+    }
+
+    bool dataFileExists()
+    {
+        return ifstream(DATA_FILE).good();
+    }
+
+    /**
+     * @brief Каталог як рядки CSV у порядку зберігання.
+     */
+    vector<string> dump(const Library& library)
+    {
+        vector<string> rows;
+        for (const Book& book : library.GetAllBooks()) rows.push_back(book.ToCsvString());
+        return rows;
+    }
+
+    /**
+     * @brief Каталог і всі його індекси збігаються з початковим файлом.
+     */
+    void expectInitial(TestCheck& check, const Library& library, const string& context)
+    {
+        check.Expect(dump(library) == vector<string>(begin(INITIAL_ROWS), end(INITIAL_ROWS)),
+            context + ": порядок і вміст книг");
+
+        for (const char* row : INITIAL_ROWS)
+        {
+            string article = Book::FromCsvString(row).GetId();
+            const Book* book = library.FindBookByArticle(article);
+            check.Expect(book != nullptr && book->ToCsvString() == row, context + ": пошук " + article);
+        }
+        check.Expect(library.FindBookByArticle("E5") == nullptr, context + ": доданої книги немає");
+        check.Expect(library.FindBookByArticle("Z9") == nullptr, context + ": зміненого артикула немає");
+        check.Expect(library.FilterByAuthor("Author A").size() == 2, context + ": індекс авторів");
+        check.Expect(library.GetIssuedBooks().size() == 1, context + ": виданих книг");
+    }
+
+    void checkCommit(TestCheck& check)
+    {
+        writeDataFile();
+        {
+            Library library(DATA_FILE);
+            LibraryTransaction transaction(library);
+            transaction.StageAdd(Book::FromCsvString("E5,Author E,Title E,50.00,5,"));
+            transaction.StageUpdate("C3", Book::FromCsvString("Z9,Author C,Title Z,35.00,3,"));
+            transaction.StageIssue("Z9", "Reader Z");
+            transaction.StageDelete("A1");
+            transaction.StageReturn("B2");
+
+            LibraryTransaction::CommitResult result = transaction.Commit();
+            check.Expect(result.Succeeded(), "фіксація: Commit()");
+            check.Expect(transaction.GetOperationCount() == 0, "фіксація: операції очищено");
+
+            const Book* renamed = library.FindBookByArticle("Z9");
+            check.Expect(renamed != nullptr && renamed->GetReaderFullName() == "Reader Z",
+                "фіксація: зміна артикула і видача в одній транзакції");
+            check.Expect(library.FindBookByArticle("C3") == nullptr, "фіксація: старого артикула немає");
+            check.Expect(library.FindBookByArticle("A1") == nullptr, "фіксація: видалення");
+            check.Expect(library.FindBookByArticle("E5") != nullptr, "фіксація: додавання");
+            check.Expect(library.FindBookByArticle("B2")->IsAvailable(), "фіксація: повернення");
+        }
+
+        // Зафіксовані зміни записуються у файл при виході.
+        Library reloaded(DATA_FILE);
+        check.Expect(reloaded.FindBookByArticle("Z9") != nullptr && reloaded.GetBookCount() == 4,
+            "фіксація: зміни збережено у файл");
+    }
+
+    /**
+     * @brief Кожна операція може не вдатися після вже застосованих
+     * інших видів: відкат має повернути каталог до початкового стану.
+     */
+    void checkRollback(TestCheck& check)
+    {
+        writeDataFile();
+        Library library(DATA_FILE);
+
+        struct Case
+        {
+            string name;
+            size_t failedOperation;
+            LibraryTransaction::Status status;
+            void (*stageFailure)(LibraryTransaction&);
+        };
+        const Case cases[] = {
+            { "додавання наявного артикула", 5, LibraryTransaction::Status::AlreadyExists,
+              [](LibraryTransaction& t) { t.StageAdd(Book::FromCsvString("D4,X,X,1.00,1,")); } },
+            { "зміна на наявний артикул", 5, LibraryTransaction::Status::AlreadyExists,
+              [](LibraryTransaction& t) { t.StageUpdate("D4", Book::FromCsvString("Z9,X,X,1.00,1,")); } },
+            { "видалення відсутньої книги", 5, LibraryTransaction::Status::NotFound,
+              [](LibraryTransaction& t) { t.StageDelete("A1"); } },
+            { "видача виданої книги", 5, LibraryTransaction::Status::BookBusy,
+              [](LibraryTransaction& t) { t.StageIssue("Z9", "Reader Y"); } },
+            { "повернення наявної книги", 5, LibraryTransaction::Status::BookAvailable,
+              [](LibraryTransaction& t) { t.StageReturn("B2"); } },
+        };
+
+        for (const Case& testCase : cases)
+        {
+            LibraryTransaction transaction(library);
+            transaction.StageAdd(Book::FromCsvString("E5,Author E,Title E,50.00,5,"));
+            transaction.StageUpdate("C3", Book::FromCsvString("Z9,Author C,Title Z,35.00,3,"));
+            transaction.StageIssue("Z9", "Reader Z");
+            transaction.StageDelete("A1");
+            transaction.StageReturn("B2");
+            testCase.stageFailure(transaction);
+
+            LibraryTransaction::CommitResult result = transaction.Commit();
+            check.Expect(result.status == testCase.status && result.failedOperation == testCase.failedOperation,
+                testCase.name + ": статус і номер операції");
+            expectInitial(check, library, testCase.name);
+        }
+
+        // Файл видаляється після завантаження: якщо відкат вважався б
+        // зміною, деструктор записав би каталог знову.
+        removeDataFile();
+    }
+}
+
+/**
+ * Перевіряє LibraryTransaction: спільну фіксацію різних операцій і повний
+ * відкат, що не залишає змін ні в каталозі, ні у файлі.
+ */
+int main()
+{
+    TestCheck check("LibraryTransaction");
+    checkCommit(check);
+    checkRollback(check);
+    check.Expect(!dataFileExists(), "відкат: файл не перезаписано");
+    removeDataFile();
+    return check.Report();
+}
\ No newline at end of file
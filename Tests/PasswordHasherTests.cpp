@@ -0,0 +1,121 @@
+#include "TestCheck.h"
+#include "../Core/PasswordHasher.h"
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+namespace
+{
+    const char HEX_DIGITS[] = "0123456789abcdef";
+
+    string toHex(const string& bytes)
+    {
+        string hex;
+        for (unsigned char byte : bytes)
+        {
+            hex += HEX_DIGITS[byte >> 4];
+            hex += HEX_DIGITS[byte & 0x0f];
+        }
+        return hex;
+    }
+
+    /**
+     * @brief Контрольний приклад PBKDF2-HMAC-SHA256.
+     */
+    struct Vector
+    {
+        string name;
+        string password;
+        string salt;
+        uint32_t iterations;
+        size_t length;
+        string expected;
+    };
+
+    void checkVectors(TestCheck& check)
+    {
+        const Vector vectors[] = {
+            // RFC 7914, розділ 11: вихід 64 байти - два блоки PBKDF2.
+            { "RFC 7914 #1", "passwd", "salt", 1, 64,
+              "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+              "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783" },
+            { "RFC 7914 #2", "Password", "NaCl", 80000, 64,
+              "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+              "a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d" },
+
+            // Входи RFC 6070 (там - для SHA-1) з виходами для SHA-256.
+            { "RFC 6070 c=1", "password", "salt", 1, 32,
+              "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b" },
+            { "RFC 6070 c=2", "password", "salt", 2, 32,
+              "ae4d0c95af6b46d32d0adff928f06dd02a303f8ef3c251dfd6e2d85a95474c43" },
+            { "RFC 6070 c=4096", "password", "salt", 4096, 32,
+              "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a" },
+            { "RFC 6070 довгі входи", "passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 40,
+              "348c89dbcbd32b2f32d814b8116e84cf2b17347ebc1800181c4e2a1fb8dd53e1c635518c7dac47e9" },
+            { "RFC 6070 нульові байти", string("pass\0word", 9), string("sa\0lt", 5), 4096, 16,
+              "89b69d0516f829893c696226650a8687" },
+
+            // Пароль, довший за блок HMAC, спершу хешується.
+            { "пароль довший за блок", string(100, 'p'), "salt", 2, 32,
+              "7fb39a0c2291de62231e50ab5f6805b83bab97446d73dccf38114fb21c055427" },
+        };
+
+        for (const Vector& example : vectors)
+        {
+            string key = PasswordHasher::DeriveKey(example.password, example.salt, example.iterations, example.length);
+            check.Expect(toHex(key) == example.expected, example.name);
+        }
+    }
+
+    void checkStoredFormat(TestCheck& check)
+    {
+        // Рядок у форматі файлу користувачів, обчислений незалежно від застосунку.
+        const string stored = "pbkdf2-sha256$1000$000102030405060708090a0b0c0d0e0f$"
+            "b732b63f5948b09bfc28a586e89b6f93d3344770f99a6b32468a7afab5218d39";
+        check.Expect(PasswordHasher::IsHash(stored), "IsHash() для збереженого хешу");
+        check.Expect(PasswordHasher::Verify("admin123", stored), "Verify() для правильного пароля");
+        check.Expect(!PasswordHasher::Verify("admin124", stored), "Verify() для хибного пароля");
+
+        string hash = PasswordHasher::Hash("secret", 10);
+        check.Expect(hash.rfind("pbkdf2-sha256$10$", 0) == 0, "Hash(): префікс і кількість ітерацій");
+        check.Expect(PasswordHasher::Verify("secret", hash), "Hash() -> Verify()");
+        check.Expect(!PasswordHasher::Verify("Secret", hash), "Hash() -> Verify() з іншим паролем");
+        check.Expect(hash != PasswordHasher::Hash("secret", 10), "Hash(): нова сіль щоразу");
+    }
+
+    void checkMalformedAndLegacy(TestCheck& check)
+    {
+        // Старі файли користувачів зберігали паролі у відкритому вигляді.
+        check.Expect(!PasswordHasher::IsHash("admin123"), "IsHash() для відкритого пароля");
+        check.Expect(PasswordHasher::Verify("admin123", "admin123"), "Verify() для відкритого пароля");
+        check.Expect(!PasswordHasher::Verify("admin12", "admin123"), "Verify() для хибного відкритого пароля");
+
+        // Пошкоджений хеш не приймає жодного пароля, навіть самого себе.
+        const string malformed[] = {
+            "pbkdf2-sha256$",
+            "pbkdf2-sha256$0$000102030405060708090a0b0c0d0e0f$"
+                "b732b63f5948b09bfc28a586e89b6f93d3344770f99a6b32468a7afab5218d39",
+            "pbkdf2-sha256$1000$0001$b732",
+            "pbkdf2-sha256$x$000102030405060708090a0b0c0d0e0f$"
+                "b732b63f5948b09bfc28a586e89b6f93d3344770f99a6b32468a7afab5218d39",
+        };
+        for (const string& stored : malformed)
+        {
+            check.Expect(!PasswordHasher::Verify(stored, stored), "пошкоджений хеш: " + stored);
+            check.Expect(!PasswordHasher::Verify("admin123", stored), "пошкоджений хеш з паролем: " + stored);
+        }
+    }
+}
+
+/**
+ * Перевіряє PBKDF2-HMAC-SHA256 за контрольними прикладами RFC 7914 і RFC 6070.
+ */
+int main()
+{
+    TestCheck check("PasswordHasher");
+    checkVectors(check);
+    checkStoredFormat(check);
+    checkMalformedAndLegacy(check);
+    return check.Report();
+}
\ No newline at end of file
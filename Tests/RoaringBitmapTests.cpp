@@ -0,0 +1,202 @@
+#include "TestCheck.h"
+#include "../Core/RoaringBitmap.h"
+#include <set>
+#include <vector>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+
+using namespace std;
+
+namespace
+{
+    const uint32_t CONTAINER_SPAN = 65536;
+    const uint32_t ARRAY_LIMIT = static_cast<uint32_t>(RoaringBitmap::ARRAY_LIMIT);
+
+    /**
+     * @brief Порівнює множину з еталоном: кількість, ToVector(), ForEach()
+     * і Contains() для кожного значення з [from, to).
+     */
+    bool matches(TestCheck& check, const RoaringBitmap& bitmap, const set<uint32_t>& expected,
+        uint32_t from, uint32_t to, const string& context)
+    {
+        if (!check.Expect(bitmap.Cardinality() == expected.size(), context + ": Cardinality()")) return false;
+        if (!check.Expect(bitmap.IsEmpty() == expected.empty(), context + ": IsEmpty()")) return false;
+
+        vector<uint32_t> values = bitmap.ToVector();
+        if (!check.Expect(values == vector<uint32_t>(expected.begin(), expected.end()), context + ": ToVector()")) return false;
+
+        vector<uint32_t> visited;
+        bitmap.ForEach([&](uint32_t value) { visited.push_back(value); });
+        if (!check.Expect(visited == values, context + ": ForEach()")) return false;
+
+        for (uint32_t value = from; value < to; value++)
+        {
+            if (!check.Expect(bitmap.Contains(value) == (expected.count(value) > 0),
+                context + ": Contains(" + to_string(value) + ")")) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Контейнер переходить у бітову карту на ARRAY_LIMIT + 1 значенні
+     * і повертається в масив, коли значень знову не більше ARRAY_LIMIT.
+     */
+    void checkConversionThreshold(TestCheck& check)
+    {
+        RoaringBitmap bitmap;
+        set<uint32_t> expected;
+
+        // Кожне друге значення, щоб масив і карта не збігалися з суцільним діапазоном.
+        for (uint32_t i = 0; i < ARRAY_LIMIT; i++)
+        {
+            bitmap.Add(2 * i);
+            expected.insert(2 * i);
+        }
+        matches(check, bitmap, expected, 0, 2 * ARRAY_LIMIT + 2, "масив на межі");
+
+        check.Expect(bitmap.Add(2 * ARRAY_LIMIT), "Add() понад межу");
+        expected.insert(2 * ARRAY_LIMIT);
+        matches(check, bitmap, expected, 0, 2 * ARRAY_LIMIT + 2, "бітова карта");
+        check.Expect(!bitmap.Add(2 * ARRAY_LIMIT), "повторний Add() у бітовій карті");
+
+        check.Expect(bitmap.Remove(0), "Remove() до межі");
+        expected.erase(0);
+        matches(check, bitmap, expected, 0, 2 * ARRAY_LIMIT + 2, "знову масив");
+        check.Expect(!bitmap.Remove(0), "повторний Remove()");
+
+        // Коливання навколо межі: кожен крок перетворює контейнер.
+        for (int round = 0; round < 5; round++)
+        {
+            bitmap.Add(1);
+            bitmap.Remove(1);
+        }
+        matches(check, bitmap, expected, 0, 2 * ARRAY_LIMIT + 2, "коливання навколо межі");
+
+        for (uint32_t value : vector<uint32_t>(expected.begin(), expected.end()))
+        {
+            bitmap.Remove(value);
+        }
+        expected.clear();
+        matches(check, bitmap, expected, 0, 2 * ARRAY_LIMIT + 2, "спорожнена множина");
+    }
+
+    /**
+     * @brief Випадкові Add/Remove у трьох контейнерах з різною щільністю:
+     * розрідженому, щільному і такому, що перетинає межу туди й назад.
+     */
+    void checkRandomOperations(TestCheck& check)
+    {
+        mt19937 random(20240601);
+        RoaringBitmap bitmap;
+        set<uint32_t> expected;
+
+        const uint32_t spans[] = { 2000, 20000, 2 * ARRAY_LIMIT + 200 };
+        for (int phase = 0; phase < 4; phase++)
+        {
+            bool growing = phase % 2 == 0;
+            for (int i = 0; i < 30000; i++)
+            {
+                uint32_t container = random() % 3;
+                uint32_t value = container * CONTAINER_SPAN + random() % spans[container];
+                if (random() % 100 < (growing ? 80u : 20u))
+                {
+                    bool added = expected.insert(value).second;
+                    if (!check.Expect(bitmap.Add(value) == added, "Add(" + to_string(value) + ")")) return;
+                }
+                else
+                {
+                    bool removed = expected.erase(value) > 0;
+                    if (!check.Expect(bitmap.Remove(value) == removed, "Remove(" + to_string(value) + ")")) return;
+                }
+            }
+            if (!matches(check, bitmap, expected, 0, 3 * CONTAINER_SPAN, "випадкові зміни, фаза " + to_string(phase))) return;
+        }
+    }
+
+    RoaringBitmap makeBitmap(const set<uint32_t>& values)
+    {
+        RoaringBitmap bitmap;
+        for (uint32_t value : values) bitmap.Add(value);
+        return bitmap;
+    }
+
+    /**
+     * @brief Перетин для всіх пар видів контейнерів, зокрема двох карт,
+     * чий перетин уже вміщується в масив.
+     */
+    void checkIntersection(TestCheck& check)
+    {
+        mt19937 random(42);
+        auto randomSet = [&](size_t count, uint32_t span)
+        {
+            set<uint32_t> values;
+            while (values.size() < count) values.insert(random() % span);
+            return values;
+        };
+
+        struct Case
+        {
+            string name;
+            size_t leftCount;
+            size_t rightCount;
+        };
+        const Case cases[] = {
+            { "масив і масив", 1000, 1500 },
+            { "масив і карта", 1000, 30000 },
+            { "карта і масив", 30000, 1000 },
+            { "карта і карта (результат - карта)", 50000, 50000 },
+            { "карта і карта (результат - масив)", 8000, 8000 },
+        };
+
+        for (const Case& testCase : cases)
+        {
+            set<uint32_t> left = randomSet(testCase.leftCount, CONTAINER_SPAN);
+            set<uint32_t> right = randomSet(testCase.rightCount, CONTAINER_SPAN);
+
+            // Другий контейнер є лише ліворуч: у перетині його не буде.
+            left.insert(CONTAINER_SPAN + 5);
+            right.insert(2 * CONTAINER_SPAN + 5);
+
+            set<uint32_t> expected;
+            set_intersection(left.begin(), left.end(), right.begin(), right.end(),
+                inserter(expected, expected.end()));
+
+            RoaringBitmap leftBitmap = makeBitmap(left);
+            RoaringBitmap rightBitmap = makeBitmap(right);
+            RoaringBitmap result = RoaringBitmap::And(leftBitmap, rightBitmap);
+            if (!matches(check, result, expected, 0, 3 * CONTAINER_SPAN, testCase.name)) continue;
+
+            leftBitmap &= rightBitmap;
+            matches(check, leftBitmap, expected, 0, 3 * CONTAINER_SPAN, testCase.name + ", &=");
+        }
+    }
+
+    void checkExtremeValues(TestCheck& check)
+    {
+        RoaringBitmap bitmap;
+        set<uint32_t> expected = { 0, 65535, 65536, 0x7FFFFFFF, 0xFFFFFFFE, 0xFFFFFFFF };
+        for (uint32_t value : expected) bitmap.Add(value);
+
+        check.Expect(bitmap.ToVector() == vector<uint32_t>(expected.begin(), expected.end()), "крайні значення: ToVector()");
+        check.Expect(bitmap.Contains(0xFFFFFFFF) && !bitmap.Contains(0xFFFFFFFD), "крайні значення: Contains()");
+
+        bitmap.Clear();
+        check.Expect(bitmap.IsEmpty() && bitmap.Cardinality() == 0, "Clear()");
+    }
+}
+
+/**
+ * Перевіряє RoaringBitmap проти std::set, зокрема перетворення масив <-> бітова карта.
+ */
+int main()
+{
+    TestCheck check("RoaringBitmap");
+    checkConversionThreshold(check);
+    checkRandomOperations(check);
+    checkIntersection(check);
+    checkExtremeValues(check);
+    return check.Report();
+}
\ No newline at end of file
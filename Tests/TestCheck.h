@@ -0,0 +1,55 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <cstddef>
+
+using namespace std;
+
+ /**
+  * @class TestCheck
+  * @brief Лічильник перевірок тестової програми.
+  *
+  * Провалена перевірка друкується одразу, а Report() повертає код
+  * завершення для ctest: 0, якщо провалених немає.
+  */
+class TestCheck
+{
+private:
+    string suite;
+    size_t passed = 0;
+    size_t failed = 0;
+
+public:
+    explicit TestCheck(const string& suite) : suite(suite) {}
+
+    /**
+     * @brief Зараховує перевірку.
+     * @param condition Результат перевірки.
+     * @param description Що перевірялося (друкується при провалі).
+     * @return condition, щоб після провалу можна було зупинити цикл.
+     */
+    bool Expect(bool condition, const string& description)
+    {
+        if (condition)
+        {
+            this->passed++;
+        }
+        else
+        {
+            this->failed++;
+            cerr << this->suite << ": ПОМИЛКА: " << description << "\n";
+        }
+        return condition;
+    }
+
+    /**
+     * @brief Друкує підсумок.
+     * @return Код завершення програми.
+     */
+    int Report() const
+    {
+        cout << this->suite << ": перевірок " << this->passed + this->failed
+             << ", провалено " << this->failed << "\n";
+        return this->failed == 0 ? 0 : 1;
+    }
+};
\ No newline at end of file